@@ -18,6 +18,8 @@
 #include <android/asset_manager_jni.h>
 #include <android/log.h>
 #include <android/sharedmem.h>
+#include <android/trace.h>
+#include <dlfcn.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -25,20 +27,89 @@
 
 namespace {
 
+// Marks the enclosing scope as a section of the system trace, which Perfetto and systrace record
+// with the "app" category.
+class ScopedTrace {
+   public:
+    explicit ScopedTrace(const char* sectionName) { ATrace_beginSection(sectionName); }
+    ~ScopedTrace() { ATrace_endSection(); }
+};
+
+// ANEURALNETWORKS_FEATURE_LEVEL_5, not defined by the NDK targeted by this sample.
+constexpr int64_t kFeatureLevel5 = 31;
+
+// Returns the feature level of the NNAPI runtime on the device.
+//
+// ANeuralNetworks_getRuntimeFeatureLevel is only available since API level 31, so it is looked up
+// at runtime. On older devices, the feature level is below kFeatureLevel5 anyway.
+int64_t getRuntimeFeatureLevel() {
+    using GetRuntimeFeatureLevelFn = int64_t (*)();
+    static const auto getRuntimeFeatureLevelFn = reinterpret_cast<GetRuntimeFeatureLevelFn>(
+            dlsym(RTLD_DEFAULT, "ANeuralNetworks_getRuntimeFeatureLevel"));
+    return getRuntimeFeatureLevelFn != nullptr ? getRuntimeFeatureLevelFn() : 0;
+}
+
+// Create ANeuralNetworksMemory by mapping the asset file in place.
+//
+// Starting from API level 31, the NNAPI drivers are able to access the asset file, so the NNAPI
+// memory can be created from the file descriptor of the APK at the offset of the asset without
+// copying the model data. This requires the asset to be stored uncompressed (see noCompress in
+// build.gradle). Returns nullptr if the asset cannot be mapped.
+//
+// The NNAPI memory must start at a page-aligned file offset, but the build only aligns
+// uncompressed assets to 4 bytes. The memory therefore starts at the page boundary before the
+// asset, and *dataOffset is set to the offset of the model data within the memory.
+ANeuralNetworksMemory* mapMemoryFromAsset(AAsset* asset, size_t* dataOffset) {
+    off_t start = 0, length = 0;
+    int fd = AAsset_openFileDescriptor(asset, &start, &length);
+    if (fd < 0) {
+        __android_log_print(ANDROID_LOG_INFO, LOG_TAG, "The model data asset is compressed");
+        return nullptr;
+    }
+    const off_t mappedStart = start - start % sysconf(_SC_PAGESIZE);
+
+    ANeuralNetworksMemory* memory = nullptr;
+    int status = ANeuralNetworksMemory_createFromFd(length + (start - mappedStart), PROT_READ, fd,
+                                                    mappedStart, &memory);
+
+    // It is safe to close the file descriptor here because ANeuralNetworksMemory_createFromFd
+    // will create a dup.
+    close(fd);
+    if (status != ANEURALNETWORKS_NO_ERROR) {
+        __android_log_print(ANDROID_LOG_INFO, LOG_TAG,
+                            "ANeuralNetworksMemory_createFromFd failed for the mapped asset");
+        return nullptr;
+    }
+    __android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Model data: %ld bytes mapped, 0 bytes copied",
+                        static_cast<long>(length));
+    *dataOffset = start - mappedStart;
+    return memory;
+}
+
 // Create ANeuralNetworksMemory from an asset file.
 //
-// Note that, at API level 30 or earlier, the NNAPI drivers may not have the permission to
-// access the asset file. To work around this issue, here we will:
+// The asset file is mapped in place if possible, see mapMemoryFromAsset. Otherwise, e.g. at API
+// level 30 or earlier where the NNAPI drivers may not have the permission to access the asset
+// file, here we will:
 // 1. Allocate a large-enough shared memory to hold the model data;
 // 2. Copy the asset file to the shared memory;
 // 3. Create the NNAPI memory with the file descriptor of the shared memory.
-ANeuralNetworksMemory* createMemoryFromAsset(AAsset* asset) {
+// *dataOffset is set to the offset of the model data within the returned memory.
+ANeuralNetworksMemory* createMemoryFromAsset(AAsset* asset, size_t* dataOffset) {
+    *dataOffset = 0;
+    if (getRuntimeFeatureLevel() >= kFeatureLevel5) {
+        ANeuralNetworksMemory* memory = mapMemoryFromAsset(asset, dataOffset);
+        if (memory != nullptr) {
+            return memory;
+        }
+    }
+
     // Allocate a large-enough shared memory to hold the model data.
     off_t length = AAsset_getLength(asset);
     int fd = ASharedMemory_create("model_data", length);
     if (fd < 0) {
-        __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "ASharedMemory_create failed with size %d",
-                            length);
+        __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "ASharedMemory_create failed with size %lld",
+                            static_cast<long long>(length));
         return nullptr;
     }
 
@@ -64,6 +135,8 @@ ANeuralNetworksMemory* createMemoryFromAsset(AAsset* asset) {
                             "ANeuralNetworksMemory_createFromFd failed for trained weights");
         return nullptr;
     }
+    __android_log_print(ANDROID_LOG_INFO, LOG_TAG, "Model data: 0 bytes mapped, %ld bytes copied",
+                        static_cast<long>(length));
     return memory;
 }
 
@@ -80,7 +153,7 @@ SimpleModel::SimpleModel(AAsset* asset)
     inputTensor1_.resize(tensorSize_);
 
     // Create ANeuralNetworksMemory from a file containing the trained data.
-    memoryModel_ = createMemoryFromAsset(asset);
+    memoryModel_ = createMemoryFromAsset(asset, &memoryModelOffset_);
 
     // Create ASharedMemory to hold the data for the second input tensor and output output tensor.
     inputTensor2Fd_ = ASharedMemory_create("input2", tensorSize_ * sizeof(float));
@@ -208,7 +281,8 @@ bool SimpleModel::CreateCompiledModel() {
     }
     // tensor0 is a constant tensor that was established during training.
     // We read these values from the corresponding ANeuralNetworksMemory object.
-    status = ANeuralNetworksModel_setOperandValueFromMemory(model_, tensor0, memoryModel_, 0,
+    status = ANeuralNetworksModel_setOperandValueFromMemory(model_, tensor0, memoryModel_,
+                                                            memoryModelOffset_,
                                                             tensorSize_ * sizeof(float));
     if (status != ANEURALNETWORKS_NO_ERROR) {
         __android_log_print(
@@ -237,7 +311,8 @@ bool SimpleModel::CreateCompiledModel() {
         return false;
     }
     status = ANeuralNetworksModel_setOperandValueFromMemory(model_, tensor2, memoryModel_,
-                                                            tensorSize_ * sizeof(float),
+                                                            memoryModelOffset_ +
+                                                                    tensorSize_ * sizeof(float),
                                                             tensorSize_ * sizeof(float));
     if (status != ANEURALNETWORKS_NO_ERROR) {
         __android_log_print(
@@ -394,6 +469,7 @@ bool SimpleModel::CreateCompiledModel() {
  * @return  computed result, or 0.0f if there is error.
  */
 bool SimpleModel::Compute(float inputValue1, float inputValue2, float* result) {
+    ScopedTrace trace("SimpleModel::Compute");
     if (!result) {
         return false;
     }
@@ -432,10 +508,7 @@ bool SimpleModel::Compute(float inputValue1, float inputValue2, float* result) {
     float* inputTensor2Ptr =
             reinterpret_cast<float*>(mmap(nullptr, tensorSize_ * sizeof(float),
                                           PROT_READ | PROT_WRITE, MAP_SHARED, inputTensor2Fd_, 0));
-    for (int i = 0; i < tensorSize_; i++) {
-        *inputTensor2Ptr = inputValue2;
-        inputTensor2Ptr++;
-    }
+    std::fill(inputTensor2Ptr, inputTensor2Ptr + tensorSize_, inputValue2);
     munmap(inputTensor2Ptr, tensorSize_ * sizeof(float));
 
     // ANeuralNetworksExecution_setInputFromMemory associates the operand with a shared memory
@@ -473,7 +546,9 @@ bool SimpleModel::Compute(float inputValue1, float inputValue2, float* result) {
 
     // Wait until the completion of the execution. This could be done on a different
     // thread. By waiting immediately, we effectively make this a synchronous call.
+    ATrace_beginSection("ANeuralNetworksEvent_wait");
     status = ANeuralNetworksEvent_wait(event);
+    ATrace_endSection();
     if (status != ANEURALNETWORKS_NO_ERROR) {
         __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, "ANeuralNetworksEvent_wait failed");
         return false;
@@ -486,7 +561,7 @@ bool SimpleModel::Compute(float inputValue1, float inputValue2, float* result) {
     const float goldenRef = (inputValue1 + 0.5f) * (inputValue2 + 0.5f);
     float* outputTensorPtr = reinterpret_cast<float*>(
             mmap(nullptr, tensorSize_ * sizeof(float), PROT_READ, MAP_SHARED, outputTensorFd_, 0));
-    for (int32_t idx = 0; idx < tensorSize_; idx++) {
+    for (uint32_t idx = 0; idx < tensorSize_; idx++) {
         float delta = outputTensorPtr[idx] - goldenRef;
         delta = (delta < 0.0f) ? (-delta) : delta;
         if (delta > FLOAT_EPISILON) {
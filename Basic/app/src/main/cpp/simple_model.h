@@ -50,6 +50,8 @@ class SimpleModel {
     ANeuralNetworksModel* model_;
     ANeuralNetworksCompilation* compilation_;
     ANeuralNetworksMemory* memoryModel_;
+    // The offset of the trained data within memoryModel_
+    size_t memoryModelOffset_;
     ANeuralNetworksMemory* memoryInput2_;
     ANeuralNetworksMemory* memoryOutput_;
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "PoseEstimationConfig.h"
+#include "Utils.h"
+
+namespace pose_estimation {
+namespace {
+
+// The weight of the newest sample in the smoothed camera frame interval and frame latency
+constexpr double kSmoothingFactor = 0.125;
+
+double smooth(double average, double sample) {
+    return average == 0.0 ? sample : average + kSmoothingFactor * (sample - average);
+}
+
+}  // namespace
+
+FrameScheduler::FrameScheduler(const PoseEstimationConfig& config)
+    : mPolicy(config.frameDropPolicy),
+      mTargetFrameIntervalNs(config.targetFps > 0.0f
+                                     ? static_cast<int64_t>(1'000'000'000.0 / config.targetFps)
+                                     : 0),
+      mDeadlineNs(static_cast<int64_t>(config.frameDeadlineMs * 1'000'000.0)) {
+    if (mPolicy == FrameDropPolicy::TARGET_FPS) {
+        CHECK(config.targetFps > 0.0f);
+    } else if (mPolicy == FrameDropPolicy::DEADLINE) {
+        CHECK(config.frameDeadlineMs > 0.0f);
+    }
+}
+
+bool FrameScheduler::shouldSubmit(int64_t timestampNs, int64_t nowNs) {
+    if (mHasPreviousFrame && timestampNs > mPreviousTimestampNs) {
+        mCameraFrameIntervalNs = smooth(mCameraFrameIntervalNs, timestampNs - mPreviousTimestampNs);
+    }
+    mHasPreviousFrame = true;
+    mPreviousTimestampNs = timestampNs;
+
+    switch (mPolicy) {
+        case FrameDropPolicy::LATEST_FRAME_WINS:
+            return true;
+        case FrameDropPolicy::TARGET_FPS:
+            return shouldSubmitForTargetFps(timestampNs);
+        case FrameDropPolicy::DEADLINE:
+            return shouldSubmitForDeadline(timestampNs, nowNs);
+    }
+    LOG_FATAL("Unknown frame drop policy %d", static_cast<int>(mPolicy));
+}
+
+bool FrameScheduler::shouldSubmitForTargetFps(int64_t timestampNs) {
+    // Submit the first frame at or past the due time, or the one just before it if it is closer
+    const int64_t toleranceNs = static_cast<int64_t>(mCameraFrameIntervalNs / 2);
+    if (timestampNs < mNextFrameDueNs - toleranceNs) return false;
+
+    // Keep a steady rate, unless the camera has fallen more than a frame interval behind, e.g.
+    // after a pause, in which case the next frames catch up from now rather than in a burst
+    mNextFrameDueNs = mNextFrameDueNs == INT64_MIN ? timestampNs : mNextFrameDueNs;
+    mNextFrameDueNs += mTargetFrameIntervalNs;
+    if (mNextFrameDueNs < timestampNs) {
+        mNextFrameDueNs = timestampNs + mTargetFrameIntervalNs;
+    }
+    return true;
+}
+
+bool FrameScheduler::shouldSubmitForDeadline(int64_t timestampNs, int64_t nowNs) {
+    const int64_t captureDelayNs = nowNs - timestampNs;
+    mMinCaptureDelayNs = std::min(mMinCaptureDelayNs, captureDelayNs);
+    const int64_t waitedNs = captureDelayNs - mMinCaptureDelayNs;
+
+    if (waitedNs + mFrameLatencyNs > mDeadlineNs &&
+        mConsecutiveDroppedFrames + 1 < kMaxConsecutiveDroppedFrames) {
+        mConsecutiveDroppedFrames++;
+        return false;
+    }
+    mConsecutiveDroppedFrames = 0;
+    return true;
+}
+
+void FrameScheduler::onFrameFinished(float latencyMs) {
+    mFrameLatencyNs = smooth(mFrameLatencyNs, latencyMs * 1'000'000.0);
+}
+
+}  // namespace pose_estimation
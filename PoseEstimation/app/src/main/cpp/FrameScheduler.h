@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_FRAME_SCHEDULER_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_FRAME_SCHEDULER_H
+
+#include <cstdint>
+
+#include "PoseEstimationConfig.h"
+
+namespace pose_estimation {
+
+// Decides which camera frames are submitted to the pipeline, so that the results stay fresh when
+// the pipeline falls behind the camera, see FrameDropPolicy:
+// - LATEST_FRAME_WINS submits every frame it is given. The app only hands over the newest camera
+//   image, i.e. ImageReader.acquireLatestImage, so the older ones are dropped before.
+// - TARGET_FPS submits the frames closest to a fixed rate, and drops the others.
+// - DEADLINE drops a frame if its result is not expected within the deadline from its capture,
+//   i.e. if the frame has already waited too long for the time the pipeline takes. To keep the
+//   estimate current, at least one frame out of kMaxConsecutiveDroppedFrames is submitted.
+//
+// The capture timestamps can be of any clock counting in nanoseconds, e.g. Image.getTimestamp,
+// which may not be the clock of the pipeline. The time a frame has waited is thus measured as its
+// delay from capture to shouldSubmit beyond the smallest delay seen so far.
+class FrameScheduler {
+   public:
+    static constexpr uint32_t kMaxConsecutiveDroppedFrames = 8;
+
+    explicit FrameScheduler(const PoseEstimationConfig& config);
+
+    // Whether to submit the frame captured at timestampNs to the pipeline, given the current
+    // time nowNs of a steady clock
+    bool shouldSubmit(int64_t timestampNs, int64_t nowNs);
+
+    // The latency of a submitted frame, from PoseEstimator::run to its result
+    void onFrameFinished(float latencyMs);
+
+   private:
+    bool shouldSubmitForTargetFps(int64_t timestampNs);
+    bool shouldSubmitForDeadline(int64_t timestampNs, int64_t nowNs);
+
+    const FrameDropPolicy mPolicy;
+    const int64_t mTargetFrameIntervalNs;
+    const int64_t mDeadlineNs;
+
+    // The interval between the camera frames given to shouldSubmit, smoothed
+    bool mHasPreviousFrame = false;
+    int64_t mPreviousTimestampNs = 0;
+    double mCameraFrameIntervalNs = 0.0;
+
+    // FrameDropPolicy::TARGET_FPS, the capture time the next frame is due at
+    int64_t mNextFrameDueNs = INT64_MIN;
+
+    // FrameDropPolicy::DEADLINE
+    int64_t mMinCaptureDelayNs = INT64_MAX;
+    // The latency of the submitted frames, smoothed, 0 until the first result
+    double mFrameLatencyNs = 0.0;
+    uint32_t mConsecutiveDroppedFrames = 0;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_FRAME_SCHEDULER_H
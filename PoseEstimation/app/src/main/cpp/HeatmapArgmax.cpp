@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HeatmapArgmax.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace pose_estimation {
+namespace {
+
+// Updates the maxima of the channels [begin, numberOfChannels) with one cell
+template <typename T>
+inline void updateScalar(const T* cell, uint32_t cellIndex, uint32_t begin,
+                         uint32_t numberOfChannels, T* maxValues, uint32_t* maxCellIndexes) {
+    for (uint32_t c = begin; c < numberOfChannels; c++) {
+        if (cell[c] > maxValues[c]) {
+            maxValues[c] = cell[c];
+            maxCellIndexes[c] = cellIndex;
+        }
+    }
+}
+
+// Every implementation starts from the first cell, so that ties keep the first cell as the
+// strided per-channel scan does
+template <typename T>
+inline void initialize(const T* heatmap, uint32_t numberOfChannels, T* maxValues,
+                       uint32_t* maxCellIndexes) {
+    std::memcpy(maxValues, heatmap, numberOfChannels * sizeof(T));
+    std::memset(maxCellIndexes, 0, numberOfChannels * sizeof(uint32_t));
+}
+
+}  // namespace
+
+void computeHeatmapArgmaxScalar(const float* heatmap, uint32_t numberOfCells,
+                                uint32_t numberOfChannels, float* maxValues,
+                                uint32_t* maxCellIndexes) {
+    initialize(heatmap, numberOfChannels, maxValues, maxCellIndexes);
+    for (uint32_t i = 1; i < numberOfCells; i++) {
+        updateScalar(heatmap + i * numberOfChannels, i, 0, numberOfChannels, maxValues,
+                     maxCellIndexes);
+    }
+}
+
+void computeHeatmapArgmax(const uint8_t* heatmap, uint32_t numberOfCells,
+                          uint32_t numberOfChannels, uint8_t* maxValues, uint32_t* maxCellIndexes) {
+    initialize(heatmap, numberOfChannels, maxValues, maxCellIndexes);
+    for (uint32_t i = 1; i < numberOfCells; i++) {
+        updateScalar(heatmap + i * numberOfChannels, i, 0, numberOfChannels, maxValues,
+                     maxCellIndexes);
+    }
+}
+
+#if defined(__ARM_NEON)
+
+void computeHeatmapArgmax(const float* heatmap, uint32_t numberOfCells, uint32_t numberOfChannels,
+                          float* maxValues, uint32_t* maxCellIndexes) {
+    initialize(heatmap, numberOfChannels, maxValues, maxCellIndexes);
+    const uint32_t vectorChannels = numberOfChannels & ~3u;
+    for (uint32_t i = 1; i < numberOfCells; i++) {
+        const float* cell = heatmap + i * numberOfChannels;
+        const uint32x4_t index = vdupq_n_u32(i);
+        for (uint32_t c = 0; c < vectorChannels; c += 4) {
+            const float32x4_t value = vld1q_f32(cell + c);
+            const float32x4_t maxValue = vld1q_f32(maxValues + c);
+            const uint32x4_t greater = vcgtq_f32(value, maxValue);
+            vst1q_f32(maxValues + c, vbslq_f32(greater, value, maxValue));
+            vst1q_u32(maxCellIndexes + c,
+                      vbslq_u32(greater, index, vld1q_u32(maxCellIndexes + c)));
+        }
+        updateScalar(cell, i, vectorChannels, numberOfChannels, maxValues, maxCellIndexes);
+    }
+}
+
+#elif defined(__AVX__)
+
+void computeHeatmapArgmax(const float* heatmap, uint32_t numberOfCells, uint32_t numberOfChannels,
+                          float* maxValues, uint32_t* maxCellIndexes) {
+    initialize(heatmap, numberOfChannels, maxValues, maxCellIndexes);
+    const uint32_t vectorChannels = numberOfChannels & ~7u;
+    for (uint32_t i = 1; i < numberOfCells; i++) {
+        const float* cell = heatmap + i * numberOfChannels;
+        // The indexes are blended as floats, which only moves their bits around
+        const __m256 index = _mm256_castsi256_ps(_mm256_set1_epi32(i));
+        for (uint32_t c = 0; c < vectorChannels; c += 8) {
+            auto* indexes = reinterpret_cast<float*>(maxCellIndexes + c);
+            const __m256 value = _mm256_loadu_ps(cell + c);
+            const __m256 maxValue = _mm256_loadu_ps(maxValues + c);
+            const __m256 greater = _mm256_cmp_ps(value, maxValue, _CMP_GT_OQ);
+            _mm256_storeu_ps(maxValues + c, _mm256_blendv_ps(maxValue, value, greater));
+            _mm256_storeu_ps(indexes, _mm256_blendv_ps(_mm256_loadu_ps(indexes), index, greater));
+        }
+        updateScalar(cell, i, vectorChannels, numberOfChannels, maxValues, maxCellIndexes);
+    }
+}
+
+#elif defined(__SSE2__)
+
+void computeHeatmapArgmax(const float* heatmap, uint32_t numberOfCells, uint32_t numberOfChannels,
+                          float* maxValues, uint32_t* maxCellIndexes) {
+    initialize(heatmap, numberOfChannels, maxValues, maxCellIndexes);
+    const uint32_t vectorChannels = numberOfChannels & ~3u;
+    for (uint32_t i = 1; i < numberOfCells; i++) {
+        const float* cell = heatmap + i * numberOfChannels;
+        const __m128i index = _mm_set1_epi32(i);
+        for (uint32_t c = 0; c < vectorChannels; c += 4) {
+            auto* indexes = reinterpret_cast<__m128i*>(maxCellIndexes + c);
+            const __m128 value = _mm_loadu_ps(cell + c);
+            const __m128 maxValue = _mm_loadu_ps(maxValues + c);
+            const __m128 greater = _mm_cmpgt_ps(value, maxValue);
+            const __m128i greaterMask = _mm_castps_si128(greater);
+            _mm_storeu_ps(maxValues + c, _mm_max_ps(value, maxValue));
+            _mm_storeu_si128(indexes, _mm_or_si128(_mm_and_si128(greaterMask, index),
+                                                   _mm_andnot_si128(greaterMask,
+                                                                    _mm_loadu_si128(indexes))));
+        }
+        updateScalar(cell, i, vectorChannels, numberOfChannels, maxValues, maxCellIndexes);
+    }
+}
+
+#else
+
+void computeHeatmapArgmax(const float* heatmap, uint32_t numberOfCells, uint32_t numberOfChannels,
+                          float* maxValues, uint32_t* maxCellIndexes) {
+    computeHeatmapArgmaxScalar(heatmap, numberOfCells, numberOfChannels, maxValues,
+                               maxCellIndexes);
+}
+
+#endif
+
+}  // namespace pose_estimation
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_HEATMAP_ARGMAX_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_HEATMAP_ARGMAX_H
+
+#include <cstdint>
+
+namespace pose_estimation {
+
+// Finds the maximum value of every channel of an NHWC heatmap with a batch size of 1, and the
+// index of the first cell (h * width + w) holding it.
+//
+// The heatmap is read in a single contiguous pass, updating the maxima of all channels at once for
+// every cell, rather than in one strided pass per channel. maxValues and maxCellIndexes must hold
+// numberOfChannels elements. numberOfCells must be at least 1.
+//
+// This dispatches at compile time to the NEON, AVX or SSE2 implementation if available, and to
+// computeHeatmapArgmaxScalar otherwise.
+void computeHeatmapArgmax(const float* heatmap, uint32_t numberOfCells, uint32_t numberOfChannels,
+                          float* maxValues, uint32_t* maxCellIndexes);
+
+// The portable implementation of computeHeatmapArgmax
+void computeHeatmapArgmaxScalar(const float* heatmap, uint32_t numberOfCells,
+                                uint32_t numberOfChannels, float* maxValues,
+                                uint32_t* maxCellIndexes);
+
+// computeHeatmapArgmax on a TENSOR_QUANT8_ASYMM heatmap. The quantized values order like the real
+// values, so they are compared without dequantizing. Only scalar: the quantized heatmap is a
+// quarter of the size of the float one.
+void computeHeatmapArgmax(const uint8_t* heatmap, uint32_t numberOfCells,
+                          uint32_t numberOfChannels, uint8_t* maxValues, uint32_t* maxCellIndexes);
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_HEATMAP_ARGMAX_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+namespace pose_estimation {
+namespace {
+
+// The latencies below 2^kLinearBits us have a bucket each. Above, every power of two is split into
+// 2^kSubBucketBits buckets.
+constexpr uint32_t kLinearBits = 6;
+constexpr uint32_t kSubBucketBits = 5;
+constexpr uint32_t kLinearBuckets = 1u << kLinearBits;
+constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;
+constexpr uint32_t kNumberOfBuckets = kLinearBuckets + (32 - kLinearBits) * kSubBuckets;
+
+uint32_t toMicroseconds(float latencyMs) {
+    const float latencyUs = std::round(latencyMs * 1000.0f);
+    if (!(latencyUs > 0.0f)) return 0;
+    if (latencyUs >= 4294967295.0f) return UINT32_MAX;
+    return static_cast<uint32_t>(latencyUs);
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : mBucketCounts(kNumberOfBuckets), mWindow(kWindowSize) {}
+
+uint32_t LatencyHistogram::getBucketIndex(uint32_t latencyUs) {
+    if (latencyUs < kLinearBuckets) return latencyUs;
+    // The latency is in [2^msb, 2^(msb + 1)), split by its kSubBucketBits bits below the msb
+    const uint32_t msb = 31 - __builtin_clz(latencyUs);
+    const uint32_t shift = msb - kSubBucketBits;
+    const uint32_t subBucket = (latencyUs >> shift) - kSubBuckets;
+    return kLinearBuckets + (msb - kLinearBits) * kSubBuckets + subBucket;
+}
+
+uint32_t LatencyHistogram::getBucketUpperBoundUs(uint32_t index) {
+    if (index < kLinearBuckets) return index;
+    const uint32_t msb = (index - kLinearBuckets) / kSubBuckets + kLinearBits;
+    const uint32_t subBucket = (index - kLinearBuckets) % kSubBuckets;
+    const uint32_t shift = msb - kSubBucketBits;
+    const uint64_t upperBound = (static_cast<uint64_t>(kSubBuckets + subBucket + 1) << shift) - 1;
+    return static_cast<uint32_t>(std::min<uint64_t>(upperBound, UINT32_MAX));
+}
+
+void LatencyHistogram::record(float latencyMs) {
+    if (std::isnan(latencyMs)) return;
+    const uint32_t latencyUs = toMicroseconds(latencyMs);
+    if (mNumberOfLatencies == kWindowSize) {
+        mBucketCounts[getBucketIndex(mWindow[mNextIndex])]--;
+    } else {
+        mNumberOfLatencies++;
+    }
+    mWindow[mNextIndex] = latencyUs;
+    mBucketCounts[getBucketIndex(latencyUs)]++;
+    mNextIndex = (mNextIndex + 1) % kWindowSize;
+}
+
+LatencyPercentiles LatencyHistogram::getPercentiles() const {
+    LatencyPercentiles percentiles = {.numberOfFrames = mNumberOfLatencies};
+    if (mNumberOfLatencies == 0) return percentiles;
+
+    // The maximum is exact, and bounds the percentiles reported from the bucket upper bounds
+    const uint32_t maxUs =
+            *std::max_element(mWindow.begin(), mWindow.begin() + mNumberOfLatencies);
+    percentiles.maxMs = maxUs / 1000.0f;
+
+    // The percentile p is the smallest latency that at least p of the latencies do not exceed
+    const std::pair<float, float*> targets[] = {
+            {0.50f, &percentiles.p50Ms},
+            {0.90f, &percentiles.p90Ms},
+            {0.99f, &percentiles.p99Ms},
+    };
+    uint32_t target = 0;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < kNumberOfBuckets && target < std::size(targets); i++) {
+        count += mBucketCounts[i];
+        while (target < std::size(targets) &&
+               count >= std::ceil(targets[target].first * mNumberOfLatencies)) {
+            *targets[target].second = std::min(getBucketUpperBoundUs(i), maxUs) / 1000.0f;
+            target++;
+        }
+    }
+    return percentiles;
+}
+
+void PipelineLatencies::recordFrame(const FrameLatencies& latencies) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRender.record(latencies.renderMs);
+    mFenceWait.record(latencies.fenceWaitMs);
+    mMl.record(latencies.mlMs);
+    mPostprocess.record(latencies.postprocessMs);
+    mEndToEnd.record(latencies.endToEndMs);
+    mProcessedFrames++;
+}
+
+void PipelineLatencies::recordDroppedFrames(uint32_t count) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mDroppedFrames += count;
+}
+
+PipelineLatencyStats PipelineLatencies::getStats() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return {
+            .render = mRender.getPercentiles(),
+            .fenceWait = mFenceWait.getPercentiles(),
+            .ml = mMl.getPercentiles(),
+            .postprocess = mPostprocess.getPercentiles(),
+            .endToEnd = mEndToEnd.getPercentiles(),
+            .processedFrames = mProcessedFrames,
+            .droppedFrames = mDroppedFrames,
+    };
+}
+
+}  // namespace pose_estimation
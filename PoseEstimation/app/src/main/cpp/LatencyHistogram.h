@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_LATENCY_HISTOGRAM_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_LATENCY_HISTOGRAM_H
+
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Utils.h"
+
+namespace pose_estimation {
+
+// The latency percentiles of a pipeline stage over the recent frames, in milliseconds. The
+// percentiles are NaN if no frame has been recorded.
+struct LatencyPercentiles {
+    float p50Ms = NAN;
+    float p90Ms = NAN;
+    float p99Ms = NAN;
+    float maxMs = NAN;
+    // The number of frames the percentiles are computed from
+    uint32_t numberOfFrames = 0;
+};
+
+// A histogram of the latencies of the last kWindowSize frames, with the log-linear buckets of
+// HdrHistogram: exact up to 64 us, then 32 buckets per power of two, so that a percentile is
+// within 1/32 (about 3.1%) of the exact latency. Recording a latency takes constant time, as the
+// oldest latency leaves the window; a percentile query walks the buckets.
+class LatencyHistogram {
+   public:
+    static constexpr uint32_t kWindowSize = 1024;
+
+    LatencyHistogram();
+
+    // NaN latencies, i.e. not measured, are not recorded
+    void record(float latencyMs);
+
+    LatencyPercentiles getPercentiles() const;
+
+   private:
+    static uint32_t getBucketIndex(uint32_t latencyUs);
+    // The largest latency that falls in the bucket
+    static uint32_t getBucketUpperBoundUs(uint32_t index);
+
+    std::vector<uint32_t> mBucketCounts;
+    // The latencies in the window, in microseconds, as a ring buffer
+    std::vector<uint32_t> mWindow;
+    uint32_t mNextIndex = 0;
+    uint32_t mNumberOfLatencies = 0;
+};
+
+// The latency percentiles of every stage of PoseEstimator, see PipelineLatencies
+struct PipelineLatencyStats {
+    // The CPU time of RendererBase::run
+    LatencyPercentiles render;
+    // The time blocked in MlExecutorBase::wait, for the sync fence or the ML computation
+    LatencyPercentiles fenceWait;
+    // From the end of RendererBase::run to the end of MlExecutorBase::wait, see
+    // PoseEstimationResult::mlLatencyMs
+    LatencyPercentiles ml;
+    // The decoding of the poses from the ML outputs
+    LatencyPercentiles postprocess;
+    // From the submission of the camera frame to PoseEstimator::run to its result, including the
+    // time spent behind the other frames in flight
+    LatencyPercentiles endToEnd;
+    // The frames processed and dropped since PoseEstimator was created
+    uint64_t processedFrames = 0;
+    uint64_t droppedFrames = 0;
+};
+
+// The latency histograms of the stages of PoseEstimator. Recorded on the pipeline thread, and
+// safe to query from any other thread.
+class PipelineLatencies {
+    DISABLE_COPY_AND_ASSIGN(PipelineLatencies);
+
+   public:
+    struct FrameLatencies {
+        float renderMs;
+        float fenceWaitMs;
+        float mlMs;
+        float postprocessMs;
+        float endToEndMs;
+    };
+
+    PipelineLatencies() = default;
+
+    void recordFrame(const FrameLatencies& latencies);
+    void recordDroppedFrames(uint32_t count);
+    PipelineLatencyStats getStats() const;
+
+   private:
+    mutable std::mutex mMutex;
+    LatencyHistogram mRender;
+    LatencyHistogram mFenceWait;
+    LatencyHistogram mMl;
+    LatencyHistogram mPostprocess;
+    LatencyHistogram mEndToEnd;
+    uint64_t mProcessedFrames = 0;
+    uint64_t mDroppedFrames = 0;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_LATENCY_HISTOGRAM_H
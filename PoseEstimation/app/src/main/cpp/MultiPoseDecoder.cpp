@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MultiPoseDecoder.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "HeatmapArgmax.h"
+#include "Utils.h"
+
+namespace pose_estimation {
+namespace {
+
+// The keypoints in the order of the model outputs
+enum BodyPart : uint32_t {
+    NOSE,
+    LEFT_EYE,
+    RIGHT_EYE,
+    LEFT_EAR,
+    RIGHT_EAR,
+    LEFT_SHOULDER,
+    RIGHT_SHOULDER,
+    LEFT_ELBOW,
+    RIGHT_ELBOW,
+    LEFT_WRIST,
+    RIGHT_WRIST,
+    LEFT_HIP,
+    RIGHT_HIP,
+    LEFT_KNEE,
+    RIGHT_KNEE,
+    LEFT_ANKLE,
+    RIGHT_ANKLE,
+};
+
+// The tree of body parts rooted at the nose, as {parent, child} edges.
+// The order matters: the displacement outputs hold one channel for each edge in this order.
+constexpr uint32_t kNumberOfEdges = kNumberOfDisplacements / 2;
+constexpr std::array<std::pair<BodyPart, BodyPart>, kNumberOfEdges> kEdges = {{
+        {NOSE, LEFT_EYE},
+        {LEFT_EYE, LEFT_EAR},
+        {NOSE, RIGHT_EYE},
+        {RIGHT_EYE, RIGHT_EAR},
+        {NOSE, LEFT_SHOULDER},
+        {LEFT_SHOULDER, LEFT_ELBOW},
+        {LEFT_ELBOW, LEFT_WRIST},
+        {LEFT_SHOULDER, LEFT_HIP},
+        {LEFT_HIP, LEFT_KNEE},
+        {LEFT_KNEE, LEFT_ANKLE},
+        {NOSE, RIGHT_SHOULDER},
+        {RIGHT_SHOULDER, RIGHT_ELBOW},
+        {RIGHT_ELBOW, RIGHT_WRIST},
+        {RIGHT_SHOULDER, RIGHT_HIP},
+        {RIGHT_HIP, RIGHT_KNEE},
+        {RIGHT_KNEE, RIGHT_ANKLE},
+}};
+static_assert(kNumberOfKeypoints == RIGHT_ANKLE + 1);
+
+// The distance in pixels of the renderer output between two heatmap cells
+constexpr float kOutputStride = (kRendererOutputWidth - 1) / static_cast<float>(kHeatmapSize - 1);
+
+// The number of times a displaced keypoint is snapped to the heatmap and refined by its offset
+constexpr uint32_t kOffsetRefineSteps = 2;
+
+uint32_t cellIndex(uint32_t y, uint32_t x) { return y * kHeatmapSize + x; }
+
+// The heatmap cell nearest to a point in pixels
+uint32_t nearestCell(float coordinate) {
+    const float cell = std::round(coordinate / kOutputStride);
+    return static_cast<uint32_t>(std::clamp(cell, 0.0f, static_cast<float>(kHeatmapSize - 1)));
+}
+
+// Decodes the single pose from the cell of the maximum of every keypoint, see decodeSinglePose.
+// Tensor is either const float* or Quant8Tensor.
+template <typename Tensor>
+Pose decodeSinglePoseAt(const std::array<uint32_t, kNumberOfKeypoints>& maxCellIndexes,
+                        const Tensor& heatmap, const Tensor& offsets) {
+    std::vector<Keypoint> keypoints(kNumberOfKeypoints);
+    float scoreSum = 0.0f;
+
+    for (uint32_t k = 0; k < kNumberOfKeypoints; k++) {
+        const float maxValue = heatmap[maxCellIndexes[k] * kNumberOfKeypoints + k];
+        const uint32_t maxX = maxCellIndexes[k] % kHeatmapSize;
+        const uint32_t maxY = maxCellIndexes[k] / kHeatmapSize;
+
+        // Get the corresponding offset value
+        uint32_t yOffsetIndex = (maxY * kHeatmapSize + maxX) * kNumberOfKeypoints * 2 + k;
+        uint32_t xOffsetIndex = yOffsetIndex + kNumberOfKeypoints;
+        float yOffset = offsets[yOffsetIndex], xOffset = offsets[xOffsetIndex];
+
+        // Compute the normalized location of the keypoint
+        keypoints[k].x =
+                maxX / static_cast<float>(kHeatmapSize - 1) + xOffset / kRendererOutputWidth;
+        keypoints[k].y =
+                maxY / static_cast<float>(kHeatmapSize - 1) + yOffset / kRendererOutputHeight;
+
+        // Compute the keypoint score
+        keypoints[k].score = 1.0f / (1.0f + std::exp(-maxValue));
+        scoreSum += keypoints[k].score;
+    }
+
+    return {.keypoints = std::move(keypoints), .score = scoreSum / kNumberOfKeypoints};
+}
+
+}  // namespace
+
+Pose decodeSinglePose(const float* heatmap, const float* offsets) {
+    // Find the index of the maximum point in the heatmap of every keypoint
+    std::array<float, kNumberOfKeypoints> maxValues;
+    std::array<uint32_t, kNumberOfKeypoints> maxCellIndexes;
+    computeHeatmapArgmax(heatmap, kHeatmapSize * kHeatmapSize, kNumberOfKeypoints,
+                         maxValues.data(), maxCellIndexes.data());
+    return decodeSinglePoseAt(maxCellIndexes, heatmap, offsets);
+}
+
+Pose decodeSinglePose(Quant8Tensor heatmap, Quant8Tensor offsets) {
+    std::array<uint8_t, kNumberOfKeypoints> maxValues;
+    std::array<uint32_t, kNumberOfKeypoints> maxCellIndexes;
+    computeHeatmapArgmax(heatmap.data, kHeatmapSize * kHeatmapSize, kNumberOfKeypoints,
+                         maxValues.data(), maxCellIndexes.data());
+    return decodeSinglePoseAt(maxCellIndexes, heatmap, offsets);
+}
+
+template <typename Tensor>
+void MultiPoseDecoder::computeScores(const Tensor& heatmap) {
+    for (uint32_t i = 0; i < kOutputHeatmapSize; i++) {
+        mScores[i] = 1.0f / (1.0f + std::exp(-heatmap[i]));
+    }
+}
+
+void MultiPoseDecoder::findCandidates() {
+    const int radius = mOptions.localMaximumRadius;
+    mCandidates.clear();
+    for (int y = 0; y < static_cast<int>(kHeatmapSize); y++) {
+        for (int x = 0; x < static_cast<int>(kHeatmapSize); x++) {
+            const float* cellScores = &mScores[cellIndex(y, x) * kNumberOfKeypoints];
+            for (uint32_t k = 0; k < kNumberOfKeypoints; k++) {
+                const float score = cellScores[k];
+                if (score < mOptions.scoreThreshold) continue;
+
+                // Keep the cell only if no cell in the local window scores higher
+                const int yEnd = std::min(y + radius, static_cast<int>(kHeatmapSize) - 1);
+                const int xEnd = std::min(x + radius, static_cast<int>(kHeatmapSize) - 1);
+                bool isMaximum = true;
+                for (int wy = std::max(y - radius, 0); wy <= yEnd && isMaximum; wy++) {
+                    for (int wx = std::max(x - radius, 0); wx <= xEnd; wx++) {
+                        if (mScores[cellIndex(wy, wx) * kNumberOfKeypoints + k] > score) {
+                            isMaximum = false;
+                            break;
+                        }
+                    }
+                }
+                if (isMaximum) {
+                    mCandidates.push_back({.score = score,
+                                           .keypoint = k,
+                                           .y = static_cast<uint32_t>(y),
+                                           .x = static_cast<uint32_t>(x)});
+                }
+            }
+        }
+    }
+    std::make_heap(mCandidates.begin(), mCandidates.end());
+}
+
+bool MultiPoseDecoder::isSuppressed(const std::vector<std::array<Point, kNumberOfKeypoints>>& poses,
+                                    uint32_t keypoint, const Point& point) const {
+    const float squaredRadius = mOptions.nmsRadius * mOptions.nmsRadius;
+    return std::any_of(poses.begin(), poses.end(), [&](const auto& pose) {
+        const float dy = pose[keypoint].y - point.y, dx = pose[keypoint].x - point.x;
+        return dy * dy + dx * dx <= squaredRadius;
+    });
+}
+
+template <typename Tensor>
+MultiPoseDecoder::Point MultiPoseDecoder::traverse(uint32_t edge, const Point& source,
+                                                   uint32_t target, const Tensor& offsets,
+                                                   const Tensor& displacements) const {
+    // Displace the source keypoint along the edge
+    const uint32_t sourceCell = cellIndex(nearestCell(source.y), nearestCell(source.x));
+    const Tensor displacement = displacements + sourceCell * kNumberOfDisplacements;
+    Point point = {.y = source.y + displacement[edge],
+                   .x = source.x + displacement[edge + kNumberOfEdges]};
+
+    // Snap the displaced point to the heatmap of the target and refine it with the offsets
+    uint32_t y = nearestCell(point.y), x = nearestCell(point.x);
+    for (uint32_t i = 0; i < kOffsetRefineSteps; i++) {
+        const Tensor offset = offsets + cellIndex(y, x) * kNumberOfKeypoints * 2;
+        point.y = y * kOutputStride + offset[target];
+        point.x = x * kOutputStride + offset[target + kNumberOfKeypoints];
+        y = nearestCell(point.y);
+        x = nearestCell(point.x);
+    }
+    point.score = mScores[cellIndex(y, x) * kNumberOfKeypoints + target];
+    return point;
+}
+
+template <typename Tensor>
+std::vector<Pose> MultiPoseDecoder::decodePoses(const Tensor& heatmap, const Tensor& offsets,
+                                                const Tensor& displacementsFwd,
+                                                const Tensor& displacementsBwd) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    computeScores(heatmap);
+    findCandidates();
+
+    std::vector<std::array<Point, kNumberOfKeypoints>> decodedPoses;
+    std::vector<Pose> poses;
+    while (poses.size() < mOptions.maxNumberOfPoses && !mCandidates.empty()) {
+        std::pop_heap(mCandidates.begin(), mCandidates.end());
+        const Candidate root = mCandidates.back();
+        mCandidates.pop_back();
+
+        // Skip the root if it belongs to a pose found earlier
+        const Tensor rootOffset = offsets + cellIndex(root.y, root.x) * kNumberOfKeypoints * 2;
+        const Point rootPoint = {
+                .y = root.y * kOutputStride + rootOffset[root.keypoint],
+                .x = root.x * kOutputStride + rootOffset[root.keypoint + kNumberOfKeypoints],
+                .score = root.score,
+        };
+        if (isSuppressed(decodedPoses, root.keypoint, rootPoint)) continue;
+
+        // Walk up the tree towards the nose, then down towards the limbs
+        std::array<Point, kNumberOfKeypoints> points;
+        std::array<bool, kNumberOfKeypoints> found = {};
+        points[root.keypoint] = rootPoint;
+        found[root.keypoint] = true;
+        for (int edge = kNumberOfEdges - 1; edge >= 0; edge--) {
+            const auto [parent, child] = kEdges[edge];
+            if (found[child] && !found[parent]) {
+                points[parent] = traverse(edge, points[child], parent, offsets, displacementsBwd);
+                found[parent] = true;
+            }
+        }
+        for (uint32_t edge = 0; edge < kNumberOfEdges; edge++) {
+            const auto [parent, child] = kEdges[edge];
+            if (found[parent] && !found[child]) {
+                points[child] = traverse(edge, points[parent], child, offsets, displacementsFwd);
+                found[child] = true;
+            }
+        }
+
+        // Keypoints that overlap with the poses found earlier do not count towards the score
+        Pose pose = {.keypoints = std::vector<Keypoint>(kNumberOfKeypoints), .score = 0.0f};
+        for (uint32_t k = 0; k < kNumberOfKeypoints; k++) {
+            if (!isSuppressed(decodedPoses, k, points[k])) {
+                pose.score += points[k].score;
+            }
+            pose.keypoints[k] = {
+                    .x = points[k].x / (kRendererOutputWidth - 1),
+                    .y = points[k].y / (kRendererOutputHeight - 1),
+                    .score = points[k].score,
+            };
+        }
+        pose.score /= kNumberOfKeypoints;
+        decodedPoses.push_back(points);
+        poses.push_back(std::move(pose));
+
+        const std::chrono::duration<float, std::milli> elapsed =
+                std::chrono::high_resolution_clock::now() - start;
+        if (elapsed.count() > mOptions.latencyBudgetMs) break;
+    }
+    return poses;
+}
+
+std::vector<Pose> MultiPoseDecoder::decode(const float* heatmap, const float* offsets,
+                                           const float* displacementsFwd,
+                                           const float* displacementsBwd) {
+    return decodePoses(heatmap, offsets, displacementsFwd, displacementsBwd);
+}
+
+std::vector<Pose> MultiPoseDecoder::decode(Quant8Tensor heatmap, Quant8Tensor offsets,
+                                           Quant8Tensor displacementsFwd,
+                                           Quant8Tensor displacementsBwd) {
+    return decodePoses(heatmap, offsets, displacementsFwd, displacementsBwd);
+}
+
+}  // namespace pose_estimation
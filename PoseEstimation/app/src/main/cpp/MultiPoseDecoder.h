@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_MULTI_POSE_DECODER_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_MULTI_POSE_DECODER_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Utils.h"
+
+namespace pose_estimation {
+
+struct Keypoint {
+    float x;
+    float y;
+    float score;
+};
+
+struct Pose {
+    // kNumberOfKeypoints keypoints with normalized coordinates
+    std::vector<Keypoint> keypoints;
+    // The confidence that the keypoints belong to a person
+    float score;
+};
+
+// Decodes the pose of a single person from the PoseNet heatmap and offsets outputs, picking the
+// keypoint with the highest score for every body part. Of the quantized outputs, only the maxima
+// of the heatmap and their offsets are dequantized.
+Pose decodeSinglePose(const float* heatmap, const float* offsets);
+Pose decodeSinglePose(Quant8Tensor heatmap, Quant8Tensor offsets);
+
+// Decodes the poses of multiple persons from the PoseNet outputs, following the multi-person
+// decoding of PoseNet:
+// 1. Every heatmap cell that is a local maximum of its keypoint and scores above the threshold is
+//    a candidate root of a pose, candidates are visited from the highest score down;
+// 2. A root too close to the same keypoint of an already decoded pose is skipped (NMS);
+// 3. The rest of the pose is found by walking the tree of body parts from the root, following
+//    the backward displacements towards the nose and the forward displacements towards the limbs,
+//    and refining every displaced point with the offsets of its part.
+//
+// The decoder reuses its buffers across frames, so decode() does not allocate in steady state
+// except for the returned poses.
+class MultiPoseDecoder {
+    DISABLE_COPY_AND_ASSIGN(MultiPoseDecoder);
+
+   public:
+    struct Options {
+        uint32_t maxNumberOfPoses = 5;
+        // Minimum score of a root keypoint
+        float scoreThreshold = 0.5f;
+        // Minimum distance in pixels of the renderer output between the same keypoints of two
+        // poses
+        float nmsRadius = 20.0f;
+        // The radius in heatmap cells of the window in which a root must be the maximum
+        uint32_t localMaximumRadius = 1;
+        // No more poses are decoded once decoding a frame has taken this long
+        float latencyBudgetMs = 0.5f;
+    };
+
+    explicit MultiPoseDecoder(Options options) : mOptions(options) {}
+
+    // The outputs are laid out as the PoseNet outputs, see NnapiExecutor. Of the quantized outputs,
+    // the heatmap is dequantized once into the scores, and the offsets and displacements only
+    // where the poses are walked.
+    std::vector<Pose> decode(const float* heatmap, const float* offsets,
+                             const float* displacementsFwd, const float* displacementsBwd);
+    std::vector<Pose> decode(Quant8Tensor heatmap, Quant8Tensor offsets,
+                             Quant8Tensor displacementsFwd, Quant8Tensor displacementsBwd);
+
+   private:
+    struct Candidate {
+        float score;
+        uint32_t keypoint;
+        uint32_t y, x;
+        bool operator<(const Candidate& other) const { return score < other.score; }
+    };
+
+    // A keypoint in pixels of the renderer output
+    struct Point {
+        float y, x;
+        float score;
+    };
+
+    // Tensor is either const float* or Quant8Tensor
+    template <typename Tensor>
+    std::vector<Pose> decodePoses(const Tensor& heatmap, const Tensor& offsets,
+                                  const Tensor& displacementsFwd, const Tensor& displacementsBwd);
+    template <typename Tensor>
+    void computeScores(const Tensor& heatmap);
+    void findCandidates();
+    bool isSuppressed(const std::vector<std::array<Point, kNumberOfKeypoints>>& poses,
+                      uint32_t keypoint, const Point& point) const;
+    template <typename Tensor>
+    Point traverse(uint32_t edge, const Point& source, uint32_t target, const Tensor& offsets,
+                   const Tensor& displacements) const;
+
+    Options mOptions;
+
+    // Sigmoid of the heatmap, laid out as the heatmap
+    std::array<float, kOutputHeatmapSize> mScores;
+    // Max-heap of the root candidates
+    std::vector<Candidate> mCandidates;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_MULTI_POSE_DECODER_H
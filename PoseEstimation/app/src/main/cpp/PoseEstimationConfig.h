@@ -17,10 +17,20 @@
 #ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_POSE_ESTIMATION_CONFIG_H
 #define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_POSE_ESTIMATION_CONFIG_H
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace pose_estimation {
 
-enum class Renderer { VULKAN = 0, GLES = 1 };
-enum class MlExecutor { NATIVE_NNAPI = 0 };
+// CPU preprocesses the camera frames without a GPU, see CpuRenderer. AUTO times the others on the
+// device at startup and picks the cheapest, see selectCameraPreprocessing.
+enum class Renderer { VULKAN = 0, GLES = 1, CPU = 2, AUTO = 3 };
+// NATIVE_NNAPI_QUANT8 runs the TENSOR_QUANT8_ASYMM variant of the model written by
+// tools/quantize_model.py, which is faster on most DSPs and NPUs
+enum class MlExecutor { NATIVE_NNAPI = 0, NATIVE_NNAPI_QUANT8 = 1 };
+// Which camera frames are dropped when the pipeline falls behind the camera, see FrameScheduler
+enum class FrameDropPolicy { LATEST_FRAME_WINS = 0, TARGET_FPS = 1, DEADLINE = 2 };
 
 struct PoseEstimationConfig {
     Renderer renderer = Renderer::VULKAN;
@@ -29,6 +39,59 @@ struct PoseEstimationConfig {
     // The maximum number of unique camera AHardwareBuffers that will be sent to the renderer,
     // can be obtained via ImageReader.maxImages
     uint32_t maxNumberOfCameraImages = 0;
+
+    // The size of the camera frames, only needed by Renderer::AUTO to time the renderers on a
+    // synthetic frame of the same size
+    uint32_t cameraWidth = 0;
+    uint32_t cameraHeight = 0;
+
+    // Whether the camera frames are YUV_420_888 images whose Y and UV planes the renderer reads as
+    // raw buffers, with the color conversion, the texture transform and the normalization fused in
+    // one kernel. Otherwise, the camera frames are sampled through the implicit YUV conversion of
+    // the driver, i.e. samplerExternalOES or VkSamplerYcbcrConversion. Renderer::CPU always reads
+    // the raw planes.
+    bool rawYuvCameraInput = false;
+
+    // The maximum number of camera frames in flight. With a depth of 1, every frame is rendered,
+    // inferred and postprocessed before PoseEstimator::run returns. With a larger depth, the
+    // renderer works on the next frame while the ML executor is still running the previous ones,
+    // and PoseEstimator::run returns the result of the frame submitted (pipelineDepth - 1) calls
+    // earlier.
+    uint32_t pipelineDepth = 1;
+
+    // An app-private directory in which the NNAPI compilation and the Vulkan pipeline cache are
+    // kept across launches, e.g. Context.getCodeCacheDir(). Caching is disabled if empty.
+    std::string compilationCacheDir;
+
+    // The maximum number of persons to detect in a camera frame. With 1, the single keypoint with
+    // the highest score is picked for every body part. With more, the poses are decoded with the
+    // displacement outputs, see MultiPoseDecoder.
+    uint32_t maxNumberOfPoses = 1;
+
+    // The names of the NNAPI devices to compile the model for, see ANeuralNetworksDevice_getName.
+    // The devices must support every operation of the model between them, so that no operation
+    // falls back to another device. If empty, the model is compiled for the most specialized
+    // device supporting all of its operations, or else partitioned by the NNAPI runtime.
+    // The supported operations of every device are logged by NnapiExecutor.
+    std::vector<std::string> nnapiDevices;
+
+    // Whether to pick the NNAPI execution preference and relaxed precision by timing every
+    // combination at startup, see tuneNnapiCompilation. The choice is kept in compilationCacheDir,
+    // so that the sweep only runs once per model and devices.
+    bool autoTuneCompilation = true;
+
+    // Whether the renderer writes the model input in half precision, which halves the memory
+    // traffic between the GPU and the accelerator. The model then takes a TENSOR_FLOAT16 input,
+    // which a CAST operation converts for the fp32 graph. Only applies to MlExecutor::NATIVE_NNAPI.
+    bool float16RendererOutput = false;
+
+    // Which camera frames PoseEstimator::runScheduled submits to the pipeline, see FrameScheduler
+    FrameDropPolicy frameDropPolicy = FrameDropPolicy::LATEST_FRAME_WINS;
+    // The maximum rate of the frames submitted with FrameDropPolicy::TARGET_FPS
+    float targetFps = 15.0f;
+    // The latency from the capture of a camera frame to its result beyond which
+    // FrameDropPolicy::DEADLINE drops the frame
+    float frameDeadlineMs = 100.0f;
 };
 
 }  // namespace pose_estimation
@@ -19,25 +19,75 @@
 #include <android/hardware_buffer_jni.h>
 #include <jni.h>
 
-#include <algorithm>
+#include <iterator>
 
 #include "PoseEstimationConfig.h"
 #include "PoseEstimator.h"
+#include "Trace.h"
 #include "Utils.h"
 
 using namespace pose_estimation;
 
+namespace {
+
+// Copies the 4x4 texture transform out of the Java array, rather than pinning its elements
+void getTextureTransform(JNIEnv* env, jfloatArray textureTransform, float (&transform)[16]) {
+    CHECK(env->GetArrayLength(textureTransform) == 16);
+    env->GetFloatArrayRegion(textureTransform, 0, 16, transform);
+}
+
+// The status returned to PoseEstimator.kt by estimatePose, corresponds to the ESTIMATE_* constants
+enum EstimateStatus : jint {
+    // The camera frame is kept by the pipeline until its result is returned
+    kFrameSubmitted = 1 << 0,
+    // The result of the oldest frame in flight has been written to the result buffer
+    kHasResult = 1 << 1,
+};
+
+// Writes the percentiles of a stage as p50, p90, p99 and max, see getLatencyStats
+float* packLatencyPercentiles(const LatencyPercentiles& percentiles, float* buffer) {
+    *buffer++ = percentiles.p50Ms;
+    *buffer++ = percentiles.p90Ms;
+    *buffer++ = percentiles.p99Ms;
+    *buffer++ = percentiles.maxMs;
+    return buffer;
+}
+
+}  // namespace
+
 extern "C" JNIEXPORT jlong JNICALL
 Java_com_android_example_nnapi_poseestimation_PoseEstimator_createNativePoseEstimator(
         JNIEnv* env, jobject /* this */, jobject jAssetManager, jfloatArray textureTransform,
-        jint renderer, jint mlExecutor, jint maxNumberOfCameraImages) {
+        jint renderer, jint mlExecutor, jint maxNumberOfCameraImages, jint cameraWidth,
+        jint cameraHeight, jint pipelineDepth, jstring compilationCacheDir, jint maxNumberOfPoses,
+        jobjectArray nnapiDevices, jint frameDropPolicy, jfloat targetFps, jfloat frameDeadlineMs,
+        jboolean float16RendererOutput) {
+    const char* cacheDir = env->GetStringUTFChars(compilationCacheDir, nullptr);
     PoseEstimationConfig config = {
             .renderer = static_cast<Renderer>(renderer),
             .mlExecutor = static_cast<MlExecutor>(mlExecutor),
             .maxNumberOfCameraImages = static_cast<uint32_t>(maxNumberOfCameraImages),
+            .cameraWidth = static_cast<uint32_t>(cameraWidth),
+            .cameraHeight = static_cast<uint32_t>(cameraHeight),
+            .pipelineDepth = static_cast<uint32_t>(pipelineDepth),
+            .compilationCacheDir = cacheDir,
+            .maxNumberOfPoses = static_cast<uint32_t>(maxNumberOfPoses),
+            .float16RendererOutput = float16RendererOutput == JNI_TRUE,
+            .frameDropPolicy = static_cast<FrameDropPolicy>(frameDropPolicy),
+            .targetFps = targetFps,
+            .frameDeadlineMs = frameDeadlineMs,
     };
+    env->ReleaseStringUTFChars(compilationCacheDir, cacheDir);
+    for (jsize i = 0; i < env->GetArrayLength(nnapiDevices); i++) {
+        auto jdevice = static_cast<jstring>(env->GetObjectArrayElement(nnapiDevices, i));
+        const char* device = env->GetStringUTFChars(jdevice, nullptr);
+        config.nnapiDevices.emplace_back(device);
+        env->ReleaseStringUTFChars(jdevice, device);
+        env->DeleteLocalRef(jdevice);
+    }
     AAssetManager* assetManager = AAssetManager_fromJava(env, jAssetManager);
-    const float* transform = env->GetFloatArrayElements(textureTransform, nullptr);
+    float transform[16];
+    getTextureTransform(env, textureTransform, transform);
     auto estimator = std::make_unique<PoseEstimator>(config, assetManager, transform);
     CHECK(estimator != nullptr);
     return (jlong)estimator.release();
@@ -50,38 +100,79 @@ Java_com_android_example_nnapi_poseestimation_PoseEstimator_destroyNativePoseEst
     delete estimator;
 }
 
-extern "C" JNIEXPORT jobject JNICALL
-Java_com_android_example_nnapi_poseestimation_PoseEstimator_estimatePose(JNIEnv* env,
-                                                                         jobject /* this */,
-                                                                         jlong handle,
-                                                                         jobject buffer) {
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_android_example_nnapi_poseestimation_PoseEstimator_usesRawYuvCameraInput(
+        JNIEnv* env, jobject /* this */, jlong handle) {
+    auto* estimator = (PoseEstimator*)handle;
+    return estimator->usesRawYuvCameraInput();
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_android_example_nnapi_poseestimation_PoseEstimator_setTextureTransform(
+        JNIEnv* env, jobject /* this */, jlong handle, jfloatArray textureTransform) {
+    auto* estimator = (PoseEstimator*)handle;
+    float transform[16];
+    getTextureTransform(env, textureTransform, transform);
+    estimator->setTextureTransform(transform);
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_com_android_example_nnapi_poseestimation_PoseEstimator_estimatePose(
+        JNIEnv* env, jobject /* this */, jlong handle, jobject buffer, jlong timestampNs,
+        jobject resultBuffer) {
+    TRACE_SCOPE("JNI estimatePose");
     auto* estimator = (PoseEstimator*)handle;
     auto* ahwb = AHardwareBuffer_fromHardwareBuffer(env, buffer);
-    auto result = estimator->run(ahwb);
-
-    // Get the java Keypoint & NativeResult class and their constructors
-    jclass keypointClass =
-            env->FindClass("com/android/example/nnapi/poseestimation/PoseEstimator$Keypoint");
-    CHECK(keypointClass != nullptr);
-    jmethodID keypointClassCtor = env->GetMethodID(keypointClass, "<init>", "(FFF)V");
-    CHECK(keypointClassCtor != nullptr);
-    jclass resultClass =
-            env->FindClass("com/android/example/nnapi/poseestimation/PoseEstimator$NativeResult");
-    CHECK(resultClass != nullptr);
-    jmethodID resultClassCtor = env->GetMethodID(
-            resultClass, "<init>",
-            "([Lcom/android/example/nnapi/poseestimation/PoseEstimator$Keypoint;FF)V");
-    CHECK(resultClassCtor != nullptr);
-
-    // Convert C++ result struct to java native result class
-    jobjectArray jkeypoints = env->NewObjectArray(result.keypoints.size(), keypointClass, nullptr);
-    for (uint32_t i = 0; i < result.keypoints.size(); i++) {
-        const auto& keypoint = result.keypoints[i];
-        jobject jkeypoint = env->NewObject(keypointClass, keypointClassCtor, keypoint.x, keypoint.y,
-                                           keypoint.score);
-        env->SetObjectArrayElement(jkeypoints, i, jkeypoint);
+    auto [submitted, maybeResult] = estimator->runScheduled(ahwb, timestampNs);
+    const jint status = submitted ? kFrameSubmitted : 0;
+
+    // No result is available yet while the pipeline is filling up
+    if (!maybeResult) {
+        return status;
     }
-    jobject jresult = env->NewObject(resultClass, resultClassCtor, jkeypoints,
-                                     result.renderLatencyMs, result.mlLatencyMs);
-    return jresult;
+
+    // The result is packed into the direct FloatBuffer of the caller, which is allocated once, so
+    // that no Java object is created per frame. See PackedResultLayout for the layout.
+    TRACE_SCOPE("JNI packPoseEstimationResult");
+    auto* data = static_cast<float*>(env->GetDirectBufferAddress(resultBuffer));
+    CHECK(data != nullptr);
+    packPoseEstimationResult(*maybeResult, data, env->GetDirectBufferCapacity(resultBuffer));
+    return status | kHasResult;
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_android_example_nnapi_poseestimation_PoseEstimator_recordDroppedFrames(
+        JNIEnv* env, jobject /* this */, jlong handle, jint count) {
+    auto* estimator = (PoseEstimator*)handle;
+    estimator->recordDroppedFrames(static_cast<uint32_t>(count));
+}
+
+// Fills the array with the percentiles of the render, fence wait, ML, postprocess and end-to-end
+// stages, followed by the processed and dropped frame counts. Corresponds to the LATENCY_STATS_*
+// constants in PoseEstimator.kt.
+extern "C" JNIEXPORT void JNICALL
+Java_com_android_example_nnapi_poseestimation_PoseEstimator_getLatencyStats(
+        JNIEnv* env, jobject /* this */, jlong handle, jfloatArray stats) {
+    auto* estimator = (PoseEstimator*)handle;
+    const PipelineLatencyStats latencyStats = estimator->getLatencyStats();
+    float buffer[5 * 4 + 2];
+    float* end = buffer;
+    end = packLatencyPercentiles(latencyStats.render, end);
+    end = packLatencyPercentiles(latencyStats.fenceWait, end);
+    end = packLatencyPercentiles(latencyStats.ml, end);
+    end = packLatencyPercentiles(latencyStats.postprocess, end);
+    end = packLatencyPercentiles(latencyStats.endToEnd, end);
+    *end++ = static_cast<float>(latencyStats.processedFrames);
+    *end++ = static_cast<float>(latencyStats.droppedFrames);
+    CHECK(env->GetArrayLength(stats) == std::size(buffer));
+    env->SetFloatArrayRegion(stats, 0, std::size(buffer), buffer);
+}
+
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_android_example_nnapi_poseestimation_PoseEstimator_writeTrace(
+        JNIEnv* env, jobject /* this */, jstring path) {
+    const char* tracePath = env->GetStringUTFChars(path, nullptr);
+    const bool success = writeChromeTrace(tracePath);
+    env->ReleaseStringUTFChars(path, tracePath);
+    return success;
 }
@@ -20,16 +20,16 @@
 #include <android/hardware_buffer.h>
 
 #include <chrono>
-#include <cmath>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "MultiPoseDecoder.h"
 #include "PoseEstimationConfig.h"
+#include "Trace.h"
 #include "Utils.h"
 #include "ml/NnapiExecutor.h"
-#include "renderer/GlComputeRenderer.h"
-#include "renderer/VulkanComputeRenderer.h"
+#include "renderer/RendererSelector.h"
 
 namespace pose_estimation {
 namespace {
@@ -41,100 +41,206 @@ float durationMsBetween(const std::chrono::high_resolution_clock::time_point& st
 
 }  // namespace
 
+void packPoseEstimationResult(const PoseEstimationResult& result, float* buffer, size_t capacity) {
+    using Layout = PackedResultLayout;
+    CHECK(capacity >= Layout::size(result.poses.size()));
+    buffer[Layout::kNumberOfPoses] = result.poses.size();
+    buffer[Layout::kRenderLatencyMs] = result.renderLatencyMs;
+    buffer[Layout::kMlLatencyMs] = result.mlLatencyMs;
+    buffer[Layout::kRenderQueueWaitMs] = result.renderTiming.queueWaitMs;
+    buffer[Layout::kRenderGpuExecutionMs] = result.renderTiming.gpuExecutionMs;
+    buffer[Layout::kRenderFenceSignalMs] = result.renderTiming.fenceSignalMs;
+    buffer[Layout::kMlOnHardwareMs] = result.mlTiming.onHardwareMs;
+    buffer[Layout::kMlInDriverMs] = result.mlTiming.inDriverMs;
+    buffer[Layout::kMlFencedOnHardwareMs] = result.mlTiming.fencedOnHardwareMs;
+    buffer[Layout::kMlFencedInDriverMs] = result.mlTiming.fencedInDriverMs;
+    float* out = buffer + Layout::kHeaderSize;
+    for (const Pose& pose : result.poses) {
+        CHECK(pose.keypoints.size() == kNumberOfKeypoints);
+        *out++ = pose.score;
+        for (const Keypoint& keypoint : pose.keypoints) {
+            *out++ = keypoint.x;
+            *out++ = keypoint.y;
+            *out++ = keypoint.score;
+        }
+    }
+}
+
 PoseEstimator::PoseEstimator(PoseEstimationConfig config, AAssetManager* assetManager,
                              const float* textureTransform)
-    : mConfig(config) {
-    // Initialize the GPU renderer based on the configuration
-    switch (config.renderer) {
-        case Renderer::GLES:
-            mRenderer = std::make_unique<GlComputeRenderer>(config, textureTransform);
-            break;
-        case Renderer::VULKAN:
-            mRenderer =
-                    std::make_unique<VulkanComputeRenderer>(config, assetManager, textureTransform);
-            break;
-        default:
-            CHECK(false);
+    : mConfig(config), mFrameScheduler(config) {
+    // The quantized input is already 8-bit
+    if (config.mlExecutor == MlExecutor::NATIVE_NNAPI_QUANT8 && config.float16RendererOutput) {
+        LOGE("The half-precision renderer output does not apply to the quantized model");
+        config.float16RendererOutput = false;
+    }
+
+    // Time the renderers on the device, the camera input follows the pick
+    if (config.renderer == Renderer::AUTO) {
+        const CameraPreprocessing preprocessing =
+                selectCameraPreprocessing(config, assetManager, textureTransform);
+        config.renderer = preprocessing.renderer;
+        config.rawYuvCameraInput = preprocessing.rawYuvCameraInput;
+    }
+
+    // The CPU renderer has no other way to read the camera frames
+    if (config.renderer == Renderer::CPU) {
+        config.rawYuvCameraInput = true;
     }
+    mConfig = config;
+
+    // Initialize the renderer based on the configuration
+    mRenderer = createRenderer(config, assetManager, textureTransform);
 
     // Initialize the ML executor based on the configuration
     switch (config.mlExecutor) {
         case MlExecutor::NATIVE_NNAPI:
+        case MlExecutor::NATIVE_NNAPI_QUANT8:
             mMlExecutor = std::make_unique<NnapiExecutor>(config, assetManager);
             break;
         default:
             CHECK(false);
     }
 
-    // Allocate the AHardwareBuffer for the intermediate result between GPU and ML workloads
+    // Initialize the postprocessing
+    CHECK(config.maxNumberOfPoses > 0);
+    if (config.maxNumberOfPoses > 1) {
+        mMultiPoseDecoder = std::make_unique<MultiPoseDecoder>(
+                MultiPoseDecoder::Options{.maxNumberOfPoses = config.maxNumberOfPoses});
+    }
+
+    // Allocate the AHardwareBuffers for the intermediate results between GPU and ML workloads,
+    // one for each frame in flight. The CPU renderer writes them through a CPU mapping.
+    CHECK(config.pipelineDepth > 0);
     const uint32_t inputMemorySize = mMlExecutor->getRequiredInputMemorySize();
-    mIntermediateMemory = std::make_unique<ManagedBlobAhwb>(
-            inputMemorySize,
-            AHARDWAREBUFFER_USAGE_GPU_DATA_BUFFER | AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN);
-    mRenderer->setOutputFromHardwareBuffer(mIntermediateMemory->handle());
-    mMlExecutor->setInputFromHardwareBuffer(mIntermediateMemory->handle());
+    uint64_t intermediateUsage =
+            AHARDWAREBUFFER_USAGE_GPU_DATA_BUFFER | AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN;
+    if (config.renderer == Renderer::CPU) {
+        intermediateUsage |= AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN;
+    }
+    mFrameSlots.resize(config.pipelineDepth);
+    for (uint32_t i = 0; i < mFrameSlots.size(); i++) {
+        auto& memory = mFrameSlots[i].intermediateMemory;
+        memory = std::make_unique<ManagedBlobAhwb>(inputMemorySize, intermediateUsage);
+        mRenderer->setOutputFromHardwareBuffer(i, memory->handle());
+        mMlExecutor->setInputFromHardwareBuffer(i, memory->handle());
+    }
 }
 
-PoseEstimationResult PoseEstimator::run(AHardwareBuffer* cameraInput) {
+PoseEstimator::~PoseEstimator() {
+    // The intermediate memories must outlive the workloads still in flight
+    while (mNumberOfFramesInFlight > 0) {
+        finishOldestFrame();
+    }
+}
+
+std::optional<PoseEstimationResult> PoseEstimator::run(AHardwareBuffer* cameraInput) {
+    TRACE_SCOPE("PoseEstimator::run");
+    const uint32_t slot = mNextSlot;
+    mNextSlot = (mNextSlot + 1) % mConfig.pipelineDepth;
     auto start = std::chrono::high_resolution_clock::now();
 
     // Run GPU workload
     // We prefer synchronizing the GPU and ML workloads with Android sync fence if supported
     bool preferSyncFence = mMlExecutor->supportsAndroidSyncFence();
-    UniqueFd syncFenceFd = mRenderer->run(cameraInput, preferSyncFence);
+    UniqueFd syncFenceFd = mRenderer->run(cameraInput, slot, preferSyncFence);
     auto rendererFinished = std::chrono::high_resolution_clock::now();
+    mFrameSlots[slot].renderLatencyMs = durationMsBetween(start, rendererFinished);
+    mFrameSlots[slot].renderFinished = rendererFinished;
+    mFrameSlots[slot].submitted = start;
 
-    // Run ML workload
-    mMlExecutor->run(std::move(syncFenceFd));
-    auto mlExecutorFinished = std::chrono::high_resolution_clock::now();
+    // Start ML workload, it may keep running while the next frames are rendered
+    mMlExecutor->start(slot, std::move(syncFenceFd));
+    mNumberOfFramesInFlight++;
 
-    // Run postprocessing
-    auto keypoints = computeKeypoints();
+    // Keep filling up the pipeline
+    if (mNumberOfFramesInFlight < mConfig.pipelineDepth) {
+        return std::nullopt;
+    }
+    return finishOldestFrame();
+}
 
-    return {
-            .keypoints = std::move(keypoints),
-            .renderLatencyMs = durationMsBetween(start, rendererFinished),
-            .mlLatencyMs = durationMsBetween(rendererFinished, mlExecutorFinished),
-    };
+ScheduledRunResult PoseEstimator::runScheduled(AHardwareBuffer* cameraInput,
+                                               int64_t timestampNs) {
+    const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now().time_since_epoch())
+                                  .count();
+    if (mFrameScheduler.shouldSubmit(timestampNs, nowNs)) {
+        return {.submitted = true, .result = run(cameraInput)};
+    }
+    TRACE_SCOPE("PoseEstimator::runScheduled dropped frame");
+    mLatencies.recordDroppedFrames(1);
+    if (mNumberOfFramesInFlight == 0) {
+        return {.submitted = false};
+    }
+    return {.submitted = false, .result = finishOldestFrame()};
 }
 
-std::vector<Keypoint> PoseEstimator::computeKeypoints() {
-    const float* outputHeatmap = mMlExecutor->getOutputHeatmapAddress();
-    const float* outputOffsets = mMlExecutor->getOutputOffsetsAddress();
-
-    std::vector<Keypoint> keypoints(kNumberOfKeypoints);
-
-    for (uint32_t k = 0; k < kNumberOfKeypoints; k++) {
-        // Find the index and value of the maximum point in the heatmap
-        float maxValue = outputHeatmap[k];
-        uint32_t maxX = 0, maxY = 0;
-        for (uint32_t h = 0; h < kHeatmapSize; h++) {
-            for (uint32_t w = 0; w < kHeatmapSize; w++) {
-                float value = outputHeatmap[(h * kHeatmapSize + w) * kNumberOfKeypoints + k];
-                if (value > maxValue) {
-                    maxValue = value;
-                    maxX = w;
-                    maxY = h;
-                }
-            }
-        }
+PoseEstimationResult PoseEstimator::finishOldestFrame() {
+    TRACE_SCOPE("PoseEstimator::finishOldestFrame");
+    CHECK(mNumberOfFramesInFlight > 0);
+    const uint32_t slot =
+            (mNextSlot + mConfig.pipelineDepth - mNumberOfFramesInFlight) % mConfig.pipelineDepth;
+    mNumberOfFramesInFlight--;
+
+    // Wait for ML workload
+    // With multiple frames in flight, the ML latency also includes the time the frame spent
+    // waiting behind the other frames in the pipeline
+    auto waitStart = std::chrono::high_resolution_clock::now();
+    mMlExecutor->wait(slot);
+    auto mlExecutorFinished = std::chrono::high_resolution_clock::now();
+    const MlTiming mlTiming = mMlExecutor->getTiming(slot);
 
-        // Get the corresponding offset value
-        uint32_t yOffsetIndex = (maxY * kHeatmapSize + maxX) * kNumberOfKeypoints * 2 + k;
-        uint32_t xOffsetIndex = yOffsetIndex + kNumberOfKeypoints;
-        float yOffset = outputOffsets[yOffsetIndex], xOffset = outputOffsets[xOffsetIndex];
+    // The render has finished too, as the ML workload waits for it
+    const RenderTiming renderTiming = mRenderer->getTiming(slot);
 
-        // Compute the normalized location of the keypoint
-        keypoints[k].x =
-                maxX / static_cast<float>(kHeatmapSize - 1) + xOffset / kRendererOutputWidth;
-        keypoints[k].y =
-                maxY / static_cast<float>(kHeatmapSize - 1) + yOffset / kRendererOutputHeight;
+    // Run postprocessing
+    auto poses = computePoses(slot);
+    auto postprocessFinished = std::chrono::high_resolution_clock::now();
+
+    PoseEstimationResult result = {
+            .poses = std::move(poses),
+            .renderLatencyMs = mFrameSlots[slot].renderLatencyMs,
+            .mlLatencyMs = durationMsBetween(mFrameSlots[slot].renderFinished, mlExecutorFinished),
+            .renderTiming = renderTiming,
+            .mlTiming = mlTiming,
+    };
+    const float endToEndMs = durationMsBetween(mFrameSlots[slot].submitted, postprocessFinished);
+    mLatencies.recordFrame({
+            .renderMs = result.renderLatencyMs,
+            .fenceWaitMs = durationMsBetween(waitStart, mlExecutorFinished),
+            .mlMs = result.mlLatencyMs,
+            .postprocessMs = durationMsBetween(mlExecutorFinished, postprocessFinished),
+            .endToEndMs = endToEndMs,
+    });
+    mFrameScheduler.onFrameFinished(endToEndMs);
+    return result;
+}
 
-        // Compute the keypoint score
-        keypoints[k].score = 1.0f / (1.0f + std::exp(-maxValue));
+std::vector<Pose> PoseEstimator::computePoses(uint32_t slot) {
+    TRACE_SCOPE("PoseEstimator::computePoses");
+    if (mMultiPoseDecoder == nullptr) {
+        return {computeSinglePose(slot)};
+    }
+    if (mMlExecutor->hasQuant8Outputs()) {
+        return mMultiPoseDecoder->decode(mMlExecutor->getQuant8OutputHeatmap(slot),
+                                         mMlExecutor->getQuant8OutputOffsets(slot),
+                                         mMlExecutor->getQuant8OutputDisplacementsFwd(slot),
+                                         mMlExecutor->getQuant8OutputDisplacementsBwd(slot));
     }
+    return mMultiPoseDecoder->decode(mMlExecutor->getOutputHeatmapAddress(slot),
+                                     mMlExecutor->getOutputOffsetsAddress(slot),
+                                     mMlExecutor->getOutputDisplacementsFwdAddress(slot),
+                                     mMlExecutor->getOutputDisplacementsBwdAddress(slot));
+}
 
-    return keypoints;
+Pose PoseEstimator::computeSinglePose(uint32_t slot) {
+    if (mMlExecutor->hasQuant8Outputs()) {
+        return decodeSinglePose(mMlExecutor->getQuant8OutputHeatmap(slot),
+                                mMlExecutor->getQuant8OutputOffsets(slot));
+    }
+    return decodeSinglePose(mMlExecutor->getOutputHeatmapAddress(slot),
+                            mMlExecutor->getOutputOffsetsAddress(slot));
 }
 
 }  // namespace pose_estimation
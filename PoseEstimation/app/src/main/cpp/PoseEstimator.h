@@ -21,9 +21,14 @@
 #include <android/bitmap.h>
 #include <android/hardware_buffer.h>
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include "FrameScheduler.h"
+#include "LatencyHistogram.h"
+#include "MultiPoseDecoder.h"
 #include "PoseEstimationConfig.h"
 #include "Utils.h"
 #include "ml/MlExecutorBase.h"
@@ -31,39 +36,135 @@
 
 namespace pose_estimation {
 
-struct Keypoint {
-    float x;
-    float y;
-    float score;
-};
-
 struct PoseEstimationResult {
-    std::vector<Keypoint> keypoints;
+    // At most mConfig.maxNumberOfPoses poses, sorted by score in descending order
+    std::vector<Pose> poses;
     // Time spent in render
+    // This is the CPU time of RendererBase::run, which only covers the submission of the GPU work
+    // if the frame is fenced. See renderTiming for the time spent on the GPU.
     float renderLatencyMs;
     // Time spent in ML executor
+    // This is the CPU time from the end of RendererBase::run to the end of MlExecutorBase::wait.
+    // See mlTiming for the time spent in the driver and on the accelerator.
     float mlLatencyMs;
+    // The GPU timing of the render, measured with GPU timestamps
+    RenderTiming renderTiming;
+    // The timing of the ML execution, measured by the driver
+    MlTiming mlTiming;
 };
 
+// The outcome of PoseEstimator::runScheduled
+struct ScheduledRunResult {
+    // Whether the camera frame was submitted to the pipeline. Otherwise, it has been dropped and
+    // can be released right away.
+    bool submitted;
+    // The result of the oldest frame in flight, if any is finished
+    std::optional<PoseEstimationResult> result;
+};
+
+// The layout of a PoseEstimationResult packed into floats for the app, so that no Java object is
+// allocated per frame, see packPoseEstimationResult. The header comes first, then every pose as its
+// score followed by the x, y and score of its kNumberOfKeypoints keypoints. Corresponds to the
+// RESULT_* constants in PoseEstimator.kt.
+struct PackedResultLayout {
+    enum Header : uint32_t {
+        kNumberOfPoses = 0,
+        kRenderLatencyMs,
+        kMlLatencyMs,
+        kRenderQueueWaitMs,
+        kRenderGpuExecutionMs,
+        kRenderFenceSignalMs,
+        kMlOnHardwareMs,
+        kMlInDriverMs,
+        kMlFencedOnHardwareMs,
+        kMlFencedInDriverMs,
+        kHeaderSize,
+    };
+    static constexpr uint32_t kPoseSize = 1 + kNumberOfKeypoints * 3;
+
+    // The number of floats of a result with up to maxNumberOfPoses poses
+    static constexpr uint32_t size(uint32_t maxNumberOfPoses) {
+        return kHeaderSize + maxNumberOfPoses * kPoseSize;
+    }
+};
+
+// Packs the result into a buffer of capacity floats, which must hold all of its poses
+void packPoseEstimationResult(const PoseEstimationResult& result, float* buffer, size_t capacity);
+
 class PoseEstimator {
    public:
     PoseEstimator(PoseEstimationConfig config, AAssetManager* assetManager,
                   const float* textureTransform);
+    ~PoseEstimator();
+
+    // Submits a camera frame to the pipeline.
+    // Returns the result of the oldest frame in flight once the pipeline is full, i.e. the result
+    // of the frame submitted (pipelineDepth - 1) calls earlier; returns std::nullopt while the
+    // pipeline is still filling up. The camera input must stay valid until its result is returned.
+    std::optional<PoseEstimationResult> run(AHardwareBuffer* cameraInput);
 
-    PoseEstimationResult run(AHardwareBuffer* cameraInput);
+    // Submits the camera frame captured at timestampNs to the pipeline only if the frame
+    // scheduler admits it, see PoseEstimationConfig::frameDropPolicy. Otherwise, the frame is
+    // counted as dropped, and the oldest frame in flight is finished instead, so that its result is
+    // not held back until the next frame is submitted.
+    ScheduledRunResult runScheduled(AHardwareBuffer* cameraInput, int64_t timestampNs);
+
+    // Whether the camera frames must be YUV_420_888 images readable by the CPU, rather than
+    // images sampled by the GPU, see PoseEstimationConfig::rawYuvCameraInput. Renderer::AUTO is
+    // resolved by then.
+    bool usesRawYuvCameraInput() const { return mConfig.rawYuvCameraInput; }
+
+    // Replaces the texture transform given to the constructor, e.g. after the display has
+    // rotated, without creating the renderer and compiling the model again. Takes effect from the
+    // next PoseEstimator::run, see RendererBase::setTextureTransform.
+    void setTextureTransform(const float* textureTransform) {
+        mRenderer->setTextureTransform(textureTransform);
+    }
+
+    // Counts the camera frames that were dropped before reaching PoseEstimator::run, e.g. by
+    // ImageReader.acquireLatestImage while the pipeline was busy
+    void recordDroppedFrames(uint32_t count) { mLatencies.recordDroppedFrames(count); }
+
+    // The latency percentiles of every stage over the recent frames, and the processed and dropped
+    // frame counts. Can be called from any thread.
+    PipelineLatencyStats getLatencyStats() const { return mLatencies.getStats(); }
 
    private:
-    // Postprocessing, compute the keypoints from the ML execution results
-    std::vector<Keypoint> computeKeypoints();
+    // The per-frame state of a frame in flight
+    struct FrameSlot {
+        // The intermediate memory between GPU and ML workloads.
+        // This is the output memory of the GPU renderer, as well as the input memory of the ML
+        // executor. We prefer using AHardwareBuffer to avoid redundant memory copying.
+        std::unique_ptr<ManagedBlobAhwb> intermediateMemory;
+
+        float renderLatencyMs = 0.0f;
+        std::chrono::high_resolution_clock::time_point renderFinished;
+        // When the camera frame was submitted to PoseEstimator::run
+        std::chrono::high_resolution_clock::time_point submitted;
+    };
+
+    // Waits for the oldest frame in flight and postprocesses its result
+    PoseEstimationResult finishOldestFrame();
+
+    // Postprocessing, compute the poses from the ML execution results of the given slot
+    std::vector<Pose> computePoses(uint32_t slot);
+
+    // Single-pose postprocessing, pick the keypoint with the highest score for every body part
+    Pose computeSinglePose(uint32_t slot);
 
     PoseEstimationConfig mConfig;
+    FrameScheduler mFrameScheduler;
     std::unique_ptr<RendererBase> mRenderer;
     std::unique_ptr<MlExecutorBase> mMlExecutor;
+    // Only used if mConfig.maxNumberOfPoses > 1
+    std::unique_ptr<MultiPoseDecoder> mMultiPoseDecoder;
+
+    std::vector<FrameSlot> mFrameSlots;
+    // The slot that the next camera frame will be submitted to
+    uint32_t mNextSlot = 0;
+    uint32_t mNumberOfFramesInFlight = 0;
 
-    // The intermediate memory between GPU and ML workloads.
-    // This is the output memory of the GPU renderer, as well as the input memory of the ML
-    // executor. We prefer using AHardwareBuffer to avoid redundant memory copying.
-    std::unique_ptr<ManagedBlobAhwb> mIntermediateMemory = nullptr;
+    PipelineLatencies mLatencies;
 };
 
 }  // namespace pose_estimation
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Trace.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pose_estimation {
+
+#ifdef POSE_ESTIMATION_TRACING
+
+namespace {
+
+// A CLOCK_MONOTONIC time and the CPU counter read at the same moment
+struct ClockSample {
+    uint64_t ticks;
+    int64_t ns;
+};
+
+int64_t monotonicNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+ClockSample sampleClocks() {
+    const int64_t before = monotonicNs();
+    const uint64_t ticks = traceTicks();
+    const int64_t after = monotonicNs();
+    return {.ticks = ticks, .ns = before + (after - before) / 2};
+}
+
+// The ring buffers of all threads that have recorded an event, and the clocks at the first event
+std::mutex gTraceBuffersMutex;
+std::vector<std::unique_ptr<TraceBuffer>> gTraceBuffers;
+ClockSample gFirstClockSample;
+
+// The duration of a tick of traceTicks in nanoseconds. The frequency of the TSC is not exposed,
+// so it is measured against CLOCK_MONOTONIC since the first event.
+double getNsPerTick(const ClockSample& now) {
+#if defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return 1e9 / frequency;
+#elif defined(__x86_64__) || defined(__i386__)
+    if (now.ticks <= gFirstClockSample.ticks) return 1.0;
+    return static_cast<double>(now.ns - gFirstClockSample.ns) /
+           (now.ticks - gFirstClockSample.ticks);
+#else
+    return 1.0;
+#endif
+}
+
+// Escapes a thread name for a JSON string
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+}  // namespace
+
+TraceBuffer* createThreadTraceBuffer() {
+    char threadName[16] = {};
+    pthread_getname_np(pthread_self(), threadName, sizeof(threadName));
+    std::lock_guard<std::mutex> lock(gTraceBuffersMutex);
+    if (gTraceBuffers.empty()) gFirstClockSample = sampleClocks();
+    gTraceBuffers.push_back(std::make_unique<TraceBuffer>(gettid(), threadName));
+    return gTraceBuffers.back().get();
+}
+
+std::string dumpChromeTrace() {
+    const int pid = getpid();
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto append = [&json, &first](const char* event) {
+        if (!first) json += ',';
+        json += event;
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(gTraceBuffersMutex);
+    const ClockSample now = sampleClocks();
+    const double nsPerTick = getNsPerTick(now);
+    auto toNs = [&now, nsPerTick](uint64_t ticks) {
+        return now.ns + static_cast<int64_t>(static_cast<int64_t>(ticks - now.ticks) * nsPerTick);
+    };
+    for (const auto& buffer : gTraceBuffers) {
+        char event[256];
+        snprintf(event, sizeof(event),
+                 "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,"
+                 "\"args\":{\"name\":\"%s\"}}",
+                 pid, buffer->tid(), escapeJson(buffer->threadName()).c_str());
+        append(event);
+        // Complete events, with the timestamps and durations in microseconds
+        buffer->forEachEvent([&](const TraceBuffer::Event& traceEvent) {
+            const int64_t beginNs = toNs(traceEvent.beginTicks);
+            const int64_t durationNs = std::max<int64_t>(toNs(traceEvent.endTicks) - beginNs, 0);
+            snprintf(event, sizeof(event),
+                     "{\"ph\":\"X\",\"name\":\"%s\",\"pid\":%d,\"tid\":%d,\"ts\":%" PRId64
+                     ".%03d,\"dur\":%" PRId64 ".%03d}",
+                     traceEvent.name, pid, buffer->tid(), beginNs / 1000,
+                     static_cast<int>(beginNs % 1000), durationNs / 1000,
+                     static_cast<int>(durationNs % 1000));
+            append(event);
+        });
+    }
+    json += "]}";
+    return json;
+}
+
+bool writeChromeTrace(const std::string& path) {
+    const std::string json = dumpChromeTrace();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(json.data(), json.size());
+    if (!file) {
+        LOGE("Failed to write the trace to %s", path.c_str());
+        return false;
+    }
+    LOGI("Wrote the trace to %s", path.c_str());
+    return true;
+}
+
+#else
+
+std::string dumpChromeTrace() { return "{\"traceEvents\":[]}"; }
+
+bool writeChromeTrace(const std::string& /*path*/) { return false; }
+
+#endif  // POSE_ESTIMATION_TRACING
+
+}  // namespace pose_estimation
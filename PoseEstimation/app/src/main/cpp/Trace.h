@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_TRACE_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_TRACE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "Utils.h"
+
+// A lightweight tracer of the pipeline stages, compiled in with POSE_ESTIMATION_TRACING.
+// TRACE_SCOPE records the time spent in the enclosing scope into a ring buffer of the calling
+// thread. A thread is the only writer of its ring buffer, so recording takes no lock, and the
+// oldest events are overwritten once the buffer is full. The timestamps are read from the CPU
+// counter, which is several times cheaper than clock_gettime, and only converted to CLOCK_MONOTONIC
+// when dumped. The events of all threads can be dumped at any time as Chrome trace JSON, which
+// chrome://tracing and ui.perfetto.dev open. Without POSE_ESTIMATION_TRACING, TRACE_SCOPE compiles
+// to nothing.
+//
+// The name must be a string literal, as only its address is recorded.
+#ifdef POSE_ESTIMATION_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) ::pose_estimation::ScopedTrace TRACE_CONCAT(scopedTrace, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+namespace pose_estimation {
+
+// The number of events kept per thread, i.e. about a hundred frames of the pipeline
+constexpr uint32_t kTraceEventsPerThread = 4096;
+
+constexpr bool isTracingEnabled() {
+#ifdef POSE_ESTIMATION_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Returns the events recorded so far by all threads as Chrome trace JSON, with an empty list of
+// events if tracing is compiled out. May be called on any thread while the pipeline is running.
+std::string dumpChromeTrace();
+
+// Writes dumpChromeTrace to the file at the given path. Returns false if tracing is compiled out
+// or the file cannot be written.
+bool writeChromeTrace(const std::string& path);
+
+#ifdef POSE_ESTIMATION_TRACING
+
+// The ring buffer of the events recorded by a thread
+// The buffer is written by its thread only, and read by dumpChromeTrace on any thread. It is a
+// seqlock: the writer advances mReserved before overwriting an event and mCommitted after, so that
+// the reader can tell which of the events it has copied were overwritten meanwhile.
+class TraceBuffer {
+    DISABLE_COPY_AND_ASSIGN(TraceBuffer);
+
+   public:
+    // The timestamps are in the ticks of traceTicks
+    struct Event {
+        const char* name;
+        uint64_t beginTicks;
+        uint64_t endTicks;
+    };
+
+    TraceBuffer(int32_t tid, std::string threadName)
+        : mTid(tid), mThreadName(std::move(threadName)) {}
+
+    void record(const char* name, uint64_t beginTicks, uint64_t endTicks) {
+        const uint64_t index = mCommitted.load(std::memory_order_relaxed);
+        mReserved.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = mSlots[index % kTraceEventsPerThread];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.beginTicks.store(beginTicks, std::memory_order_relaxed);
+        slot.endTicks.store(endTicks, std::memory_order_relaxed);
+        mCommitted.store(index + 1, std::memory_order_release);
+    }
+
+    // Calls fn on the events that have not been overwritten, from the oldest to the newest
+    template <typename Fn>
+    void forEachEvent(Fn fn) const;
+
+    int32_t tid() const { return mTid; }
+    const std::string& threadName() const { return mThreadName; }
+
+   private:
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> beginTicks{0};
+        std::atomic<uint64_t> endTicks{0};
+    };
+
+    const int32_t mTid;
+    const std::string mThreadName;
+    std::atomic<uint64_t> mReserved{0};
+    std::atomic<uint64_t> mCommitted{0};
+    Slot mSlots[kTraceEventsPerThread];
+};
+
+// Returns the ring buffer of the calling thread, which is created on the first event of the
+// thread and kept for the lifetime of the process, so that it can be dumped after the thread
+// has exited
+TraceBuffer* createThreadTraceBuffer();
+inline TraceBuffer* getThreadTraceBuffer() {
+    static thread_local TraceBuffer* buffer = nullptr;
+    if (buffer == nullptr) buffer = createThreadTraceBuffer();
+    return buffer;
+}
+
+// The CPU counter: the virtual counter of the generic timer on ARM64, the TSC on x86, or else the
+// CLOCK_MONOTONIC time in nanoseconds. dumpChromeTrace converts the ticks to CLOCK_MONOTONIC.
+inline uint64_t traceTicks() {
+#if defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+}
+
+class ScopedTrace {
+    DISABLE_COPY_AND_ASSIGN(ScopedTrace);
+
+   public:
+    explicit ScopedTrace(const char* name) : mName(name), mBeginTicks(traceTicks()) {}
+    ~ScopedTrace() { getThreadTraceBuffer()->record(mName, mBeginTicks, traceTicks()); }
+
+   private:
+    const char* mName;
+    uint64_t mBeginTicks;
+};
+
+template <typename Fn>
+void TraceBuffer::forEachEvent(Fn fn) const {
+    const uint64_t committed = mCommitted.load(std::memory_order_acquire);
+    const uint64_t first = committed > kTraceEventsPerThread ? committed - kTraceEventsPerThread : 0;
+    std::vector<Event> events;
+    events.reserve(committed - first);
+    for (uint64_t i = first; i < committed; i++) {
+        const Slot& slot = mSlots[i % kTraceEventsPerThread];
+        events.push_back({
+                .name = slot.name.load(std::memory_order_relaxed),
+                .beginTicks = slot.beginTicks.load(std::memory_order_relaxed),
+                .endTicks = slot.endTicks.load(std::memory_order_relaxed),
+        });
+    }
+
+    // Drop the events that the writer may have overwritten while they were copied
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t reserved = mReserved.load(std::memory_order_relaxed);
+    const uint64_t firstIntact =
+            reserved > kTraceEventsPerThread ? reserved - kTraceEventsPerThread : 0;
+    for (uint64_t i = std::max(first, firstIntact); i < committed; i++) {
+        fn(events[i - first]);
+    }
+}
+
+#endif  // POSE_ESTIMATION_TRACING
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_TRACE_H
@@ -25,6 +25,8 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <cmath>
+#include <cstring>
 #include <vector>
 
 #define LOG_TAG "DEMO"
@@ -53,6 +55,17 @@ constexpr uint32_t kRendererOutputChannels = 3;
 constexpr uint32_t kRendererOutputSizeBytes =
         kRendererOutputHeight * kRendererOutputWidth * kRendererOutputChannels * sizeof(float);
 
+// The TENSOR_QUANT8_ASYMM renderer output of MlExecutor::NATIVE_NNAPI_QUANT8: the colors in
+// [-1.0, 1.0] quantized with a fixed scale and zero point, see tools/quantize_model.py
+constexpr float kRendererOutputQuant8Scale = 1.0f / 128.0f;
+constexpr int32_t kRendererOutputQuant8ZeroPoint = 128;
+constexpr uint32_t kRendererOutputQuant8SizeBytes =
+        kRendererOutputHeight * kRendererOutputWidth * kRendererOutputChannels;
+
+// The TENSOR_FLOAT16 renderer output of PoseEstimationConfig::float16RendererOutput
+constexpr uint32_t kRendererOutputFloat16SizeBytes =
+        kRendererOutputHeight * kRendererOutputWidth * kRendererOutputChannels * sizeof(uint16_t);
+
 constexpr uint32_t kHeatmapSize = 9;
 constexpr uint32_t kNumberOfKeypoints = 17;
 constexpr uint32_t kNumberOfDisplacements = 32;
@@ -63,6 +76,41 @@ constexpr uint32_t kOutputOffsetsSizeBytes = kOutputOffsetsSize * sizeof(float);
 constexpr uint32_t kOutputDisplacementsSize = kHeatmapSize * kHeatmapSize * kNumberOfDisplacements;
 constexpr uint32_t kOutputDisplacementsSizeBytes = kOutputDisplacementsSize * sizeof(float);
 
+// A TENSOR_QUANT8_ASYMM output, dequantized on access so that the postprocessing only pays for the
+// values it reads. Offsetting the tensor offsets the data like a float pointer.
+struct Quant8Tensor {
+    const uint8_t* data = nullptr;
+    float scale = 0.0f;
+    int32_t zeroPoint = 0;
+
+    float operator[](uint32_t index) const {
+        return scale * (static_cast<int32_t>(data[index]) - zeroPoint);
+    }
+    Quant8Tensor operator+(uint32_t offset) const {
+        return {.data = data + offset, .scale = scale, .zeroPoint = zeroPoint};
+    }
+};
+
+// Converts a float to the bits of the nearest IEEE 754 half-precision value, ties to even. The
+// values beyond the half-precision range become infinities.
+inline uint16_t floatToFloat16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = (bits >> 16) & 0x8000;
+    bits &= 0x7fffffff;
+    if (bits > 0x7f800000) return sign | 0x7e00;   // NaN
+    if (bits >= 0x477ff000) return sign | 0x7c00;  // Infinity, from 65520 on
+    if (bits < 0x38800000) {
+        // Subnormal, in units of 2^-24
+        float magnitude;
+        std::memcpy(&magnitude, &bits, sizeof(magnitude));
+        return sign | static_cast<uint16_t>(std::nearbyint(magnitude * 16777216.0f));
+    }
+    // Rebias the exponent, and round the 13 dropped mantissa bits to even
+    const uint32_t rounded = bits + 0xfff + ((bits >> 13) & 1);
+    return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+}
+
 // RAII wrapper of a file descriptor
 class UniqueFd {
     DISABLE_COPY_AND_ASSIGN(UniqueFd);
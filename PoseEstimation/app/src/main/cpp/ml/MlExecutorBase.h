@@ -19,6 +19,7 @@
 
 #include <android/hardware_buffer.h>
 
+#include <cmath>
 #include <utility>
 
 #include "../PoseEstimationConfig.h"
@@ -26,6 +27,18 @@
 
 namespace pose_estimation {
 
+// The durations of an ML execution as measured by the driver, NaN if not measured.
+// The ML latency not covered by inDriverMs is spent in the runtime, in IPC and in waiting.
+struct MlTiming {
+    // The execution on the accelerator
+    float onHardwareMs = NAN;
+    // The execution in the driver, including the time on the accelerator
+    float inDriverMs = NAN;
+    // Fenced executions only: the same durations, starting when the sync fence has signaled
+    float fencedOnHardwareMs = NAN;
+    float fencedInDriverMs = NAN;
+};
+
 class MlExecutorBase {
     DISABLE_COPY_AND_ASSIGN(MlExecutorBase);
 
@@ -36,20 +49,39 @@ class MlExecutorBase {
     // Get the minimum required size of the memory in bytes for the input image
     virtual uint32_t getRequiredInputMemorySize() const = 0;
 
-    // Must be invoked prior to MlExecutorBase::run
+    // Must be invoked for every slot in [0, mConfig.pipelineDepth) prior to MlExecutorBase::start
     // The size of the memory must be greater than or equal to MlExecutorBase::getInputMemorySize
-    virtual void setInputFromHardwareBuffer(AHardwareBuffer* ahwb) = 0;
+    virtual void setInputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) = 0;
+
+    // Get the address of output tensors of the given slot
+    virtual const float* getOutputHeatmapAddress(uint32_t slot) const = 0;
+    virtual const float* getOutputOffsetsAddress(uint32_t slot) const = 0;
+    virtual const float* getOutputDisplacementsFwdAddress(uint32_t slot) const = 0;
+    virtual const float* getOutputDisplacementsBwdAddress(uint32_t slot) const = 0;
 
-    // Get the address of output tensors
-    virtual const float* getOutputHeatmapAddress() const = 0;
-    virtual const float* getOutputOffsetsAddress() const = 0;
+    // Whether the output tensors are TENSOR_QUANT8_ASYMM, in which case they are read with the
+    // getters below rather than the float ones above
+    virtual bool hasQuant8Outputs() const { return false; }
+    virtual Quant8Tensor getQuant8OutputHeatmap(uint32_t /*slot*/) const { return {}; }
+    virtual Quant8Tensor getQuant8OutputOffsets(uint32_t /*slot*/) const { return {}; }
+    virtual Quant8Tensor getQuant8OutputDisplacementsFwd(uint32_t /*slot*/) const { return {}; }
+    virtual Quant8Tensor getQuant8OutputDisplacementsBwd(uint32_t /*slot*/) const { return {}; }
 
     // Whether the executor is able to wait on an Android sync fence FD or not
     virtual bool supportsAndroidSyncFence() const = 0;
 
+    // Starts the execution on the given slot. The execution may still be running when this method
+    // returns; the outputs of the slot are only valid after MlExecutorBase::wait.
     // If supportsAndroidSyncFence() returns true, syncFenceFd may specify a valid sync fence FD
     // that the execution should wait for; otherwise, syncFenceFd must be invalid
-    virtual void run(UniqueFd syncFenceFd) = 0;
+    virtual void start(uint32_t slot, UniqueFd syncFenceFd) = 0;
+
+    // Blocks until the execution started on the given slot has finished
+    virtual void wait(uint32_t slot) = 0;
+
+    // The timing of the last execution on the given slot. Must be invoked after
+    // MlExecutorBase::wait and before the slot is started again.
+    virtual MlTiming getTiming(uint32_t /*slot*/) { return {}; }
 
    protected:
     PoseEstimationConfig mConfig;
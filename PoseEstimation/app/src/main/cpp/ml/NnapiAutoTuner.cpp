@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NnapiAutoTuner.h"
+
+#include <android/NeuralNetworks.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Utils.h"
+#include "NnapiUtils.h"
+
+namespace pose_estimation {
+namespace {
+
+constexpr uint32_t kFileMagic = 0x55544E4E;  // "NNTU"
+constexpr uint32_t kFileVersion = 1;
+constexpr char kFileName[] = "nnapi_tuning.bin";
+
+struct TuningFile {
+    uint32_t magic;
+    uint32_t version;
+    CompilationCacheToken fingerprint;
+    int32_t preference;
+    uint32_t relaxComputationFloat32toFloat16;
+};
+
+constexpr int32_t kPreferences[] = {
+        ANEURALNETWORKS_PREFER_FAST_SINGLE_ANSWER,
+        ANEURALNETWORKS_PREFER_SUSTAINED_SPEED,
+        ANEURALNETWORKS_PREFER_LOW_POWER,
+};
+
+const char* preferenceToStr(int32_t preference) {
+    switch (preference) {
+        case ANEURALNETWORKS_PREFER_LOW_POWER:
+            return "LOW_POWER";
+        case ANEURALNETWORKS_PREFER_FAST_SINGLE_ANSWER:
+            return "FAST_SINGLE_ANSWER";
+        case ANEURALNETWORKS_PREFER_SUSTAINED_SPEED:
+            return "SUSTAINED_SPEED";
+        default:
+            return "(unknown preference)";
+    }
+}
+
+bool loadSettings(const std::string& path, const CompilationCacheToken& fingerprint,
+                  NnapiCompilationSettings* settings) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        LOGI("No NNAPI tuning result at %s", path.c_str());
+        return false;
+    }
+    TuningFile content;
+    const bool read = fread(&content, sizeof(content), 1, file) == 1 && fgetc(file) == EOF;
+    fclose(file);
+
+    const char* error = nullptr;
+    if (!read) {
+        error = "unexpected file size";
+    } else if (content.magic != kFileMagic || content.version != kFileVersion) {
+        error = "unknown file format";
+    } else if (content.fingerprint != fingerprint) {
+        error = "different model or devices";
+    }
+    if (error != nullptr) {
+        LOGI("Discarding the NNAPI tuning result at %s: %s", path.c_str(), error);
+        return false;
+    }
+    settings->preference = content.preference;
+    settings->relaxComputationFloat32toFloat16 = content.relaxComputationFloat32toFloat16 != 0;
+    return true;
+}
+
+void saveSettings(const std::string& path, const CompilationCacheToken& fingerprint,
+                  const NnapiCompilationSettings& settings) {
+    const TuningFile content = {
+            .magic = kFileMagic,
+            .version = kFileVersion,
+            .fingerprint = fingerprint,
+            .preference = settings.preference,
+            .relaxComputationFloat32toFloat16 = settings.relaxComputationFloat32toFloat16,
+    };
+
+    // Write a temporary file and rename it over the previous one, which is atomic
+    const std::string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        LOGE("Failed to create %s", tempPath.c_str());
+        return;
+    }
+    bool written = fwrite(&content, sizeof(content), 1, file) == 1;
+    written = fflush(file) == 0 && fsync(fileno(file)) == 0 && written;
+    written = fclose(file) == 0 && written;
+    if (!written || rename(tempPath.c_str(), path.c_str()) != 0) {
+        LOGE("Failed to write the NNAPI tuning result to %s", path.c_str());
+        unlink(tempPath.c_str());
+    }
+}
+
+// Compiles the model with the given preference, returns nullptr if the devices cannot compile it
+ANeuralNetworksCompilation* compile(ANeuralNetworksModel* model,
+                                    const std::vector<ANeuralNetworksDevice*>& devices,
+                                    int32_t preference) {
+    ANeuralNetworksCompilation* compilation = nullptr;
+    int result = devices.empty() ? ANeuralNetworksCompilation_create(model, &compilation)
+                                 : ANeuralNetworksCompilation_createForDevices(
+                                           model, devices.data(), devices.size(), &compilation);
+    if (result == ANEURALNETWORKS_NO_ERROR) {
+        result = ANeuralNetworksCompilation_setPreference(compilation, preference);
+    }
+    if (result == ANEURALNETWORKS_NO_ERROR) {
+        result = ANeuralNetworksCompilation_finish(compilation);
+    }
+    if (result != ANEURALNETWORKS_NO_ERROR) {
+        LOGE("NNAPI tuning: failed to compile with %s: %s", preferenceToStr(preference),
+             nnResultToStr(result));
+        ANeuralNetworksCompilation_free(compilation);
+        return nullptr;
+    }
+    return compilation;
+}
+
+// A smooth pattern in [-1, 1] laid out as the renderer output, see kRendererOutputQuant8Scale for
+// the quantized input and floatToFloat16 for the half-precision input
+void fillSyntheticInput(int32_t inputType, void* input) {
+    for (uint32_t y = 0; y < kRendererOutputHeight; y++) {
+        for (uint32_t x = 0; x < kRendererOutputWidth; x++) {
+            for (uint32_t c = 0; c < kRendererOutputChannels; c++) {
+                const uint32_t index = (y * kRendererOutputWidth + x) * kRendererOutputChannels + c;
+                const float value = std::sin(x * 0.05f + c) * std::cos(y * 0.04f - c);
+                if (inputType == ANEURALNETWORKS_TENSOR_QUANT8_ASYMM) {
+                    const float quantized = std::round(value / kRendererOutputQuant8Scale) +
+                                            kRendererOutputQuant8ZeroPoint;
+                    static_cast<uint8_t*>(input)[index] =
+                            static_cast<uint8_t>(std::clamp(quantized, 0.0f, 255.0f));
+                } else if (inputType == ANEURALNETWORKS_TENSOR_FLOAT16) {
+                    static_cast<uint16_t*>(input)[index] = floatToFloat16(value);
+                } else {
+                    static_cast<float*>(input)[index] = value;
+                }
+            }
+        }
+    }
+}
+
+struct VariantResult {
+    // The mean latency of the timed runs
+    float latencyMs;
+    Pose pose;
+};
+
+VariantResult runVariant(const NnapiTuningTarget& target, ANeuralNetworksCompilation* compilation,
+                         const NnapiTuningOptions& options) {
+    // The input must outlive the pool, which frees the NNAPI memory of the input
+    std::unique_ptr<ManagedAshmem> input;
+    uint32_t inputSize = kRendererOutputSizeBytes;
+    if (target.inputType == ANEURALNETWORKS_TENSOR_QUANT8_ASYMM) {
+        inputSize = kRendererOutputQuant8SizeBytes;
+    } else if (target.inputType == ANEURALNETWORKS_TENSOR_FLOAT16) {
+        inputSize = kRendererOutputFloat16SizeBytes;
+    }
+    NnapiExecutionPool pool(compilation, /*numberOfSlots=*/1, inputSize, target.outputSizes,
+                            /*measureTiming=*/false);
+    input = std::make_unique<ManagedAshmem>("tuning_input", pool.getInputMemorySize());
+    fillSyntheticInput(target.inputType, input->data());
+    pool.setInputMemory(0, input->createANeuralNetworksMemory());
+
+    auto runOnce = [&pool] {
+        pool.acquire(0);
+        pool.run(0, UniqueFd());
+        pool.release(0);
+    };
+    for (uint32_t i = 0; i < options.warmupRuns; i++) {
+        runOnce();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < options.timedRuns; i++) {
+        runOnce();
+    }
+    const std::chrono::duration<float, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return {.latencyMs = elapsed.count() / options.timedRuns, .pose = target.decodePose(pool, 0)};
+}
+
+// The mean distance between the keypoints of two poses
+float keypointError(const Pose& pose, const Pose& reference) {
+    float error = 0.0f;
+    for (uint32_t k = 0; k < kNumberOfKeypoints; k++) {
+        error += std::hypot(pose.keypoints[k].x - reference.keypoints[k].x,
+                            pose.keypoints[k].y - reference.keypoints[k].y);
+    }
+    return error / kNumberOfKeypoints;
+}
+
+}  // namespace
+
+NnapiCompilationSettings tuneNnapiCompilation(const NnapiTuningTarget& target,
+                                              const std::string& cacheDir,
+                                              const NnapiTuningOptions& options) {
+    CHECK(target.inputType == ANEURALNETWORKS_TENSOR_FLOAT32 ||
+          target.inputType == ANEURALNETWORKS_TENSOR_FLOAT16 ||
+          target.inputType == ANEURALNETWORKS_TENSOR_QUANT8_ASYMM);
+    CHECK(options.timedRuns > 0);
+    const std::string path = cacheDir.empty() ? "" : cacheDir + "/" + kFileName;
+    NnapiCompilationSettings settings;
+    if (!path.empty() && loadSettings(path, target.fingerprint, &settings)) {
+        LOGI("NNAPI tuning result loaded: %s, relaxed precision %s",
+             preferenceToStr(settings.preference),
+             settings.relaxComputationFloat32toFloat16 ? "on" : "off");
+        return settings;
+    }
+
+    const auto sweepStart = std::chrono::steady_clock::now();
+    std::vector<bool> relaxedValues = {false};
+    if (target.inputType != ANEURALNETWORKS_TENSOR_QUANT8_ASYMM) relaxedValues.push_back(true);
+    std::vector<ANeuralNetworksModel*> models;
+    for (bool relaxed : relaxedValues) models.push_back(target.createModel(relaxed));
+
+    // The fp32 reference
+    std::vector<ANeuralNetworksDevice*> referenceDevices = target.devices;
+    if (target.referenceDevice != nullptr) referenceDevices = {target.referenceDevice};
+    ANeuralNetworksCompilation* referenceCompilation =
+            compile(models[0], referenceDevices, ANEURALNETWORKS_PREFER_FAST_SINGLE_ANSWER);
+    if (referenceCompilation == nullptr) {
+        LOGE("NNAPI tuning: failed to compute the reference, keeping the default settings");
+        for (auto* model : models) ANeuralNetworksModel_free(model);
+        return settings;
+    }
+    const Pose reference =
+            runVariant(target, referenceCompilation,
+                       {.warmupRuns = 0, .timedRuns = 1, .keypointTolerance = 0.0f})
+                    .pose;
+    ANeuralNetworksCompilation_free(referenceCompilation);
+
+    // Without a variant within the tolerance, fall back to full precision
+    settings = {.preference = ANEURALNETWORKS_PREFER_FAST_SINGLE_ANSWER,
+                .relaxComputationFloat32toFloat16 = false};
+    float bestLatencyMs = std::numeric_limits<float>::infinity();
+    for (bool relaxed : relaxedValues) {
+        for (int32_t preference : kPreferences) {
+            ANeuralNetworksCompilation* compilation =
+                    compile(models[relaxed], target.devices, preference);
+            if (compilation == nullptr) continue;
+            const VariantResult result = runVariant(target, compilation, options);
+            ANeuralNetworksCompilation_free(compilation);
+
+            const float error = keypointError(result.pose, reference);
+            const bool accepted = error <= options.keypointTolerance;
+            LOGI("NNAPI tuning: %s, relaxed precision %s: %.2f ms, keypoint error %.4f%s",
+                 preferenceToStr(preference), relaxed ? "on" : "off", result.latencyMs, error,
+                 accepted ? "" : " (rejected)");
+            if (accepted && result.latencyMs < bestLatencyMs) {
+                bestLatencyMs = result.latencyMs;
+                settings = {.preference = preference, .relaxComputationFloat32toFloat16 = relaxed};
+            }
+        }
+    }
+    for (auto* model : models) ANeuralNetworksModel_free(model);
+
+    const std::chrono::duration<float, std::milli> sweepTime =
+            std::chrono::steady_clock::now() - sweepStart;
+    LOGI("NNAPI tuning picked %s, relaxed precision %s, the sweep took %.2f ms",
+         preferenceToStr(settings.preference),
+         settings.relaxComputationFloat32toFloat16 ? "on" : "off", sweepTime.count());
+    if (!path.empty()) saveSettings(path, target.fingerprint, settings);
+    return settings;
+}
+
+}  // namespace pose_estimation
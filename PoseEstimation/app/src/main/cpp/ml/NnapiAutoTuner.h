@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_AUTO_TUNER_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_AUTO_TUNER_H
+
+#include <android/NeuralNetworks.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../MultiPoseDecoder.h"
+#include "NnapiCompilationCache.h"
+#include "NnapiExecutionPool.h"
+
+namespace pose_estimation {
+
+// The compilation settings picked by tuneNnapiCompilation
+struct NnapiCompilationSettings {
+    int32_t preference = ANEURALNETWORKS_PREFER_FAST_SINGLE_ANSWER;
+    bool relaxComputationFloat32toFloat16 = true;
+};
+
+// What tuneNnapiCompilation compiles and how it checks the results
+struct NnapiTuningTarget {
+    // Creates a finished model, which the tuner frees
+    std::function<ANeuralNetworksModel*(bool relaxComputationFloat32toFloat16)> createModel;
+    // The devices to compile for, or empty to let the NNAPI runtime pick
+    std::vector<ANeuralNetworksDevice*> devices;
+    // The device computing the fp32 reference, usually the NNAPI reference CPU device. If
+    // nullptr, the reference is computed on the devices above without relaxed precision.
+    ANeuralNetworksDevice* referenceDevice = nullptr;
+    // The type of the model input laid out as the renderer output, TENSOR_FLOAT32,
+    // TENSOR_FLOAT16 or TENSOR_QUANT8_ASYMM, and the unpadded sizes in bytes of the outputs, see
+    // NnapiExecutionPool
+    int32_t inputType = ANEURALNETWORKS_TENSOR_FLOAT32;
+    std::vector<uint32_t> outputSizes;
+    // Decodes the pose from the outputs of the given slot of the pool
+    std::function<Pose(const NnapiExecutionPool& pool, uint32_t slot)> decodePose;
+    // Identifies the model, the devices and their drivers. The settings are cached per
+    // fingerprint, so that the sweep only runs once.
+    CompilationCacheToken fingerprint;
+};
+
+struct NnapiTuningOptions {
+    // The runs of every variant before and while it is timed
+    uint32_t warmupRuns = 2;
+    uint32_t timedRuns = 3;
+    // The maximum mean distance in normalized coordinates between the keypoints of a variant and
+    // those of the fp32 reference
+    float keypointTolerance = 0.02f;
+};
+
+// Picks the fastest NNAPI compilation settings for the target.
+//
+// The model is compiled with every execution preference, with and without relaxed fp16 precision,
+// and every variant is timed on a synthetic input after a few warm-up runs. The fastest variant
+// whose keypoints stay within the tolerance of the fp32 reference wins. The synthetic input is a
+// smooth pattern rather than a photo, so the error is only a coarse check of the precision.
+// Relaxed precision only applies to float operations, so a quantized model is only swept without.
+//
+// The settings are cached in cacheDir, the sweep is skipped if the cached fingerprint matches. If
+// cacheDir is empty, the sweep runs on every call.
+NnapiCompilationSettings tuneNnapiCompilation(const NnapiTuningTarget& target,
+                                              const std::string& cacheDir,
+                                              const NnapiTuningOptions& options = {});
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_AUTO_TUNER_H
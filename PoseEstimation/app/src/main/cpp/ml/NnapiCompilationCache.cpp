@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NnapiCompilationCache.h"
+
+#include <android/NeuralNetworks.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "NnapiUtils.h"
+
+namespace pose_estimation {
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+
+uint64_t rotateLeft(uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+
+uint64_t readUint64(const uint8_t* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint64_t mixLane(uint64_t lane, uint64_t value) {
+    lane += value * kPrime2;
+    lane = rotateLeft(lane, 31);
+    return lane * kPrime1;
+}
+
+uint64_t avalanche(uint64_t value) {
+    value ^= value >> 33;
+    value *= kPrime2;
+    value ^= value >> 29;
+    value *= kPrime3;
+    value ^= value >> 32;
+    return value;
+}
+
+}  // namespace
+
+CompilationCacheTokenBuilder::CompilationCacheTokenBuilder() {
+    for (size_t i = 0; i < kNumberOfLanes; i++) {
+        mLanes[i] = kPrime1 * (i + 1) + kPrime3;
+    }
+}
+
+void CompilationCacheTokenBuilder::consumeStripe(const uint8_t* stripe) {
+    for (size_t i = 0; i < kNumberOfLanes; i++) {
+        mLanes[i] = mixLane(mLanes[i], readUint64(stripe + i * sizeof(uint64_t)));
+    }
+}
+
+void CompilationCacheTokenBuilder::update(const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    mTotalSize += size;
+
+    // Complete the stripe left over from the previous update
+    if (mPendingSize > 0) {
+        const size_t n = std::min(size, kStripeSize - mPendingSize);
+        std::memcpy(mPending.data() + mPendingSize, bytes, n);
+        mPendingSize += n;
+        bytes += n;
+        size -= n;
+        if (mPendingSize < kStripeSize) return;
+        consumeStripe(mPending.data());
+        mPendingSize = 0;
+    }
+
+    for (; size >= kStripeSize; bytes += kStripeSize, size -= kStripeSize) {
+        consumeStripe(bytes);
+    }
+    std::memcpy(mPending.data(), bytes, size);
+    mPendingSize = size;
+}
+
+CompilationCacheToken CompilationCacheTokenBuilder::finish() const {
+    // Fold the tail and the total size into a copy of the lanes, so that the builder can still be
+    // updated after a token has been taken
+    auto lanes = mLanes;
+    std::array<uint8_t, kStripeSize> tail = {};
+    std::memcpy(tail.data(), mPending.data(), mPendingSize);
+    for (size_t i = 0; i < kNumberOfLanes; i++) {
+        lanes[i] = mixLane(lanes[i], readUint64(tail.data() + i * sizeof(uint64_t)));
+        lanes[i] = mixLane(lanes[i], mTotalSize);
+    }
+
+    // Every byte of the token depends on every lane
+    uint64_t combined = 0;
+    for (uint64_t lane : lanes) combined = mixLane(combined, lane);
+
+    CompilationCacheToken token;
+    static_assert(sizeof(token) == kNumberOfLanes * sizeof(uint64_t));
+    for (size_t i = 0; i < kNumberOfLanes; i++) {
+        const uint64_t value = avalanche(lanes[i] ^ rotateLeft(combined, 8 * i + 1));
+        std::memcpy(token.data() + i * sizeof(uint64_t), &value, sizeof(value));
+    }
+    return token;
+}
+
+NnapiCompilationCache::NnapiCompilationCache(std::string cacheDir,
+                                             const CompilationCacheToken& token)
+    : mCacheDir(std::move(cacheDir)), mToken(token) {
+    std::string tokenHex;
+    for (uint8_t byte : mToken) {
+        char hex[3];
+        snprintf(hex, sizeof(hex), "%02x", byte);
+        tokenHex += hex;
+    }
+    mMarkerPath = mCacheDir + "/" + tokenHex + ".compiled";
+    mHit = access(mMarkerPath.c_str(), F_OK) == 0;
+}
+
+void NnapiCompilationCache::setCaching(ANeuralNetworksCompilation* compilation) const {
+    CALL_NN(ANeuralNetworksCompilation_setCaching, compilation, mCacheDir.c_str(), mToken.data());
+}
+
+void NnapiCompilationCache::markCompiled() {
+    if (mHit) return;
+    FILE* marker = fopen(mMarkerPath.c_str(), "w");
+    if (marker == nullptr) {
+        LOGE("Failed to create the compilation cache marker %s", mMarkerPath.c_str());
+        return;
+    }
+    fclose(marker);
+}
+
+}  // namespace pose_estimation
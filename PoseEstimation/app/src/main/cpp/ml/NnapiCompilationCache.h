@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_COMPILATION_CACHE_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_COMPILATION_CACHE_H
+
+#include <android/NeuralNetworks.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "../Utils.h"
+
+namespace pose_estimation {
+
+using CompilationCacheToken = std::array<uint8_t, ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN>;
+
+// Computes the token identifying a compilation in the NNAPI compilation cache.
+//
+// The token must change whenever anything that affects the compiled model changes, i.e. the model
+// data, the graph structure and the compilation settings. The NNAPI runtime and drivers take care
+// of their own versions. The hash is not cryptographic: it only needs to be fast enough to digest
+// the whole model data on every launch and to make accidental collisions unlikely.
+class CompilationCacheTokenBuilder {
+   public:
+    CompilationCacheTokenBuilder();
+
+    void update(const void* data, size_t size);
+
+    template <typename T>
+    void update(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        update(&value, sizeof(value));
+    }
+
+    void update(const std::string& value) { update(value.data(), value.size()); }
+
+    CompilationCacheToken finish() const;
+
+   private:
+    static constexpr size_t kNumberOfLanes = 4;
+    static constexpr size_t kStripeSize = kNumberOfLanes * sizeof(uint64_t);
+
+    void consumeStripe(const uint8_t* stripe);
+
+    std::array<uint64_t, kNumberOfLanes> mLanes;
+    std::array<uint8_t, kStripeSize> mPending;
+    size_t mPendingSize = 0;
+    uint64_t mTotalSize = 0;
+};
+
+// A compilation cache in an app-private directory.
+//
+// NNAPI does not tell whether ANeuralNetworksCompilation_finish has been served from the cache, so
+// a marker file is written next to the cache files once a compilation with the token has finished.
+// A compilation is reported as a cache hit if the marker exists before it starts. The driver may
+// still decline to use the cache, which shows up as a long compilation time despite the hit.
+class NnapiCompilationCache {
+    DISABLE_COPY_AND_ASSIGN(NnapiCompilationCache);
+
+   public:
+    NnapiCompilationCache(std::string cacheDir, const CompilationCacheToken& token);
+
+    // Whether a compilation with the same token has finished before
+    bool isHit() const { return mHit; }
+
+    // Must be invoked prior to ANeuralNetworksCompilation_finish
+    void setCaching(ANeuralNetworksCompilation* compilation) const;
+
+    // Must be invoked after ANeuralNetworksCompilation_finish has succeeded
+    void markCompiled();
+
+   private:
+    std::string mCacheDir;
+    CompilationCacheToken mToken;
+    std::string mMarkerPath;
+    bool mHit = false;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_COMPILATION_CACHE_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NnapiDevices.h"
+
+#include <android/NeuralNetworks.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Utils.h"
+#include "NnapiUtils.h"
+
+namespace pose_estimation {
+
+std::vector<NnapiDevice> getNnapiDevices() {
+    uint32_t deviceCount = 0;
+    CALL_NN(ANeuralNetworks_getDeviceCount, &deviceCount);
+    std::vector<NnapiDevice> devices(deviceCount);
+    for (uint32_t i = 0; i < deviceCount; i++) {
+        auto& device = devices[i];
+        const char* name = nullptr;
+        const char* version = nullptr;
+        CALL_NN(ANeuralNetworks_getDevice, i, &device.handle);
+        CALL_NN(ANeuralNetworksDevice_getName, device.handle, &name);
+        CALL_NN(ANeuralNetworksDevice_getType, device.handle, &device.type);
+        CALL_NN(ANeuralNetworksDevice_getVersion, device.handle, &version);
+        CALL_NN(ANeuralNetworksDevice_getFeatureLevel, device.handle, &device.featureLevel);
+        device.name = name;
+        device.version = version;
+    }
+    return devices;
+}
+
+NnapiOperationSupport::NnapiOperationSupport(const ANeuralNetworksModel* model,
+                                             std::vector<int32_t> operationTypes,
+                                             std::vector<NnapiDevice> devices)
+    : mOperationTypes(std::move(operationTypes)), mDevices(std::move(devices)) {
+    // std::vector<bool> is not an array of bool
+    const uint32_t operationCount = mOperationTypes.size();
+    std::unique_ptr<bool[]> supportedOps(new bool[operationCount]);
+    mSupported.reserve(mDevices.size());
+    for (const auto& device : mDevices) {
+        const ANeuralNetworksDevice* handle = device.handle;
+        CALL_NN(ANeuralNetworksModel_getSupportedOperationsForDevices, model, &handle, 1u,
+                supportedOps.get());
+        mSupported.emplace_back(supportedOps.get(), supportedOps.get() + operationCount);
+    }
+}
+
+int NnapiOperationSupport::findDevice(const std::string& name) const {
+    for (uint32_t i = 0; i < mDevices.size(); i++) {
+        if (mDevices[i].name == name) return i;
+    }
+    return -1;
+}
+
+std::vector<uint32_t> NnapiOperationSupport::getUnsupportedOperations(
+        const std::vector<uint32_t>& deviceIndexes) const {
+    std::vector<uint32_t> unsupported;
+    for (uint32_t op = 0; op < mOperationTypes.size(); op++) {
+        bool supported = false;
+        for (uint32_t device : deviceIndexes) {
+            CHECK(device < mDevices.size());
+            supported = supported || mSupported[device][op];
+        }
+        if (!supported) unsupported.push_back(op);
+    }
+    return unsupported;
+}
+
+std::string NnapiOperationSupport::describeOperation(uint32_t operation) const {
+    CHECK(operation < mOperationTypes.size());
+    return "#" + std::to_string(operation) + " " + nnOperationToStr(mOperationTypes[operation]);
+}
+
+void NnapiOperationSupport::log() const {
+    for (uint32_t i = 0; i < mDevices.size(); i++) {
+        const auto& device = mDevices[i];
+        LOGI("NNAPI device %u: %s, type %s, version %s, feature level %lld", i,
+             device.name.c_str(), nnDeviceTypeToStr(device.type), device.version.c_str(),
+             static_cast<long long>(device.featureLevel));
+    }
+    for (uint32_t op = 0; op < mOperationTypes.size(); op++) {
+        std::string supportedBy;
+        for (uint32_t i = 0; i < mDevices.size(); i++) {
+            if (!mSupported[i][op]) continue;
+            if (!supportedBy.empty()) supportedBy += ", ";
+            supportedBy += mDevices[i].name;
+        }
+        LOGI("NNAPI operation %s is supported by: %s", describeOperation(op).c_str(),
+             supportedBy.empty() ? "(none)" : supportedBy.c_str());
+    }
+}
+
+}  // namespace pose_estimation
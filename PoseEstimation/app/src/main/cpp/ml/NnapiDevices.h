@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_DEVICES_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_DEVICES_H
+
+#include <android/NeuralNetworks.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pose_estimation {
+
+// An NNAPI device, as enumerated by ANeuralNetworks_getDevice
+struct NnapiDevice {
+    ANeuralNetworksDevice* handle;
+    std::string name;
+    int32_t type;
+    std::string version;
+    int64_t featureLevel;
+};
+
+// Enumerates the NNAPI devices available on the system
+std::vector<NnapiDevice> getNnapiDevices();
+
+// Which NNAPI devices support which operations of a model.
+//
+// The support of every device is queried on its own with
+// ANeuralNetworksModel_getSupportedOperationsForDevices, so that the report shows the operations
+// that a set of devices would leave to the others, e.g. a CONV_2D layer falling back to the CPU.
+// The devices are referred to by their index in devices().
+class NnapiOperationSupport {
+   public:
+    // The model must be finished. operationTypes are the types of its operations, in the order
+    // they were added to the model.
+    NnapiOperationSupport(const ANeuralNetworksModel* model, std::vector<int32_t> operationTypes,
+                          std::vector<NnapiDevice> devices);
+
+    const std::vector<NnapiDevice>& devices() const { return mDevices; }
+
+    // The index of the device with the given name, or -1 if there is none
+    int findDevice(const std::string& name) const;
+
+    // The operations that none of the given devices supports
+    std::vector<uint32_t> getUnsupportedOperations(const std::vector<uint32_t>& deviceIndexes) const;
+
+    // Logs the devices and, for every operation, the devices supporting it
+    void log() const;
+
+    // The description of an operation for the logs, e.g. "#3 CONV_2D"
+    std::string describeOperation(uint32_t operation) const;
+
+   private:
+    std::vector<int32_t> mOperationTypes;
+    std::vector<NnapiDevice> mDevices;
+    // mSupported[device][operation]
+    std::vector<std::vector<bool>> mSupported;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_DEVICES_H
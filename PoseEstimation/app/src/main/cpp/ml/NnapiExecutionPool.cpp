@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NnapiExecutionPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../NdkFunctions.h"
+#include "../Trace.h"
+#include "NnapiUtils.h"
+
+namespace pose_estimation {
+
+NnapiExecutionPool::NnapiExecutionPool(ANeuralNetworksCompilation* compilation,
+                                       uint32_t numberOfSlots, uint32_t inputSize,
+                                       const std::vector<uint32_t>& outputSizes,
+                                       bool measureTiming)
+    : mCompilation(compilation), mMeasureTiming(measureTiming) {
+    CHECK(mCompilation != nullptr);
+    CHECK(numberOfSlots > 0);
+
+    // Plan the execution memory layout once, it is the same for all slots
+    layoutExecutionMemory(inputSize, outputSizes);
+
+    mSlots.resize(numberOfSlots);
+    for (auto& slot : mSlots) {
+        // Allocate the memory for execution outputs
+        slot.outputMemory = std::make_unique<ManagedAshmem>("execution_outputs", mOutputMemorySize);
+        slot.output = slot.outputMemory->createANeuralNetworksMemory();
+        CHECK(slot.outputMemory->data() != nullptr);
+
+        // The NNAPI burst execution is designed to reduce the overhead and improve the performance
+        // of a rapid sequence of executions. Although NNAPI burst execution is introduced in NNAPI
+        // feature level 3, we recommend to use NNAPI burst execution starting from NNAPI feature
+        // level 5 to get the best performance. At NNAPI feature level 4 or earlier, synchronous
+        // execution is recommended.
+        // A burst object cannot be used by two computations at the same time, so every slot gets
+        // its own.
+        if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
+            CALL_NN(ANeuralNetworksBurst_create, mCompilation, &slot.burst);
+        }
+    }
+}
+
+NnapiExecutionPool::~NnapiExecutionPool() {
+    // Finish the computations in flight and stop the burst workers
+    for (uint32_t i = 0; i < mSlots.size(); i++) {
+        wait(i);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mCondition.notify_all();
+
+    for (auto& slot : mSlots) {
+        if (slot.burstWorker.joinable()) {
+            slot.burstWorker.join();
+        }
+        ANeuralNetworksExecution_free(slot.execution);
+        ANeuralNetworksBurst_free(slot.burst);
+        ANeuralNetworksMemory_free(slot.input);
+        ANeuralNetworksMemory_free(slot.output);
+    }
+}
+
+void NnapiExecutionPool::layoutExecutionMemory(uint32_t inputSize,
+                                               const std::vector<uint32_t>& outputSizes) {
+    // Every slot has two memory pools: one for the input image, one to bundle all output memories.
+    // NNAPI supports querying the preferred memory alignment and padding since NNAPI feature level
+    // 5. To get the best performance, we will make sure the input and output memories satisfy the
+    // given memory preference.
+
+    // Layout execution input
+    // We only have one input and the alignment will always be satisfied with offset = 0,
+    // so we only query the padding here.
+    uint32_t inputPadding = 1;
+    if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
+        CALL_NN(NdkFunctions::get().ANeuralNetworksCompilation_getPreferredMemoryPaddingForInput,
+                mCompilation, /*index=*/0, &inputPadding);
+    }
+    // The renderers write whole 32-bit words, which matters for the quantized and fp16 inputs
+    mInputMemorySize = roundUp(inputSize, std::max<uint32_t>(inputPadding, sizeof(uint32_t)));
+
+    // Layout execution output
+    uint32_t outputOffset = 0;
+    mOutputLayouts.resize(outputSizes.size());
+    for (uint32_t i = 0; i < outputSizes.size(); i++) {
+        // Query the preferred output alignment and padding
+        uint32_t alignment = sizeof(float);
+        uint32_t padding = 1;
+        if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
+            CALL_NN(NdkFunctions::get()
+                            .ANeuralNetworksCompilation_getPreferredMemoryAlignmentForOutput,
+                    mCompilation, i, &alignment);
+            CALL_NN(NdkFunctions::get()
+                            .ANeuralNetworksCompilation_getPreferredMemoryPaddingForOutput,
+                    mCompilation, i, &padding);
+        }
+
+        // Build the output memory with preferred alignment and padding
+        outputOffset = roundUp(outputOffset, alignment);
+        mOutputLayouts[i].offset = outputOffset;
+        mOutputLayouts[i].paddedLength = roundUp(outputSizes[i], padding);
+        outputOffset += mOutputLayouts[i].paddedLength;
+    }
+    mOutputMemorySize = outputOffset;
+}
+
+void NnapiExecutionPool::setInputMemory(uint32_t slot, ANeuralNetworksMemory* memory) {
+    CHECK(slot < mSlots.size());
+    CHECK(mSlots[slot].input == nullptr);
+    mSlots[slot].input = memory;
+}
+
+const uint8_t* NnapiExecutionPool::getOutputBytes(uint32_t slot, uint32_t outputIndex) const {
+    CHECK(slot < mSlots.size());
+    CHECK(outputIndex < mOutputLayouts.size());
+    const auto* outputData = static_cast<const uint8_t*>(mSlots[slot].outputMemory->data());
+    return outputData + mOutputLayouts[outputIndex].offset;
+}
+
+uint32_t NnapiExecutionPool::acquire() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        for (uint32_t i = 0; i < mSlots.size(); i++) {
+            if (!mSlots[i].acquired) {
+                mSlots[i].acquired = true;
+                return i;
+            }
+        }
+        mCondition.wait(lock);
+    }
+}
+
+void NnapiExecutionPool::acquire(uint32_t slot) {
+    CHECK(slot < mSlots.size());
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this, slot] { return !mSlots[slot].acquired; });
+    mSlots[slot].acquired = true;
+}
+
+void NnapiExecutionPool::release(uint32_t slot) {
+    CHECK(slot < mSlots.size());
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        CHECK(mSlots[slot].acquired);
+        CHECK(mSlots[slot].finished == nullptr && !mSlots[slot].burstPending);
+        mSlots[slot].acquired = false;
+    }
+    mCondition.notify_all();
+}
+
+void NnapiExecutionPool::createAndSetupExecution(Slot* slot) {
+    ANeuralNetworksExecution_free(slot->execution);
+    CALL_NN(ANeuralNetworksExecution_create, mCompilation, &slot->execution);
+
+    // Enable reusable execution and memory padding if supported
+    // We can only use reusable execution and padded memories when the features are enabled on the
+    // execution object.
+    if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
+        CALL_NN(NdkFunctions::get().ANeuralNetworksExecution_setReusable, slot->execution,
+                /*reusable=*/true);
+        CALL_NN(NdkFunctions::get().ANeuralNetworksExecution_enableInputAndOutputPadding,
+                slot->execution, /*enable=*/true);
+    }
+
+    // Timing measurement must be enabled before the execution is computed
+    if (mMeasureTiming) {
+        CALL_NN(ANeuralNetworksExecution_setMeasureTiming, slot->execution, /*measure=*/true);
+    }
+
+    // Input memory
+    CHECK(slot->input != nullptr);
+    CALL_NN(ANeuralNetworksExecution_setInputFromMemory, slot->execution, /*index=*/0,
+            /*type=*/nullptr, slot->input, /*offset=*/0, mInputMemorySize);
+
+    // Output memories
+    for (uint32_t i = 0; i < mOutputLayouts.size(); i++) {
+        const auto& layout = mOutputLayouts[i];
+        CALL_NN(ANeuralNetworksExecution_setOutputFromMemory, slot->execution, i,
+                /*type=*/nullptr, slot->output, layout.offset, layout.paddedLength);
+    }
+}
+
+void NnapiExecutionPool::runAsync(uint32_t slotIndex, UniqueFd syncFenceFd) {
+    CHECK(slotIndex < mSlots.size());
+    Slot& slot = mSlots[slotIndex];
+    CHECK(slot.acquired);
+    CHECK(slot.finished == nullptr && !slot.burstPending);
+
+    // All input and output memories bindings of a slot are fixed, so we could benefit from NNAPI
+    // reusable execution that is supported since NNAPI feature level 5.
+    // If NNAPI reusable execution is supported, we create and setup the execution only in the first
+    // run of each slot and reuse it in subsequent runs. Otherwise, we need to create and setup the
+    // execution in every run.
+    if (NdkFunctions::nnapiFeatureLevel() < ANEURALNETWORKS_FEATURE_LEVEL_5 ||
+        slot.execution == nullptr) {
+        createAndSetupExecution(&slot);
+    }
+
+    // Attempt fenced execution if a valid syncFenceFd is supplied.
+    slot.fenced = syncFenceFd.ok();
+    if (syncFenceFd.ok()) {
+        TRACE_SCOPE("ANeuralNetworksExecution_startComputeWithDependencies");
+        CALL_NN(NdkFunctions::get().ANeuralNetworksEvent_createFromSyncFenceFd, syncFenceFd.get(),
+                &slot.dependency);
+        CALL_NN(NdkFunctions::get().ANeuralNetworksExecution_startComputeWithDependencies,
+                slot.execution, &slot.dependency, 1u, /*infinite timeout*/ 0, &slot.finished);
+        return;
+    }
+
+    // We may reach this point if either:
+    // - exporting sync fence is not supported by the GPU renderer
+    // - the GPU rendering has already finished prior to exporting the fence
+    // - the device is at NNAPI feature level 4 or earlier, where the fenced execution is not
+    //   recommended
+    // Attempt burst compute if available. The burst computation blocks, so it runs on the worker
+    // thread of the slot, which is started on first use.
+    if (slot.burst != nullptr) {
+        if (!slot.burstWorker.joinable()) {
+            slot.burstWorker = std::thread(&NnapiExecutionPool::burstWorkerLoop, this, &slot);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            slot.burstPending = true;
+        }
+        mCondition.notify_all();
+        return;
+    }
+
+    // Otherwise, start an asynchronous computation
+    CALL_NN(ANeuralNetworksExecution_startCompute, slot.execution, &slot.finished);
+}
+
+void NnapiExecutionPool::run(uint32_t slotIndex, UniqueFd syncFenceFd) {
+    CHECK(slotIndex < mSlots.size());
+    Slot& slot = mSlots[slotIndex];
+
+    // Burst and synchronous computations can run on the calling thread directly
+    if (!syncFenceFd.ok()) {
+        CHECK(slot.acquired);
+        CHECK(slot.finished == nullptr && !slot.burstPending);
+        if (NdkFunctions::nnapiFeatureLevel() < ANEURALNETWORKS_FEATURE_LEVEL_5 ||
+            slot.execution == nullptr) {
+            createAndSetupExecution(&slot);
+        }
+        slot.fenced = false;
+        if (slot.burst != nullptr) {
+            TRACE_SCOPE("ANeuralNetworksExecution_burstCompute");
+            CALL_NN(ANeuralNetworksExecution_burstCompute, slot.execution, slot.burst);
+        } else {
+            TRACE_SCOPE("ANeuralNetworksExecution_compute");
+            CALL_NN(ANeuralNetworksExecution_compute, slot.execution);
+        }
+        return;
+    }
+
+    runAsync(slotIndex, std::move(syncFenceFd));
+    wait(slotIndex);
+}
+
+void NnapiExecutionPool::wait(uint32_t slotIndex) {
+    CHECK(slotIndex < mSlots.size());
+    Slot& slot = mSlots[slotIndex];
+
+    if (slot.finished != nullptr) {
+        TRACE_SCOPE("ANeuralNetworksEvent_wait");
+        CALL_NN(ANeuralNetworksEvent_wait, slot.finished);
+        ANeuralNetworksEvent_free(slot.finished);
+        ANeuralNetworksEvent_free(slot.dependency);
+        slot.finished = nullptr;
+        slot.dependency = nullptr;
+    }
+
+    TRACE_SCOPE("NnapiExecutionPool wait for burst worker");
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [&slot] { return !slot.burstPending; });
+}
+
+namespace {
+
+// Returns NaN if the driver has not measured the duration
+float getDurationMs(const ANeuralNetworksExecution* execution, int32_t durationCode) {
+    uint64_t durationNs = UINT64_MAX;
+    CALL_NN(ANeuralNetworksExecution_getDuration, execution, durationCode, &durationNs);
+    return durationNs == UINT64_MAX ? NAN : durationNs / 1000'000.0f;
+}
+
+}  // namespace
+
+MlTiming NnapiExecutionPool::getTiming(uint32_t slotIndex) const {
+    CHECK(slotIndex < mSlots.size());
+    const Slot& slot = mSlots[slotIndex];
+    if (!mMeasureTiming || slot.execution == nullptr) return {};
+
+    MlTiming timing = {
+            .onHardwareMs = getDurationMs(slot.execution, ANEURALNETWORKS_DURATION_ON_HARDWARE),
+            .inDriverMs = getDurationMs(slot.execution, ANEURALNETWORKS_DURATION_IN_DRIVER),
+    };
+    if (slot.fenced) {
+        timing.fencedOnHardwareMs =
+                getDurationMs(slot.execution, ANEURALNETWORKS_FENCED_DURATION_ON_HARDWARE);
+        timing.fencedInDriverMs =
+                getDurationMs(slot.execution, ANEURALNETWORKS_FENCED_DURATION_IN_DRIVER);
+    }
+    return timing;
+}
+
+void NnapiExecutionPool::burstWorkerLoop(Slot* slot) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mCondition.wait(lock, [this, slot] { return slot->burstPending || mStopping; });
+        if (!slot->burstPending) return;
+
+        lock.unlock();
+        {
+            TRACE_SCOPE("ANeuralNetworksExecution_burstCompute");
+            CALL_NN(ANeuralNetworksExecution_burstCompute, slot->execution, slot->burst);
+        }
+        lock.lock();
+
+        slot->burstPending = false;
+        mCondition.notify_all();
+    }
+}
+
+}  // namespace pose_estimation
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_EXECUTION_POOL_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_EXECUTION_POOL_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../Utils.h"
+#include "MlExecutorBase.h"
+#include "NnapiUtils.h"
+
+namespace pose_estimation {
+
+// A fixed-size pool of NNAPI executions sharing one compilation.
+//
+// Each slot owns a reusable ANeuralNetworksExecution, a burst object and the ashmem holding its
+// outputs, so several frames or camera streams can be inferred at the same time without setting
+// up a new execution for every run. A typical use is:
+//   slot = pool.acquire();  // or pool.acquire(slot) to pick a specific slot
+//   pool.runAsync(slot, std::move(syncFenceFd));
+//   ... do other work ...
+//   pool.wait(slot);
+//   ... read pool.getOutputAddress(slot, i) ...
+//   pool.release(slot);
+//
+// acquire, wait and release are thread-safe. runAsync and run may only be called by the owner of
+// the slot, i.e. between acquire and release.
+class NnapiExecutionPool {
+    DISABLE_COPY_AND_ASSIGN(NnapiExecutionPool);
+
+   public:
+    // The compilation must outlive the pool
+    // inputSize and outputSizes are the unpadded sizes in bytes of the model input and outputs
+    // measureTiming requires a compilation created for a single device, see
+    // ANeuralNetworksExecution_setMeasureTiming
+    NnapiExecutionPool(ANeuralNetworksCompilation* compilation, uint32_t numberOfSlots,
+                       uint32_t inputSize, const std::vector<uint32_t>& outputSizes,
+                       bool measureTiming);
+    ~NnapiExecutionPool();
+
+    uint32_t size() const { return mSlots.size(); }
+
+    // The size in bytes of the input memory, padded to the preference of the compilation
+    uint32_t getInputMemorySize() const { return mInputMemorySize; }
+
+    // Takes the ownership of the memory, which will be the input of every execution on the slot
+    // Must be invoked for every slot prior to the first run
+    void setInputMemory(uint32_t slot, ANeuralNetworksMemory* memory);
+
+    // The address of the output at the given index, valid until the slot is run again
+    const float* getOutputAddress(uint32_t slot, uint32_t outputIndex) const {
+        return reinterpret_cast<const float*>(getOutputBytes(slot, outputIndex));
+    }
+    const uint8_t* getOutputBytes(uint32_t slot, uint32_t outputIndex) const;
+
+    // Blocks until a slot is available and returns the acquired slot
+    uint32_t acquire();
+
+    // Blocks until the given slot is available and acquires it
+    void acquire(uint32_t slot);
+
+    // Releases an acquired slot. Any computation started on the slot must have been waited for.
+    void release(uint32_t slot);
+
+    // Starts the computation on an acquired slot and returns without waiting for it to finish.
+    // If syncFenceFd is valid, the computation will wait for the sync fence to be signaled.
+    void runAsync(uint32_t slot, UniqueFd syncFenceFd);
+
+    // Computes on an acquired slot and blocks until the computation has finished.
+    // This avoids handing the burst computation over to the worker thread of the slot.
+    void run(uint32_t slot, UniqueFd syncFenceFd);
+
+    // Blocks until the computation started on the slot has finished
+    void wait(uint32_t slot);
+
+    // The durations of the last computation on the slot, all NaN if the timing is not measured.
+    // Must be invoked after wait and before the slot is run again.
+    MlTiming getTiming(uint32_t slot) const;
+
+   private:
+    struct OutputLayout {
+        uint32_t offset;
+        uint32_t paddedLength;
+    };
+
+    struct Slot {
+        ANeuralNetworksExecution* execution = nullptr;
+        ANeuralNetworksBurst* burst = nullptr;
+        ANeuralNetworksMemory* input = nullptr;
+        std::unique_ptr<ManagedMemory> outputMemory;
+        ANeuralNetworksMemory* output = nullptr;
+        bool acquired = false;
+
+        // Events of a fenced or asynchronous computation
+        ANeuralNetworksEvent* dependency = nullptr;
+        ANeuralNetworksEvent* finished = nullptr;
+        // Whether the last computation waited for a sync fence, only fenced computations report
+        // the fenced durations
+        bool fenced = false;
+
+        // Burst computations are synchronous, so runAsync hands them over to a worker thread
+        std::thread burstWorker;
+        bool burstPending = false;
+    };
+
+    void layoutExecutionMemory(uint32_t inputSize, const std::vector<uint32_t>& outputSizes);
+    void createAndSetupExecution(Slot* slot);
+    void burstWorkerLoop(Slot* slot);
+
+    ANeuralNetworksCompilation* mCompilation = nullptr;
+    bool mMeasureTiming = false;
+
+    // Memory layout shared by all slots
+    uint32_t mInputMemorySize = 0;
+    std::vector<OutputLayout> mOutputLayouts;
+    uint32_t mOutputMemorySize = 0;
+
+    std::vector<Slot> mSlots;
+
+    // Guards the acquired and burstPending states of the slots
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopping = false;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_EXECUTION_POOL_H
@@ -19,14 +19,24 @@
 #include <android/asset_manager_jni.h>
 #include <android/hardware_buffer.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "../MultiPoseDecoder.h"
 #include "../NdkFunctions.h"
+#include "../Trace.h"
 #include "MlExecutorBase.h"
+#include "NnapiAutoTuner.h"
+#include "NnapiCompilationCache.h"
+#include "NnapiDevices.h"
+#include "NnapiModelGraph.h"
 #include "NnapiUtils.h"
 
 namespace pose_estimation {
@@ -34,204 +44,373 @@ namespace {
 
 // Create ANeuralNetworksMemory from an asset file.
 //
-// Note that, at NNAPI feature level 4 (API level 30) or earlier, the NNAPI drivers may not have the
-// permission to access the asset file. To work around this issue, here we will:
+// Starting from NNAPI feature level 5 (API level 31), the NNAPI memory is created directly from the
+// file descriptor of the APK at the offset of the asset, so the model data is mapped rather than
+// copied. This requires the asset to be stored uncompressed (see noCompress in build.gradle). The
+// NNAPI memory must start at a page-aligned file offset, but the build only aligns uncompressed
+// assets to 4 bytes, so the memory starts at the page boundary before the asset.
+//
+// At NNAPI feature level 4 (API level 30) or earlier, the NNAPI drivers may not have the
+// permission to access the asset file. To work around this issue, or if the asset cannot be
+// mapped, here we will:
 // 1. Allocate a large-enough shared memory to hold the model data;
 // 2. Copy the asset file to the shared memory;
 // 3. Create the NNAPI memory with the file descriptor of the shared memory.
-ANeuralNetworksMemory* createMemoryFromAsset(AAsset* asset) {
-    off_t length = AAsset_getLength(asset);
+//
+// Sets *dataOffset to the offset of the model data within the returned memory.
+ANeuralNetworksMemory* createMemoryFromAsset(AAsset* asset, size_t* dataOffset) {
+    const off64_t length = AAsset_getLength64(asset);
+    if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
+        off64_t start = 0, mappedLength = 0;
+        const int fd = AAsset_openFileDescriptor64(asset, &start, &mappedLength);
+        if (fd < 0) {
+            LOGI("The model data asset is compressed, falling back to a copy");
+        } else {
+            const off64_t mappedStart = start - start % sysconf(_SC_PAGESIZE);
+            ANeuralNetworksMemory* memory = nullptr;
+            int result = ANeuralNetworksMemory_createFromFd(
+                    mappedLength + (start - mappedStart), PROT_READ, fd, mappedStart, &memory);
+            // ANeuralNetworksMemory_createFromFd duplicates the file descriptor
+            close(fd);
+            if (result == ANEURALNETWORKS_NO_ERROR) {
+                LOGI("Model data: %lld bytes mapped, 0 bytes copied",
+                     static_cast<long long>(mappedLength));
+                *dataOffset = start - mappedStart;
+                return memory;
+            }
+            LOGE("Failed to map the model data asset with %s, falling back to a copy",
+                 nnResultToStr(result));
+        }
+    }
+
     auto ashmem = std::make_unique<ManagedAshmem>("model_data", length);
     AAsset_read(asset, ashmem->data(), length);
+    LOGI("Model data: 0 bytes mapped, %lld bytes copied", static_cast<long long>(length));
+    *dataOffset = 0;
     return ashmem->createANeuralNetworksMemory();
 }
 
+// Read the whole asset file into memory
+std::vector<uint8_t> readAsset(AAssetManager* assetManager, const char* filename) {
+    AAsset* asset = AAssetManager_open(assetManager, filename, AASSET_MODE_BUFFER);
+    CHECK(asset != nullptr);
+    std::vector<uint8_t> data(AAsset_getLength64(asset));
+    CHECK(AAsset_read(asset, data.data(), data.size()) == static_cast<int>(data.size()));
+    AAsset_close(asset);
+    return data;
+}
+
+// A rank of the NNAPI device types, the more specialized the device, the higher
+int deviceTypeRank(int32_t type) {
+    switch (type) {
+        case ANEURALNETWORKS_DEVICE_ACCELERATOR:
+            return 3;
+        case ANEURALNETWORKS_DEVICE_GPU:
+            return 2;
+        case ANEURALNETWORKS_DEVICE_CPU:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+// Select the devices to compile the model for, as indexes into support.devices().
+//
+// If the configuration names the devices, the compilation is pinned to them. Every operation must
+// then be supported by one of them, as NNAPI will not fall back to any other device, e.g. the CPU.
+//
+// Otherwise, NNAPI only measures the duration of executions compiled for a single device, so among
+// the devices supporting every operation of the model, this picks the most specialized one, i.e.
+// an accelerator over a GPU over the CPU. Returns no device if none supports the whole model, in
+// which case the model is compiled with ANeuralNetworksCompilation_create so that the runtime can
+// partition it across devices.
+std::vector<uint32_t> selectDevices(const NnapiOperationSupport& support,
+                                    const std::vector<std::string>& names) {
+    const auto& devices = support.devices();
+    if (!names.empty()) {
+        std::vector<uint32_t> selected;
+        for (const auto& name : names) {
+            const int index = support.findDevice(name);
+            if (index < 0) {
+                LOG_FATAL("NNAPI device %s is not available", name.c_str());
+            }
+            selected.push_back(index);
+        }
+        const auto unsupported = support.getUnsupportedOperations(selected);
+        if (!unsupported.empty()) {
+            LOG_FATAL("NNAPI operation %s is not supported by the configured devices",
+                      support.describeOperation(unsupported.front()).c_str());
+        }
+        return selected;
+    }
+
+    int best = -1;
+    for (uint32_t i = 0; i < devices.size(); i++) {
+        if (!support.getUnsupportedOperations({i}).empty()) continue;
+        if (best < 0 || deviceTypeRank(devices[i].type) > deviceTypeRank(devices[best].type)) {
+            best = i;
+        }
+    }
+    if (best >= 0) {
+        return {static_cast<uint32_t>(best)};
+    }
+
+    // The operations no device besides the CPU supports will fall back to it
+    std::vector<uint32_t> nonCpuDevices;
+    for (uint32_t i = 0; i < devices.size(); i++) {
+        if (devices[i].type != ANEURALNETWORKS_DEVICE_CPU) nonCpuDevices.push_back(i);
+    }
+    for (uint32_t op : support.getUnsupportedOperations(nonCpuDevices)) {
+        LOGE("NNAPI operation %s falls back to the CPU", support.describeOperation(op).c_str());
+    }
+    return {};
+}
+
+// Creates a finished model from the graph, see populateModelFromGraph
+ANeuralNetworksModel* createModel(const std::vector<uint8_t>& graph,
+                                  ANeuralNetworksMemory* modelData, size_t modelDataOffset,
+                                  size_t modelDataSize, bool float16Input,
+                                  bool relaxComputationFloat32toFloat16,
+                                  ModelGraphInfo* info = nullptr) {
+    ANeuralNetworksModel* model = nullptr;
+    CALL_NN(ANeuralNetworksModel_create, &model);
+    ModelGraphInfo graphInfo = populateModelFromGraph(model, graph, modelData, modelDataOffset,
+                                                      modelDataSize, float16Input);
+    CALL_NN(ANeuralNetworksModel_relaxComputationFloat32toFloat16, model,
+            relaxComputationFloat32toFloat16);
+    CALL_NN(ANeuralNetworksModel_finish, model);
+    if (info != nullptr) *info = std::move(graphInfo);
+    return model;
+}
+
+// The model outputs are the backward displacements, the forward displacements, the heatmap and
+// the offsets, in this order. The quantized outputs take one byte per element.
+std::vector<uint32_t> getOutputSizes(bool quant8) {
+    const uint32_t elementSize = quant8 ? sizeof(uint8_t) : sizeof(float);
+    return {
+            kOutputDisplacementsSize * elementSize,
+            kOutputDisplacementsSize * elementSize,
+            kOutputHeatmapSize * elementSize,
+            kOutputOffsetsSize * elementSize,
+    };
+}
+
+// Checks that the model graph matches the executor: the input of the type the renderer writes,
+// quantized alike for the quantized model, and all outputs of the type of the tensors
+void checkModelGraphTypes(const ModelGraphInfo& info, int32_t inputType, int32_t tensorType) {
+    CHECK(info.inputTypes.size() == 1 && info.outputTypes.size() == 4);
+    const ModelGraphOperandType& input = info.inputTypes[0];
+    if (input.type != inputType ||
+        (inputType == ANEURALNETWORKS_TENSOR_QUANT8_ASYMM &&
+         (input.scale != kRendererOutputQuant8Scale ||
+          input.zeroPoint != kRendererOutputQuant8ZeroPoint))) {
+        LOG_FATAL("The model input is %s with scale %f and zero point %d, expected %s",
+                  nnOperandTypeToStr(input.type), input.scale, input.zeroPoint,
+                  nnOperandTypeToStr(inputType));
+    }
+    for (const auto& output : info.outputTypes) {
+        if (output.type != tensorType) {
+            LOG_FATAL("The model output is %s, expected %s", nnOperandTypeToStr(output.type),
+                      nnOperandTypeToStr(tensorType));
+        }
+    }
+}
+
 }  // namespace
 
 NnapiExecutor::NnapiExecutor(PoseEstimationConfig config, AAssetManager* assetManager)
     : MlExecutorBase(config) {
     LOGI("NnapiExecutor::NnapiExecutor");
+    mQuant8 = mConfig.mlExecutor == MlExecutor::NATIVE_NNAPI_QUANT8;
+    const int32_t tensorType =
+            mQuant8 ? ANEURALNETWORKS_TENSOR_QUANT8_ASYMM : ANEURALNETWORKS_TENSOR_FLOAT32;
+    // The half-precision renderer output is cast to fp32 by the model, see populateModelFromGraph
+    const bool float16Input = mConfig.float16RendererOutput && !mQuant8;
+    const int32_t inputType = float16Input ? ANEURALNETWORKS_TENSOR_FLOAT16 : tensorType;
+    const uint32_t inputSize = mQuant8        ? kRendererOutputQuant8SizeBytes
+                               : float16Input ? kRendererOutputFloat16SizeBytes
+                                              : kRendererOutputSizeBytes;
 
     // Model data memory
-    AAsset* modelDataAsset = AAssetManager_open(assetManager, "model_data.bin", AASSET_MODE_BUFFER);
+    // The model data is also digested into the compilation cache token. For an uncompressed
+    // asset, AAsset_getBuffer maps the APK, so this does not copy the model data either.
+    CompilationCacheTokenBuilder tokenBuilder;
+    AAsset* modelDataAsset = AAssetManager_open(
+            assetManager, mQuant8 ? "model_data_quant8.bin" : "model_data.bin", AASSET_MODE_BUFFER);
     CHECK(modelDataAsset != nullptr);
-    mModelData = createMemoryFromAsset(modelDataAsset);
+    const void* modelDataBuffer = AAsset_getBuffer(modelDataAsset);
+    CHECK(modelDataBuffer != nullptr);
+    const size_t modelDataSize = AAsset_getLength64(modelDataAsset);
+    tokenBuilder.update(modelDataBuffer, modelDataSize);
+    mModelData = createMemoryFromAsset(modelDataAsset, &mModelDataOffset);
     AAsset_close(modelDataAsset);
 
     // Model
-    CALL_NN(ANeuralNetworksModel_create, &mModel);
-    populatePoseEstimationModel(mModel, mModelData);
-    CALL_NN(ANeuralNetworksModel_relaxComputationFloat32toFloat16, mModel, /*allow=*/true);
-    CALL_NN(ANeuralNetworksModel_finish, mModel);
-
-    // Compilation
-    CALL_NN(ANeuralNetworksCompilation_create, mModel, &mCompilation);
-    CALL_NN(ANeuralNetworksCompilation_finish, mCompilation);
-
-    // Plan the execution memory layout, and allocate the memory for execution outputs
-    // The execution input memory will be set by NnapiExecutor::setInputFromHardwareBuffer
-    layoutExecutionMemory();
-    mExecutionOutputMemory =
-            std::make_unique<ManagedAshmem>("execution_outputs", mExecutionOutputMemorySize);
-    mExecutionOutput = mExecutionOutputMemory->createANeuralNetworksMemory();
-
-    // Get the start address of the output tensors of heatmap (index=2) and offsets (index=3)
-    mOutputData = reinterpret_cast<float*>(mExecutionOutputMemory->data());
-    CHECK(mOutputData != nullptr);
-    mOutputHeatmap = mOutputData + mExecutionOutputLayouts[2].offset / sizeof(float);
-    mOutputOffsets = mOutputData + mExecutionOutputLayouts[3].offset / sizeof(float);
-
-    // The NNAPI burst execution is designed to reduce the overhead and improve the performance of a
-    // rapid sequence of executions. Although NNAPI burst execution is introduced in NNAPI feature
-    // level 3, we recommend to use NNAPI burst execution starting from NNAPI feature level 5 to get
-    // the best performance. At NNAPI feature level 4 or earlier, synchronous execution is
-    // recommended
-    if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
-        CALL_NN(ANeuralNetworksBurst_create, mCompilation, &mBurst);
+    // The operations are supported alike with and without relaxed precision, the model is created
+    // again below if the compilation settings differ. Relaxed precision only applies to the float
+    // operations, so the quantized model does without.
+    NnapiCompilationSettings defaultSettings;
+    if (mQuant8) defaultSettings.relaxComputationFloat32toFloat16 = false;
+    mModelGraph = readAsset(assetManager, mQuant8 ? "model_graph_quant8.bin" : "model_graph.bin");
+    ModelGraphInfo graphInfo;
+    mModel = createModel(mModelGraph, mModelData, mModelDataOffset, modelDataSize, float16Input,
+                         defaultSettings.relaxComputationFloat32toFloat16, &graphInfo);
+    checkModelGraphTypes(graphInfo, inputType, tensorType);
+    for (const auto& output : graphInfo.outputTypes) {
+        mOutputQuantizations.push_back({.scale = output.scale, .zeroPoint = output.zeroPoint});
     }
-}
 
-void NnapiExecutor::setInputFromHardwareBuffer(AHardwareBuffer* ahwb) {
-    LOGI("NnapiExecutor::setInputFromHardwareBuffer");
-    CHECK(mExecutionInput == nullptr);
-    CALL_NN(ANeuralNetworksMemory_createFromAHardwareBuffer, ahwb, &mExecutionInput);
-}
-
-void NnapiExecutor::layoutExecutionMemory() {
-    // We will allocate two memory pools for PoseNet: one for the input image, one to bundle all
-    // output memories. NNAPI supports querying the preferred memory alignment and padding since
-    // NNAPI feature level 5. To get the best performance, we will make sure the input and output
-    // memories satisfy the given memory preference.
-
-    // Layout execution input
-    // We only have one input and the alignment will always be satisfied with offset = 0,
-    // so we only query the padding here.
-    uint32_t inputPadding = 1;
-    if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
-        CALL_NN(NdkFunctions::get().ANeuralNetworksCompilation_getPreferredMemoryPaddingForInput,
-                mCompilation, /*index=*/0, &inputPadding);
+    // Devices
+    const NnapiOperationSupport support(mModel, std::move(graphInfo.operationTypes),
+                                        getNnapiDevices());
+    support.log();
+    const std::vector<uint32_t> deviceIndexes = selectDevices(support, mConfig.nnapiDevices);
+    std::vector<ANeuralNetworksDevice*> devices;
+    std::string deviceNames;
+    for (uint32_t index : deviceIndexes) {
+        devices.push_back(support.devices()[index].handle);
+        if (!deviceNames.empty()) deviceNames += ", ";
+        deviceNames += support.devices()[index].name;
     }
-    mExecutionInputMemorySize = roundUp(kRendererOutputSizeBytes, inputPadding);
-
-    // Size in bytes for each output tensor
-    const std::vector<uint32_t> kOutputSizes = {
-            kOutputDisplacementsSizeBytes,
-            kOutputDisplacementsSizeBytes,
-            kOutputHeatmapSizeBytes,
-            kOutputOffsetsSizeBytes,
-    };
-
-    // Layout execution output
-    uint32_t outputOffset = 0;
-    mExecutionOutputLayouts.resize(kOutputSizes.size());
-    for (uint32_t i = 0; i < kOutputSizes.size(); i++) {
-        // Query the preferred output alignment and padding
-        uint32_t alignment = sizeof(float);
-        uint32_t padding = 1;
-        if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
-            CALL_NN(NdkFunctions::get()
-                            .ANeuralNetworksCompilation_getPreferredMemoryAlignmentForOutput,
-                    mCompilation, i, &alignment);
-            CALL_NN(NdkFunctions::get()
-                            .ANeuralNetworksCompilation_getPreferredMemoryPaddingForOutput,
-                    mCompilation, i, &padding);
+    // NNAPI only measures the execution timing with a single device
+    const bool measureTiming = devices.size() == 1;
+    if (devices.empty()) {
+        LOGI("Compiling for the NNAPI devices picked by the runtime");
+    } else {
+        LOGI("Compiling for the NNAPI devices: %s, execution timing is %s", deviceNames.c_str(),
+             measureTiming ? "measured" : "not measured");
+    }
+    tokenBuilder.update(mModelGraph.data(), mModelGraph.size());
+    tokenBuilder.update(float16Input);
+
+    // Compilation settings
+    NnapiCompilationSettings settings = defaultSettings;
+    if (mConfig.autoTuneCompilation) {
+        // The fingerprint identifies the model, and the devices with their drivers. The runtime
+        // partitions the model across all devices if none is selected.
+        CompilationCacheTokenBuilder fingerprintBuilder = tokenBuilder;
+        fingerprintBuilder.update(NdkFunctions::nnapiFeatureLevel());
+        for (uint32_t i = 0; i < support.devices().size(); i++) {
+            if (!deviceIndexes.empty() && std::find(deviceIndexes.begin(), deviceIndexes.end(),
+                                                    i) == deviceIndexes.end()) {
+                continue;
+            }
+            const auto& device = support.devices()[i];
+            fingerprintBuilder.update(device.name);
+            fingerprintBuilder.update(device.version);
+            fingerprintBuilder.update(device.featureLevel);
         }
 
-        // Build the output memory with preferred alignment and padding
-        outputOffset = roundUp(outputOffset, alignment);
-        mExecutionOutputLayouts[i].offset = outputOffset;
-        mExecutionOutputLayouts[i].paddedLength = roundUp(kOutputSizes[i], padding);
-        outputOffset += mExecutionOutputLayouts[i].paddedLength;
+        // The fp32 reference is computed on the NNAPI reference CPU device if available
+        ANeuralNetworksDevice* referenceDevice = nullptr;
+        for (const auto& device : support.devices()) {
+            if (device.type == ANEURALNETWORKS_DEVICE_CPU) referenceDevice = device.handle;
+        }
+        const NnapiTuningTarget target = {
+                .createModel =
+                        [this, modelDataSize, float16Input](bool relaxed) {
+                            return createModel(mModelGraph, mModelData, mModelDataOffset,
+                                               modelDataSize, float16Input, relaxed);
+                        },
+                .devices = devices,
+                .referenceDevice = referenceDevice,
+                .inputType = inputType,
+                .outputSizes = getOutputSizes(mQuant8),
+                // See NnapiExecutor::getOutputHeatmapAddress and getOutputOffsetsAddress
+                .decodePose =
+                        [this](const NnapiExecutionPool& pool, uint32_t slot) {
+                            if (mQuant8) {
+                                return decodeSinglePose(
+                                        getQuant8Output(pool, slot, /*outputIndex=*/2),
+                                        getQuant8Output(pool, slot, /*outputIndex=*/3));
+                            }
+                            return decodeSinglePose(pool.getOutputAddress(slot, /*outputIndex=*/2),
+                                                    pool.getOutputAddress(slot, /*outputIndex=*/3));
+                        },
+                .fingerprint = fingerprintBuilder.finish(),
+        };
+        settings = tuneNnapiCompilation(target, mConfig.compilationCacheDir);
+    }
+    if (settings.relaxComputationFloat32toFloat16 !=
+        defaultSettings.relaxComputationFloat32toFloat16) {
+        ANeuralNetworksModel_free(mModel);
+        mModel = createModel(mModelGraph, mModelData, mModelDataOffset, modelDataSize,
+                             float16Input, settings.relaxComputationFloat32toFloat16);
     }
-    mExecutionOutputMemorySize = outputOffset;
-}
-
-void NnapiExecutor::createAndSetupExecution() {
-    ANeuralNetworksExecution_free(mExecution);
-    CALL_NN(ANeuralNetworksExecution_create, mCompilation, &mExecution);
 
-    // Enable reusable execution and memory padding if supported
-    // We can only use reusable execution and padded memories when the features are enabled on the
-    // execution object.
-    if (NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5) {
-        CALL_NN(NdkFunctions::get().ANeuralNetworksExecution_setReusable, mExecution,
-                /*reusable=*/true);
-        CALL_NN(NdkFunctions::get().ANeuralNetworksExecution_enableInputAndOutputPadding,
-                mExecution, /*enable=*/true);
+    // Compilation
+    // The token covers everything that affects the compiled model besides the model data
+    tokenBuilder.update(settings.relaxComputationFloat32toFloat16);
+    tokenBuilder.update(settings.preference);
+    tokenBuilder.update(deviceNames);
+    const auto compilationStart = std::chrono::high_resolution_clock::now();
+    if (!devices.empty()) {
+        CALL_NN(ANeuralNetworksCompilation_createForDevices, mModel, devices.data(),
+                devices.size(), &mCompilation);
+    } else {
+        CALL_NN(ANeuralNetworksCompilation_create, mModel, &mCompilation);
+    }
+    CALL_NN(ANeuralNetworksCompilation_setPreference, mCompilation, settings.preference);
+    std::unique_ptr<NnapiCompilationCache> cache;
+    if (!mConfig.compilationCacheDir.empty()) {
+        cache = std::make_unique<NnapiCompilationCache>(mConfig.compilationCacheDir,
+                                                        tokenBuilder.finish());
+        cache->setCaching(mCompilation);
+    }
+    CALL_NN(ANeuralNetworksCompilation_finish, mCompilation);
+    const auto compilationFinished = std::chrono::high_resolution_clock::now();
+    const float compilationTimeMs =
+            std::chrono::duration<float, std::milli>(compilationFinished - compilationStart)
+                    .count();
+    if (cache != nullptr) {
+        cache->markCompiled();
+        LOGI("NNAPI compilation took %.2f ms, compilation cache %s", compilationTimeMs,
+             cache->isHit() ? "hit" : "miss");
+    } else {
+        LOGI("NNAPI compilation took %.2f ms, compilation cache disabled", compilationTimeMs);
     }
 
-    // Input memory
-    CHECK(mExecutionInput != nullptr);
-    CALL_NN(ANeuralNetworksExecution_setInputFromMemory, mExecution, /*index=*/0, /*type=*/nullptr,
-            mExecutionInput, /*offset=*/0, mExecutionInputMemorySize);
+    // Create the executions and plan their memory layout. The execution input memories will be
+    // set by NnapiExecutor::setInputFromHardwareBuffer
+    mPool = std::make_unique<NnapiExecutionPool>(mCompilation, mConfig.pipelineDepth, inputSize,
+                                                 getOutputSizes(mQuant8), measureTiming);
+}
 
-    // Output memories
-    for (uint32_t i = 0; i < mExecutionOutputLayouts.size(); i++) {
-        const auto& layout = mExecutionOutputLayouts[i];
-        CALL_NN(ANeuralNetworksExecution_setOutputFromMemory, mExecution, i, /*type=*/nullptr,
-                mExecutionOutput, layout.offset, layout.paddedLength);
-    }
+void NnapiExecutor::setInputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) {
+    LOGI("NnapiExecutor::setInputFromHardwareBuffer");
+    ANeuralNetworksMemory* memory = nullptr;
+    CALL_NN(ANeuralNetworksMemory_createFromAHardwareBuffer, ahwb, &memory);
+    mPool->setInputMemory(slot, memory);
 }
 
 NnapiExecutor::~NnapiExecutor() {
     LOGI("NnapiExecutor::~NnapiExecutor");
 
-    ANeuralNetworksExecution_free(mExecution);
-    ANeuralNetworksBurst_free(mBurst);
+    mPool.reset();
     ANeuralNetworksCompilation_free(mCompilation);
     ANeuralNetworksModel_free(mModel);
     ANeuralNetworksMemory_free(mModelData);
-    ANeuralNetworksMemory_free(mExecutionInput);
-    ANeuralNetworksMemory_free(mExecutionOutput);
 }
 
-void NnapiExecutor::run(UniqueFd syncFenceFd) {
-    // All input and output memories bindings are fixed in this demo, so we could benefit from NNAPI
-    // reusable execution that is supported since NNAPI feature level 5.
-    // If NNAPI reusable execution is supported, we create and setup the execution only in the first
-    // NnapiExecutor::run and reuse it in subsequent runs. Otherwise, we need to create and setup
-    // the execution in every NnapiExecutor::run.
-    if (NdkFunctions::nnapiFeatureLevel() < ANEURALNETWORKS_FEATURE_LEVEL_5 ||
-        mExecution == nullptr) {
-        createAndSetupExecution();
-    }
-
-    // Attempt fenced execution if a valid syncFenceFd is supplied.
-    if (syncFenceFd.ok()) {
-        CHECK(supportsAndroidSyncFence());
-
-        // Setup dependencies
-        ANeuralNetworksEvent* start;
-        CALL_NN(NdkFunctions::get().ANeuralNetworksEvent_createFromSyncFenceFd, syncFenceFd.get(),
-                &start);
-
-        // Fenced compute
-        ANeuralNetworksEvent* finished;
-        CALL_NN(NdkFunctions::get().ANeuralNetworksExecution_startComputeWithDependencies,
-                mExecution, &start, 1u, /*infinite timeout*/ 0, &finished);
-        CALL_NN(ANeuralNetworksEvent_wait, finished);
-
-        // Cleanup
-        ANeuralNetworksEvent_free(start);
-        ANeuralNetworksEvent_free(finished);
-        return;
-    }
-
-    // We may reach this point if either:
-    // - exporting sync fence is not supported by the GPU renderer
-    // - the GPU rendering has already finished prior to exporting the fence
-    // - the device is at NNAPI feature level 4 or earlier, where the fenced execution is not
-    //   recommended
-    // Attempt burst compute if available.
-    if (mBurst != nullptr) {
-        CALL_NN(ANeuralNetworksExecution_burstCompute, mExecution, mBurst);
-        return;
-    }
-
-    // We may reach this point if the device is at NNAPI feature level 4 or earlier, where neither
-    // the fenced execution nor the burst execution is preferable. In such a case, we compute
-    // synchronously.
-    CALL_NN(ANeuralNetworksExecution_compute, mExecution);
+void NnapiExecutor::start(uint32_t slot, UniqueFd syncFenceFd) {
+    TRACE_SCOPE("NnapiExecutor::start");
+    // The slot stays acquired until NnapiExecutor::wait, its outputs remain valid until the slot is
+    // started again
+    mPool->acquire(slot);
+
+    // With a single frame in flight there is nothing to overlap with, so compute on the calling
+    // thread to avoid handing the burst computation over to a worker thread
+    if (mConfig.pipelineDepth == 1) {
+        mPool->run(slot, std::move(syncFenceFd));
+    } else {
+        mPool->runAsync(slot, std::move(syncFenceFd));
+    }
+}
+
+void NnapiExecutor::wait(uint32_t slot) {
+    TRACE_SCOPE("NnapiExecutor::wait");
+    mPool->wait(slot);
+    mPool->release(slot);
 }
 
 }  // namespace pose_estimation
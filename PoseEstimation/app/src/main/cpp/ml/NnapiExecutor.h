@@ -20,9 +20,13 @@
 #include <android/asset_manager_jni.h>
 #include <android/hardware_buffer.h>
 
+#include <memory>
+#include <vector>
+
 #include "../NdkFunctions.h"
 #include "../PoseEstimationConfig.h"
 #include "MlExecutorBase.h"
+#include "NnapiExecutionPool.h"
 #include "NnapiUtils.h"
 
 namespace pose_estimation {
@@ -32,11 +36,37 @@ class NnapiExecutor : public MlExecutorBase {
     NnapiExecutor(PoseEstimationConfig config, AAssetManager* assetManager);
     ~NnapiExecutor() override;
 
-    uint32_t getRequiredInputMemorySize() const override { return mExecutionInputMemorySize; }
-    void setInputFromHardwareBuffer(AHardwareBuffer* ahwb) override;
+    uint32_t getRequiredInputMemorySize() const override { return mPool->getInputMemorySize(); }
+    void setInputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) override;
 
-    const float* getOutputHeatmapAddress() const override { return mOutputHeatmap; }
-    const float* getOutputOffsetsAddress() const override { return mOutputOffsets; }
+    // The model outputs are the backward displacements, the forward displacements, the heatmap and
+    // the offsets, in this order. With MlExecutor::NATIVE_NNAPI_QUANT8, the outputs are quantized
+    // and only the quantized getters apply.
+    const float* getOutputHeatmapAddress(uint32_t slot) const override {
+        return mPool->getOutputAddress(slot, /*outputIndex=*/2);
+    }
+    const float* getOutputOffsetsAddress(uint32_t slot) const override {
+        return mPool->getOutputAddress(slot, /*outputIndex=*/3);
+    }
+    const float* getOutputDisplacementsFwdAddress(uint32_t slot) const override {
+        return mPool->getOutputAddress(slot, /*outputIndex=*/1);
+    }
+    const float* getOutputDisplacementsBwdAddress(uint32_t slot) const override {
+        return mPool->getOutputAddress(slot, /*outputIndex=*/0);
+    }
+    bool hasQuant8Outputs() const override { return mQuant8; }
+    Quant8Tensor getQuant8OutputHeatmap(uint32_t slot) const override {
+        return getQuant8Output(*mPool, slot, /*outputIndex=*/2);
+    }
+    Quant8Tensor getQuant8OutputOffsets(uint32_t slot) const override {
+        return getQuant8Output(*mPool, slot, /*outputIndex=*/3);
+    }
+    Quant8Tensor getQuant8OutputDisplacementsFwd(uint32_t slot) const override {
+        return getQuant8Output(*mPool, slot, /*outputIndex=*/1);
+    }
+    Quant8Tensor getQuant8OutputDisplacementsBwd(uint32_t slot) const override {
+        return getQuant8Output(*mPool, slot, /*outputIndex=*/0);
+    }
 
     // NNAPI supports sync fence (ANeuralNetworksExecution_startComputeWithDependencies) since NNAPI
     // feature level 4. However, many drivers at NNAPI feature level 4 cannot run fenced computation
@@ -46,43 +76,40 @@ class NnapiExecutor : public MlExecutorBase {
         return NdkFunctions::nnapiFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_5;
     }
 
-    void run(UniqueFd syncFenceFd) override;
+    void start(uint32_t slot, UniqueFd syncFenceFd) override;
+    void wait(uint32_t slot) override;
+
+    // The timing is only measured if the model is compiled for a single device, see
+    // selectDevices in NnapiExecutor.cpp
+    MlTiming getTiming(uint32_t slot) override { return mPool->getTiming(slot); }
 
    private:
-    void layoutExecutionMemory();
-    void createAndSetupExecution();
+    Quant8Tensor getQuant8Output(const NnapiExecutionPool& pool, uint32_t slot,
+                                 uint32_t outputIndex) const {
+        return {.data = pool.getOutputBytes(slot, outputIndex),
+                .scale = mOutputQuantizations[outputIndex].scale,
+                .zeroPoint = mOutputQuantizations[outputIndex].zeroPoint};
+    }
 
     // Model
+    // Whether the model is the quantized one, see MlExecutor::NATIVE_NNAPI_QUANT8
+    bool mQuant8 = false;
+    // The scale and zero point of every output of the quantized model, without data
+    std::vector<Quant8Tensor> mOutputQuantizations;
     ANeuralNetworksModel* mModel = nullptr;
     ANeuralNetworksMemory* mModelData = nullptr;
+    // The offset of the model data within mModelData, see createMemoryFromAsset
+    size_t mModelDataOffset = 0;
+    // Must outlive mModel, see populateModelFromGraph
+    std::vector<uint8_t> mModelGraph;
 
     // Compilation
     ANeuralNetworksCompilation* mCompilation = nullptr;
 
-    // Execution
-    ANeuralNetworksExecution* mExecution = nullptr;
-    ANeuralNetworksBurst* mBurst = nullptr;
-
-    // Execution input
-    uint32_t mExecutionInputMemorySize = 0;
-    ANeuralNetworksMemory* mExecutionInput = nullptr;
-
-    // Execution output
-    struct OutputLayout {
-        uint32_t offset;
-        uint32_t paddedLength;
-    };
-    std::vector<OutputLayout> mExecutionOutputLayouts;
-    uint32_t mExecutionOutputMemorySize = 0;
-    std::unique_ptr<ManagedMemory> mExecutionOutputMemory;
-    ANeuralNetworksMemory* mExecutionOutput = nullptr;
-    float* mOutputData = nullptr;
-    const float* mOutputHeatmap = nullptr;
-    const float* mOutputOffsets = nullptr;
+    // Executions, one slot per frame in flight
+    std::unique_ptr<NnapiExecutionPool> mPool;
 };
 
-void populatePoseEstimationModel(ANeuralNetworksModel* model, ANeuralNetworksMemory* memory);
-
 }  // namespace pose_estimation
 
 #endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_EXECUTOR_H
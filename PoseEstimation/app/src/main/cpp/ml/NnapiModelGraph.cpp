@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NnapiModelGraph.h"
+
+#include <android/NeuralNetworks.h>
+
+#include <cstring>
+#include <vector>
+
+#include "NnapiUtils.h"
+
+namespace pose_estimation {
+namespace {
+
+// Reads the words of a model graph, all reads are bounds-checked
+class GraphReader {
+   public:
+    explicit GraphReader(const std::vector<uint8_t>& graph) : mGraph(graph) {}
+
+    uint32_t readUint32() {
+        uint32_t value;
+        std::memcpy(&value, readBytes(sizeof(value)), sizeof(value));
+        return value;
+    }
+    int32_t readInt32() { return static_cast<int32_t>(readUint32()); }
+    float readFloat() {
+        float value;
+        std::memcpy(&value, readBytes(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    // Reads a count of elements, each of which takes at least elementSize bytes
+    uint32_t readCount(size_t elementSize) {
+        const uint32_t count = readUint32();
+        if (count > remaining() / elementSize) {
+            LOG_FATAL("Malformed model graph: count %u out of bounds at offset %zu", count,
+                      mOffset);
+        }
+        return count;
+    }
+
+    std::vector<uint32_t> readIndexes() {
+        std::vector<uint32_t> indexes(readCount(sizeof(uint32_t)));
+        for (auto& index : indexes) index = readUint32();
+        return indexes;
+    }
+
+    // Reads length bytes and skips the padding up to the next word
+    const uint8_t* readBytes(size_t length) {
+        // Bound the length before padding it, which would wrap around near SIZE_MAX
+        if (length > remaining()) {
+            LOG_FATAL("Malformed model graph: truncated at offset %zu", mOffset);
+        }
+        const size_t paddedLength = (length + 3) & ~size_t(3);
+        if (paddedLength > remaining()) {
+            LOG_FATAL("Malformed model graph: truncated at offset %zu", mOffset);
+        }
+        const uint8_t* bytes = mGraph.data() + mOffset;
+        mOffset += paddedLength;
+        return bytes;
+    }
+
+    size_t remaining() const { return mGraph.size() - mOffset; }
+
+   private:
+    const std::vector<uint8_t>& mGraph;
+    size_t mOffset = 0;
+};
+
+void checkIndexes(const std::vector<uint32_t>& indexes, uint32_t operandCount) {
+    for (uint32_t index : indexes) {
+        if (index >= operandCount) {
+            LOG_FATAL("Malformed model graph: operand %u out of %u operands", index, operandCount);
+        }
+    }
+}
+
+}  // namespace
+
+ModelGraphInfo populateModelFromGraph(ANeuralNetworksModel* model,
+                                      const std::vector<uint8_t>& graph,
+                                      ANeuralNetworksMemory* modelData, size_t modelDataOffset,
+                                      size_t modelDataSize, bool float16Inputs) {
+    GraphReader reader(graph);
+    const uint32_t magic = reader.readUint32();
+    const uint32_t version = reader.readUint32();
+    if (magic != ModelGraphFormat::kMagic || version != ModelGraphFormat::kVersion) {
+        LOG_FATAL("Unsupported model graph: magic 0x%08x, version %u", magic, version);
+    }
+    const uint32_t operandCount = reader.readUint32();
+    const uint32_t operationCount = reader.readUint32();
+    const uint32_t inputCount = reader.readUint32();
+    const uint32_t outputCount = reader.readUint32();
+
+    // Operands
+    std::vector<ModelGraphOperandType> operandTypes(operandCount);
+    std::vector<std::vector<uint32_t>> operandDimensions(operandCount);
+    for (uint32_t i = 0; i < operandCount; i++) {
+        const int32_t type = reader.readInt32();
+        const std::vector<uint32_t> dimensions = reader.readIndexes();
+        ANeuralNetworksOperandType operandType = {
+                .type = type,
+                .dimensionCount = static_cast<uint32_t>(dimensions.size()),
+                .dimensions = dimensions.empty() ? nullptr : dimensions.data(),
+                .scale = reader.readFloat(),
+                .zeroPoint = reader.readInt32(),
+        };
+        CALL_NN(ANeuralNetworksModel_addOperand, model, &operandType);
+        operandTypes[i] = {.type = type, .scale = operandType.scale,
+                           .zeroPoint = operandType.zeroPoint};
+        operandDimensions[i] = dimensions;
+
+        const uint32_t valueSource = reader.readUint32();
+        if (valueSource == ModelGraphFormat::kValueInline) {
+            const uint32_t length = reader.readUint32();
+            const uint8_t* value = reader.readBytes(length);
+            CALL_NN(ANeuralNetworksModel_setOperandValue, model, i, value, length);
+        } else if (valueSource == ModelGraphFormat::kValueModelData) {
+            const uint32_t offset = reader.readUint32();
+            const uint32_t length = reader.readUint32();
+            if (offset > modelDataSize || length > modelDataSize - offset) {
+                LOG_FATAL("Malformed model graph: operand %u value [%u, %u) out of %zu bytes", i,
+                          offset, offset + length, modelDataSize);
+            }
+            CALL_NN(ANeuralNetworksModel_setOperandValueFromMemory, model, i, modelData,
+                    modelDataOffset + offset, length);
+        } else if (valueSource != ModelGraphFormat::kValueNone) {
+            LOG_FATAL("Malformed model graph: operand %u has value source %u", i, valueSource);
+        }
+    }
+
+    // Operations
+    ModelGraphInfo info;
+    info.operationTypes.resize(operationCount);
+    for (uint32_t i = 0; i < operationCount; i++) {
+        const int32_t type = reader.readInt32();
+        info.operationTypes[i] = type;
+        const std::vector<uint32_t> inputs = reader.readIndexes();
+        const std::vector<uint32_t> outputs = reader.readIndexes();
+        checkIndexes(inputs, operandCount);
+        checkIndexes(outputs, operandCount);
+        CALL_NN(ANeuralNetworksModel_addOperation, model, type, inputs.size(), inputs.data(),
+                outputs.size(), outputs.data());
+    }
+
+    // Input and output indexes
+    if (reader.remaining() / sizeof(uint32_t) < uint64_t(inputCount) + outputCount) {
+        LOG_FATAL("Malformed model graph: %u inputs and %u outputs out of bounds", inputCount,
+                  outputCount);
+    }
+    std::vector<uint32_t> inputs(inputCount), outputs(outputCount);
+    for (auto& index : inputs) index = reader.readUint32();
+    for (auto& index : outputs) index = reader.readUint32();
+    checkIndexes(inputs, operandCount);
+    checkIndexes(outputs, operandCount);
+    for (auto& index : inputs) {
+        if (!float16Inputs || operandTypes[index].type != ANEURALNETWORKS_TENSOR_FLOAT32) continue;
+        const ANeuralNetworksOperandType operandType = {
+                .type = ANEURALNETWORKS_TENSOR_FLOAT16,
+                .dimensionCount = static_cast<uint32_t>(operandDimensions[index].size()),
+                .dimensions = operandDimensions[index].data(),
+        };
+        const uint32_t float16Index = operandTypes.size();
+        CALL_NN(ANeuralNetworksModel_addOperand, model, &operandType);
+        operandTypes.push_back({.type = ANEURALNETWORKS_TENSOR_FLOAT16});
+        CALL_NN(ANeuralNetworksModel_addOperation, model, ANEURALNETWORKS_CAST, 1, &float16Index,
+                1, &index);
+        info.operationTypes.push_back(ANEURALNETWORKS_CAST);
+        index = float16Index;
+    }
+    CALL_NN(ANeuralNetworksModel_identifyInputsAndOutputs, model, inputs.size(), inputs.data(),
+            outputs.size(), outputs.data());
+    if (reader.remaining() != 0) {
+        LOG_FATAL("Malformed model graph: %zu trailing bytes", reader.remaining());
+    }
+    for (uint32_t index : inputs) info.inputTypes.push_back(operandTypes[index]);
+    for (uint32_t index : outputs) info.outputTypes.push_back(operandTypes[index]);
+    return info;
+}
+
+}  // namespace pose_estimation
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_MODEL_GRAPH_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_MODEL_GRAPH_H
+
+#include <android/NeuralNetworks.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pose_estimation {
+
+// A binary description of an NNAPI model graph, replayed into an ANeuralNetworksModel by
+// populateModelFromGraph. The graph of the pose estimation model is shipped as the
+// model_graph.bin asset next to the model data, and is written by tools/model_graph.py.
+//
+// All fields are 32-bit little-endian words, the graph is laid out as:
+//   Header:
+//     magic ("NNGR"), version, operandCount, operationCount, inputCount, outputCount
+//   operandCount x Operand:
+//     type, dimensionCount, dimensions[dimensionCount], scale (float), zeroPoint,
+//     valueSource, followed by
+//       nothing                           for kValueNone
+//       length, bytes padded to 4 bytes   for kValueInline
+//       offset, length                    for kValueModelData, a region of the model data
+//   operationCount x Operation:
+//     type, inputCount, inputs[inputCount], outputCount, outputs[outputCount]
+//   inputs[inputCount], outputs[outputCount]
+struct ModelGraphFormat {
+    static constexpr uint32_t kMagic = 0x52474E4E;  // "NNGR"
+    static constexpr uint32_t kVersion = 1;
+
+    static constexpr uint32_t kValueNone = 0;
+    static constexpr uint32_t kValueInline = 1;
+    static constexpr uint32_t kValueModelData = 2;
+};
+
+// The type of a model input or output, without its dimensions
+struct ModelGraphOperandType {
+    int32_t type;
+    float scale;
+    int32_t zeroPoint;
+};
+
+// What populateModelFromGraph has added to the model
+struct ModelGraphInfo {
+    // The types of the operations, in order
+    std::vector<int32_t> operationTypes;
+    std::vector<ModelGraphOperandType> inputTypes;
+    std::vector<ModelGraphOperandType> outputTypes;
+};
+
+// Adds the operands and operations described by the graph to the model, and identifies its
+// inputs and outputs. The constant operands stored in the model data refer to the modelDataSize
+// bytes at modelDataOffset in modelData.
+//
+// With float16Inputs, every TENSOR_FLOAT32 input of the graph is fed by a TENSOR_FLOAT16 model
+// input of the same shape through a CAST operation, which follows the operations of the graph.
+//
+// Inline values longer than ANEURALNETWORKS_MAX_SIZE_OF_IMMEDIATELY_COPIED_VALUES are not copied
+// by NNAPI, so the graph must outlive the model. A malformed graph is a fatal error.
+ModelGraphInfo populateModelFromGraph(ANeuralNetworksModel* model,
+                                      const std::vector<uint8_t>& graph,
+                                      ANeuralNetworksMemory* modelData, size_t modelDataOffset,
+                                      size_t modelDataSize, bool float16Inputs = false);
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_MODEL_GRAPH_H
@@ -62,6 +62,73 @@ inline const char* nnResultToStr(int result) {
 
 #undef NN_RESULT_TO_STR_SWITCH_CASE
 
+#define NN_DEVICE_TYPE_TO_STR_SWITCH_CASE(code) \
+    case ANEURALNETWORKS_DEVICE_##code:         \
+        return #code
+
+inline const char* nnDeviceTypeToStr(int32_t type) {
+    switch (type) {
+        NN_DEVICE_TYPE_TO_STR_SWITCH_CASE(UNKNOWN);
+        NN_DEVICE_TYPE_TO_STR_SWITCH_CASE(OTHER);
+        NN_DEVICE_TYPE_TO_STR_SWITCH_CASE(CPU);
+        NN_DEVICE_TYPE_TO_STR_SWITCH_CASE(GPU);
+        NN_DEVICE_TYPE_TO_STR_SWITCH_CASE(ACCELERATOR);
+        default:
+            return "(unknown NNAPI device type)";
+    }
+}
+
+#undef NN_DEVICE_TYPE_TO_STR_SWITCH_CASE
+
+// Only the operand types written by tools/model_graph.py are named
+#define NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(code) \
+    case ANEURALNETWORKS_##code:                 \
+        return #code
+
+inline const char* nnOperandTypeToStr(int32_t type) {
+    switch (type) {
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(FLOAT32);
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(INT32);
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(UINT32);
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(TENSOR_FLOAT32);
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(TENSOR_INT32);
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(TENSOR_QUANT8_ASYMM);
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(BOOL);
+        NN_OPERAND_TYPE_TO_STR_SWITCH_CASE(TENSOR_QUANT8_ASYMM_SIGNED);
+        default:
+            return "(unknown NNAPI operand type)";
+    }
+}
+
+#undef NN_OPERAND_TYPE_TO_STR_SWITCH_CASE
+
+// Only the operations written by tools/model_graph.py and populateModelFromGraph are named
+#define NN_OPERATION_TO_STR_SWITCH_CASE(code) \
+    case ANEURALNETWORKS_##code:              \
+        return #code
+
+inline const char* nnOperationToStr(int32_t type) {
+    switch (type) {
+        NN_OPERATION_TO_STR_SWITCH_CASE(ADD);
+        NN_OPERATION_TO_STR_SWITCH_CASE(AVERAGE_POOL_2D);
+        NN_OPERATION_TO_STR_SWITCH_CASE(CAST);
+        NN_OPERATION_TO_STR_SWITCH_CASE(CONCATENATION);
+        NN_OPERATION_TO_STR_SWITCH_CASE(CONV_2D);
+        NN_OPERATION_TO_STR_SWITCH_CASE(DEPTHWISE_CONV_2D);
+        NN_OPERATION_TO_STR_SWITCH_CASE(DEQUANTIZE);
+        NN_OPERATION_TO_STR_SWITCH_CASE(LOGISTIC);
+        NN_OPERATION_TO_STR_SWITCH_CASE(MAX_POOL_2D);
+        NN_OPERATION_TO_STR_SWITCH_CASE(MUL);
+        NN_OPERATION_TO_STR_SWITCH_CASE(RELU);
+        NN_OPERATION_TO_STR_SWITCH_CASE(RESHAPE);
+        NN_OPERATION_TO_STR_SWITCH_CASE(QUANTIZE);
+        default:
+            return "(unknown NNAPI operation)";
+    }
+}
+
+#undef NN_OPERATION_TO_STR_SWITCH_CASE
+
 }  // namespace pose_estimation
 
 #endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_ML_NNAPI_UTILS_H
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CAMERA_IMPORT_CACHE_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CAMERA_IMPORT_CACHE_H
+
+#include <android/hardware_buffer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "../NdkFunctions.h"
+#include "../Utils.h"
+#include "LruCache.h"
+
+namespace pose_estimation {
+
+// The GPU resources imported for the camera AHardwareBuffers, e.g. an EGL image or a Vulkan
+// compute pipeline sampling the buffer, shared by the GLES and Vulkan renderers.
+//
+// The camera cycles through a small set of buffers, so every buffer is imported once and the
+// import is reused on the next frames. The entries are keyed by the system wide unique ID of the
+// buffer from API 31, or else by its address. The cache holds a reference to the buffer of every
+// entry, so that its address cannot be reused by another buffer while the entry is alive.
+//
+// The cache holds up to PoseEstimationConfig::maxNumberOfCameraImages entries, and evicts the least
+// recently used one beyond, e.g. after the camera has reallocated its buffers. release drops the
+// entry of a buffer as soon as the camera is known to be done with it. The imports are shared, so
+// that the frames still in flight keep them alive until they have finished.
+template <typename Import>
+class CameraImportCache {
+    DISABLE_COPY_AND_ASSIGN(CameraImportCache);
+
+   public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        uint64_t releases = 0;
+        // The time spent importing the missed buffers
+        float importMs = 0.0f;
+    };
+
+    explicit CameraImportCache(uint32_t maxNumberOfCameraImages)
+        : mEntries(std::max(maxNumberOfCameraImages, 1u)) {}
+
+    // Returns the import of the camera input, calling importFn() to create it on a miss. This may
+    // evict the least recently used entry.
+    template <typename ImportFn>
+    std::shared_ptr<Import> get(AHardwareBuffer* cameraInput, ImportFn importFn) {
+        const uint64_t key = keyOf(cameraInput);
+        const uint64_t frame = mFrame++;
+        if (Entry* entry = mEntries.find(key)) {
+            entry->lastUseFrame = frame;
+            return entry->import;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        std::shared_ptr<Import> import = importFn();
+        const std::chrono::duration<float, std::milli> elapsed =
+                std::chrono::steady_clock::now() - start;
+        mImportMs += elapsed.count();
+        AHardwareBuffer_acquire(cameraInput);
+        Entry entry = {
+                .buffer = BufferReference(cameraInput, AHardwareBuffer_release),
+                .import = import,
+                .importMs = elapsed.count(),
+                .lastUseFrame = frame,
+        };
+        mEntries.insert(key, std::move(entry));
+        return import;
+    }
+
+    // Drops the entry of the camera input, if any
+    void release(AHardwareBuffer* cameraInput) {
+        if (mEntries.erase(keyOf(cameraInput))) {
+            mReleases++;
+        }
+    }
+
+    void clear() { mEntries.clear(); }
+
+    Stats stats() const {
+        const auto& lruStats = mEntries.stats();
+        return {
+                .hits = lruStats.hits,
+                .misses = lruStats.misses,
+                .evictions = lruStats.evictions,
+                .releases = mReleases,
+                .importMs = mImportMs,
+        };
+    }
+
+    // Logs the counters and the entries left, with the given name of the imports
+    void logStats(const char* name) const {
+        const Stats s = stats();
+        LOGI("%s cache: %llu hits, %llu misses, %llu evictions, %llu releases, %.2f ms importing",
+             name, static_cast<unsigned long long>(s.hits),
+             static_cast<unsigned long long>(s.misses),
+             static_cast<unsigned long long>(s.evictions),
+             static_cast<unsigned long long>(s.releases), s.importMs);
+        mEntries.forEach([this, name](uint64_t key, const Entry& entry) {
+            LOGI("%s cache entry %llu: imported in %.2f ms, last used %llu frames ago", name,
+                 static_cast<unsigned long long>(key), entry.importMs,
+                 static_cast<unsigned long long>(mFrame - 1 - entry.lastUseFrame));
+        });
+    }
+
+   private:
+    using BufferReference = std::unique_ptr<AHardwareBuffer, void (*)(AHardwareBuffer*)>;
+    struct Entry {
+        BufferReference buffer = {nullptr, AHardwareBuffer_release};
+        std::shared_ptr<Import> import;
+        float importMs = 0.0f;
+        // The number of get calls before the last one returning this entry
+        uint64_t lastUseFrame = 0;
+    };
+
+    static uint64_t keyOf(AHardwareBuffer* buffer) {
+        if (NdkFunctions::apiLevel() >= 31) {
+            uint64_t id;
+            CHECK(NdkFunctions::get().AHardwareBuffer_getId(buffer, &id) == 0);
+            return id;
+        }
+        return reinterpret_cast<uintptr_t>(buffer);
+    }
+
+    LruCache<uint64_t, Entry> mEntries;
+    uint64_t mFrame = 0;
+    uint64_t mReleases = 0;
+    float mImportMs = 0.0f;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CAMERA_IMPORT_CACHE_H
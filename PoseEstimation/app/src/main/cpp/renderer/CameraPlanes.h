@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CAMERA_PLANES_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CAMERA_PLANES_H
+
+#include <android/hardware_buffer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../Utils.h"
+
+namespace pose_estimation {
+
+// The planes of a locked YUV_420_888 camera image, packed into a single buffer for the compute
+// shaders with the raw YUV camera input
+struct CameraPlanesLayout {
+    // The bytes spanned by a plane, copied from data to offset in the buffer
+    struct Span {
+        const uint8_t* data;
+        size_t size;
+        size_t offset;
+    };
+    std::vector<Span> spans;
+    // The size of the buffer, every span starting at a multiple of 4 bytes
+    size_t bufferSize = 0;
+
+    // The uniforms of the shaders: the size of the Y plane, the offsets in bytes of the Y, U and V
+    // planes in the buffer, and the row stride of the Y plane followed by the row and pixel strides
+    // of the U and V planes
+    uint32_t cameraSize[2] = {};
+    uint32_t planeOffsets[3] = {};
+    uint32_t planeStrides[3] = {};
+};
+
+inline CameraPlanesLayout getCameraPlanesLayout(const AHardwareBuffer_Desc& desc,
+                                                const AHardwareBuffer_Planes& planes) {
+    CHECK(planes.planeCount == 3);
+    const AHardwareBuffer_Plane& yPlane = planes.planes[0];
+    const AHardwareBuffer_Plane& uPlane = planes.planes[1];
+    const AHardwareBuffer_Plane& vPlane = planes.planes[2];
+    CHECK(uPlane.rowStride == vPlane.rowStride && uPlane.pixelStride == vPlane.pixelStride);
+
+    // The bytes spanned by every plane. The U and V planes of the semi-planar layouts, e.g. NV21,
+    // are interleaved, so that a single span covers both of them.
+    const uint32_t chromaWidth = (desc.width + 1) / 2, chromaHeight = (desc.height + 1) / 2;
+    const auto* y = static_cast<const uint8_t*>(yPlane.data);
+    const auto* u = static_cast<const uint8_t*>(uPlane.data);
+    const auto* v = static_cast<const uint8_t*>(vPlane.data);
+    const size_t ySize = yPlane.rowStride * (desc.height - 1) + desc.width;
+    const size_t uvSize =
+            uPlane.rowStride * (chromaHeight - 1) + (chromaWidth - 1) * uPlane.pixelStride + 1;
+    CameraPlanesLayout layout;
+    layout.spans = {{y, ySize, 0}};
+    const uint8_t* uv = std::min(u, v);
+    if (uPlane.pixelStride == 2 && std::max(u, v) - uv == 1) {
+        layout.spans.push_back({uv, uvSize + 1, 0});
+    } else {
+        layout.spans.push_back({u, uvSize, 0});
+        layout.spans.push_back({v, uvSize, 0});
+    }
+    for (CameraPlanesLayout::Span& span : layout.spans) {
+        span.offset = layout.bufferSize;
+        layout.bufferSize += (span.size + 3) & ~size_t(3);
+    }
+
+    const CameraPlanesLayout::Span& uSpan = layout.spans[1];
+    const CameraPlanesLayout::Span& vSpan = layout.spans.back();
+    layout.cameraSize[0] = desc.width;
+    layout.cameraSize[1] = desc.height;
+    layout.planeOffsets[0] = 0;
+    layout.planeOffsets[1] = uSpan.offset + (u - uSpan.data);
+    layout.planeOffsets[2] = vSpan.offset + (v - vSpan.data);
+    layout.planeStrides[0] = yPlane.rowStride;
+    layout.planeStrides[1] = uPlane.rowStride;
+    layout.planeStrides[2] = uPlane.pixelStride;
+    return layout;
+}
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CAMERA_PLANES_H
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CpuRenderer.h"
+
+#include <android/hardware_buffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "../Trace.h"
+#include "../Utils.h"
+
+namespace pose_estimation {
+namespace {
+
+// The threads rendering a frame, including the calling thread. A few cores are left to the camera
+// and the ML executor.
+constexpr uint32_t kMaxThreads = 4;
+// The rows are claimed in chunks, to amortize the atomic increments
+constexpr uint32_t kRowsPerChunk = 8;
+
+// Full-range BT.601, as the YUV_420_888 camera images
+constexpr float kCrToR = 1.402f;
+constexpr float kCbToG = -0.344136f;
+constexpr float kCrToG = -0.714136f;
+constexpr float kCbToB = 1.772f;
+// Maps [0, 255] to [-1.0, 1.0]
+constexpr float kNormalizeScale = 2.0f / 255.0f;
+
+// The texels around a texture coordinate and their weights, clamped to the edges as the GPU
+// samplers of the camera texture
+struct BilinearTaps {
+    uint32_t x0, x1, y0, y1;
+    float fx, fy;
+};
+
+inline BilinearTaps computeTaps(float s, float t, uint32_t width, uint32_t height) {
+    const float x = std::clamp(s * width - 0.5f, 0.0f, width - 1.0f);
+    const float y = std::clamp(t * height - 0.5f, 0.0f, height - 1.0f);
+    const uint32_t x0 = static_cast<uint32_t>(x);
+    const uint32_t y0 = static_cast<uint32_t>(y);
+    return {
+            .x0 = x0,
+            .x1 = std::min(x0 + 1, width - 1),
+            .y0 = y0,
+            .y1 = std::min(y0 + 1, height - 1),
+            .fx = x - x0,
+            .fy = y - y0,
+    };
+}
+
+inline float sampleBilinear(const uint8_t* plane, uint32_t rowStride, uint32_t pixelStride,
+                            const BilinearTaps& taps) {
+    const uint8_t* row0 = plane + taps.y0 * rowStride;
+    const uint8_t* row1 = plane + taps.y1 * rowStride;
+    const uint32_t x0 = taps.x0 * pixelStride, x1 = taps.x1 * pixelStride;
+    const float top = row0[x0] + (row0[x1] - row0[x0]) * taps.fx;
+    const float bottom = row1[x0] + (row1[x1] - row1[x0]) * taps.fx;
+    return top + (bottom - top) * taps.fy;
+}
+
+// Samples the Y, U and V values of the output pixels of a row. The gathers do not vectorize, so
+// this is scalar.
+void sampleRow(const YuvImage& image, const float* transform, uint32_t row, float* y, float* u,
+               float* v) {
+    // The texture coordinate is transform * (fx, fy, 0, 1), with the column-major matrix of
+    // glUniformMatrix4fv
+    constexpr float kStep = 1.0f / (kRendererOutputWidth - 1);
+    const float fy = row * kStep;
+    const float sRow = transform[4] * fy + transform[12];
+    const float tRow = transform[5] * fy + transform[13];
+    const uint32_t chromaWidth = (image.width + 1) / 2, chromaHeight = (image.height + 1) / 2;
+    for (uint32_t x = 0; x < kRendererOutputWidth; x++) {
+        const float fx = x * kStep;
+        const float s = transform[0] * fx + sRow;
+        const float t = transform[1] * fx + tRow;
+        y[x] = sampleBilinear(image.y, image.yRowStride, 1,
+                              computeTaps(s, t, image.width, image.height));
+        const BilinearTaps chroma = computeTaps(s, t, chromaWidth, chromaHeight);
+        u[x] = sampleBilinear(image.u, image.uvRowStride, image.uvPixelStride, chroma);
+        v[x] = sampleBilinear(image.v, image.uvRowStride, image.uvPixelStride, chroma);
+    }
+}
+
+inline void convertPixel(float y, float u, float v, float* rgb) {
+    const float cb = u - 128.0f, cr = v - 128.0f;
+    const float colors[] = {y + kCrToR * cr, y + kCbToG * cb + kCrToG * cr, y + kCbToB * cb};
+    for (uint32_t c = 0; c < 3; c++) {
+        rgb[c] = std::clamp(colors[c], 0.0f, 255.0f) * kNormalizeScale - 1.0f;
+    }
+}
+
+// Converts count pixels from YUV to RGB normalized to [-1.0, 1.0], interleaved as the renderer
+// output
+void convertRow(const float* y, const float* u, const float* v, uint32_t count, float* rgb) {
+    uint32_t i = 0;
+#if defined(__ARM_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t max = vdupq_n_f32(255.0f);
+    const float32x4_t offset = vdupq_n_f32(128.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t luma = vld1q_f32(y + i);
+        const float32x4_t cb = vsubq_f32(vld1q_f32(u + i), offset);
+        const float32x4_t cr = vsubq_f32(vld1q_f32(v + i), offset);
+        float32x4x3_t colors;
+        colors.val[0] = vmlaq_n_f32(luma, cr, kCrToR);
+        colors.val[1] = vmlaq_n_f32(vmlaq_n_f32(luma, cb, kCbToG), cr, kCrToG);
+        colors.val[2] = vmlaq_n_f32(luma, cb, kCbToB);
+        for (auto& color : colors.val) {
+            color = vsubq_f32(vmulq_n_f32(vminq_f32(vmaxq_f32(color, zero), max), kNormalizeScale),
+                              one);
+        }
+        vst3q_f32(rgb + i * 3, colors);
+    }
+#elif defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max = _mm_set1_ps(255.0f);
+    const __m128 offset = _mm_set1_ps(128.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    auto normalize = [&](__m128 color) {
+        color = _mm_min_ps(_mm_max_ps(color, zero), max);
+        return _mm_sub_ps(_mm_mul_ps(color, _mm_set1_ps(kNormalizeScale)), one);
+    };
+    for (; i + 4 <= count; i += 4) {
+        const __m128 luma = _mm_loadu_ps(y + i);
+        const __m128 cb = _mm_sub_ps(_mm_loadu_ps(u + i), offset);
+        const __m128 cr = _mm_sub_ps(_mm_loadu_ps(v + i), offset);
+        const __m128 r = normalize(_mm_add_ps(luma, _mm_mul_ps(cr, _mm_set1_ps(kCrToR))));
+        const __m128 g = normalize(_mm_add_ps(_mm_add_ps(luma, _mm_mul_ps(cb, _mm_set1_ps(kCbToG))),
+                                              _mm_mul_ps(cr, _mm_set1_ps(kCrToG))));
+        const __m128 b = normalize(_mm_add_ps(luma, _mm_mul_ps(cb, _mm_set1_ps(kCbToB))));
+
+        // Interleave into r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3
+        const __m128 rgLow = _mm_unpacklo_ps(r, g);   // r0 g0 r1 g1
+        const __m128 rgHigh = _mm_unpackhi_ps(r, g);  // r2 g2 r3 g3
+        const __m128 b0r1 = _mm_shuffle_ps(b, rgLow, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 g1b1 = _mm_shuffle_ps(rgLow, b, _MM_SHUFFLE(1, 1, 3, 3));
+        const __m128 b2r3 = _mm_shuffle_ps(b, rgHigh, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 g3b3 = _mm_shuffle_ps(rgHigh, b, _MM_SHUFFLE(3, 3, 3, 3));
+        float* out = rgb + i * 3;
+        _mm_storeu_ps(out, _mm_shuffle_ps(rgLow, b0r1, _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(out + 4, _mm_shuffle_ps(g1b1, rgHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+        _mm_storeu_ps(out + 8, _mm_shuffle_ps(b2r3, g3b3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+#endif
+    for (; i < count; i++) {
+        convertPixel(y[i], u[i], v[i], rgb + i * 3);
+    }
+}
+
+}  // namespace
+
+CpuRenderer::CpuRenderer(PoseEstimationConfig config, const float* textureTransform)
+    : RendererBase(config), mTextureTransform(textureTransform, textureTransform + 16) {
+    LOGI("CpuRenderer::CpuRenderer");
+    if (mConfig.mlExecutor == MlExecutor::NATIVE_NNAPI_QUANT8) {
+        mOutputFormat = OutputFormat::QUANT8;
+    } else if (mConfig.float16RendererOutput) {
+        mOutputFormat = OutputFormat::FLOAT16;
+    }
+    mOutputBuffers.resize(mConfig.pipelineDepth, nullptr);
+
+    const uint32_t numberOfThreads =
+            std::clamp(std::thread::hardware_concurrency(), 1u, kMaxThreads);
+    for (uint32_t i = 1; i < numberOfThreads; i++) {
+        mWorkers.emplace_back(&CpuRenderer::workerLoop, this);
+    }
+    LOGI("CpuRenderer renders on %u threads", numberOfThreads);
+}
+
+CpuRenderer::~CpuRenderer() {
+    LOGI("CpuRenderer::~CpuRenderer");
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mCondition.notify_all();
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+void CpuRenderer::setOutputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) {
+    LOGI("CpuRenderer::setOutputFromHardwareBuffer");
+    CHECK(slot < mOutputBuffers.size());
+    mOutputBuffers[slot] = ahwb;
+}
+
+UniqueFd CpuRenderer::run(AHardwareBuffer* cameraInput, uint32_t slot,
+                          bool /*preferSyncFence*/) {
+    TRACE_SCOPE("CpuRenderer::run");
+    CHECK(slot < mOutputBuffers.size() && mOutputBuffers[slot] != nullptr);
+    AHardwareBuffer_Desc desc;
+    AHardwareBuffer_describe(cameraInput, &desc);
+    AHardwareBuffer_Planes planes;
+    CHECK(AHardwareBuffer_lockPlanes(cameraInput, AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN,
+                                     /*fence=*/-1, /*rect=*/nullptr, &planes) == 0);
+    if (planes.planeCount != 3 || planes.planes[0].pixelStride != 1 ||
+        planes.planes[1].pixelStride != planes.planes[2].pixelStride ||
+        planes.planes[1].rowStride != planes.planes[2].rowStride) {
+        LOG_FATAL("The camera image of format 0x%x is not YUV 4:2:0", desc.format);
+    }
+    const YuvImage image = {
+            .y = static_cast<const uint8_t*>(planes.planes[0].data),
+            .u = static_cast<const uint8_t*>(planes.planes[1].data),
+            .v = static_cast<const uint8_t*>(planes.planes[2].data),
+            .width = desc.width,
+            .height = desc.height,
+            .yRowStride = planes.planes[0].rowStride,
+            .uvRowStride = planes.planes[1].rowStride,
+            .uvPixelStride = planes.planes[1].pixelStride,
+    };
+
+    void* output = nullptr;
+    CHECK(AHardwareBuffer_lock(mOutputBuffers[slot], AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN,
+                               /*fence=*/-1, /*rect=*/nullptr, &output) == 0);
+    render(image, output);
+    CHECK(AHardwareBuffer_unlock(mOutputBuffers[slot], /*fence=*/nullptr) == 0);
+    CHECK(AHardwareBuffer_unlock(cameraInput, /*fence=*/nullptr) == 0);
+    return UniqueFd();
+}
+
+void CpuRenderer::setTextureTransform(const float* textureTransform) {
+    // The workers only read the transform within CpuRenderer::render
+    std::copy(textureTransform, textureTransform + 16, mTextureTransform.begin());
+}
+
+void CpuRenderer::render(const YuvImage& image, void* output) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mImage = &image;
+        mOutput = output;
+        mNextRow = 0;
+        mPendingWorkers = mWorkers.size();
+        mFrame++;
+    }
+    mCondition.notify_all();
+    renderRows();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [this] { return mPendingWorkers == 0; });
+    mImage = nullptr;
+    mOutput = nullptr;
+}
+
+void CpuRenderer::renderRows() {
+    TRACE_SCOPE("CpuRenderer::renderRows");
+    constexpr uint32_t kRowSize = kRendererOutputWidth * kRendererOutputChannels;
+    float y[kRendererOutputWidth], u[kRendererOutputWidth], v[kRendererOutputWidth];
+    float rgb[kRowSize];
+    while (true) {
+        const uint32_t begin = mNextRow.fetch_add(kRowsPerChunk);
+        if (begin >= kRendererOutputHeight) return;
+        const uint32_t end = std::min(begin + kRowsPerChunk, kRendererOutputHeight);
+        for (uint32_t row = begin; row < end; row++) {
+            sampleRow(*mImage, mTextureTransform.data(), row, y, u, v);
+            const uint32_t offset = row * kRowSize;
+            if (mOutputFormat == OutputFormat::FLOAT32) {
+                convertRow(y, u, v, kRendererOutputWidth, static_cast<float*>(mOutput) + offset);
+                continue;
+            }
+            convertRow(y, u, v, kRendererOutputWidth, rgb);
+            if (mOutputFormat == OutputFormat::FLOAT16) {
+                auto* out = static_cast<uint16_t*>(mOutput) + offset;
+                for (uint32_t i = 0; i < kRowSize; i++) out[i] = floatToFloat16(rgb[i]);
+            } else {
+                // As the GLES shader, see kRendererOutputQuant8Scale
+                auto* out = static_cast<uint8_t*>(mOutput) + offset;
+                for (uint32_t i = 0; i < kRowSize; i++) {
+                    const float quantized = std::round(rgb[i] / kRendererOutputQuant8Scale) +
+                                            kRendererOutputQuant8ZeroPoint;
+                    out[i] = static_cast<uint8_t>(std::clamp(quantized, 0.0f, 255.0f));
+                }
+            }
+        }
+    }
+}
+
+void CpuRenderer::workerLoop() {
+    uint64_t frame = 0;
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mCondition.wait(lock, [this, frame] { return mFrame != frame || mStopping; });
+        if (mStopping) return;
+        frame = mFrame;
+
+        lock.unlock();
+        renderRows();
+        lock.lock();
+
+        if (--mPendingWorkers == 0) mCondition.notify_all();
+    }
+}
+
+}  // namespace pose_estimation
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CPU_RENDERER_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CPU_RENDERER_H
+
+#include <android/hardware_buffer.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../PoseEstimationConfig.h"
+#include "../Utils.h"
+#include "RendererBase.h"
+
+namespace pose_estimation {
+
+// The planes of a YUV 4:2:0 camera image, with the chroma planes subsampled by 2 along both
+// dimensions
+struct YuvImage {
+    const uint8_t* y = nullptr;
+    const uint8_t* u = nullptr;
+    const uint8_t* v = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t yRowStride = 0;
+    uint32_t uvRowStride = 0;
+    // 1 for planar chroma, 2 for interleaved chroma as in NV12 and NV21
+    uint32_t uvPixelStride = 1;
+};
+
+// Preprocesses the camera frames on the CPU, as the compute shaders do on the GPU: the camera image
+// is resampled through the texture transform with bilinear filtering and clamping to the edges,
+// converted from full-range BT.601 YUV to RGB, and normalized to [-1.0, 1.0]. The output is fp32,
+// fp16 or quant8 as for the GLES renderer.
+//
+// This runs without a GPU, e.g. on the host, and serves as the reference of the GPU renderers.
+// The rows are split across worker threads, and the color conversion is vectorized. The camera
+// AHardwareBuffers must be lockable for CPU reads, e.g. from an ImageReader of YUV_420_888 images
+// with HardwareBuffer.USAGE_CPU_READ_OFTEN, and the outputs for CPU writes.
+class CpuRenderer : public RendererBase {
+   public:
+    CpuRenderer(PoseEstimationConfig config, const float* textureTransform);
+    ~CpuRenderer() override;
+
+    void setOutputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) override;
+
+    // Renders synchronously, so never returns a sync fence
+    UniqueFd run(AHardwareBuffer* cameraInput, uint32_t slot, bool preferSyncFence) override;
+
+    void setTextureTransform(const float* textureTransform) override;
+
+    // Renders the camera image to the output in the format of the config
+    void render(const YuvImage& image, void* output);
+
+   private:
+    enum class OutputFormat { FLOAT32, FLOAT16, QUANT8 };
+
+    // Renders the rows left in the current frame, on the calling thread and the workers alike
+    void renderRows();
+    void workerLoop();
+
+    OutputFormat mOutputFormat = OutputFormat::FLOAT32;
+    std::vector<float> mTextureTransform;
+    std::vector<AHardwareBuffer*> mOutputBuffers;
+
+    // The frame being rendered, read by the workers while mPendingWorkers is not 0
+    const YuvImage* mImage = nullptr;
+    void* mOutput = nullptr;
+    // The next row to render of the current frame
+    std::atomic<uint32_t> mNextRow = 0;
+
+    std::vector<std::thread> mWorkers;
+    // Guards the frame counter, mPendingWorkers and mStopping
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    uint64_t mFrame = 0;
+    uint32_t mPendingWorkers = 0;
+    bool mStopping = false;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_CPU_RENDERER_H
@@ -18,12 +18,16 @@
 
 #include <android/hardware_buffer.h>
 
+#include <algorithm>
 #include <cmath>
-#include <optional>
+#include <cstring>
+#include <memory>
 #include <utility>
+#include <vector>
 
-#include "../NdkFunctions.h"
+#include "../Trace.h"
 #include "../Utils.h"
+#include "CameraPlanes.h"
 #include "GlUtils.h"
 
 namespace pose_estimation {
@@ -34,35 +38,121 @@ const char* kComputeShaderHeader = R"glsl(#version 310 es
 #extension GL_OES_EGL_image_external_essl3 : require
 )glsl";
 
+// With QUANT8_OUTPUT, the colors are written as TENSOR_QUANT8_ASYMM with the scale and zero point
+// of kRendererOutputQuant8Scale and kRendererOutputQuant8ZeroPoint, for the quantized model. With
+// FLOAT16_OUTPUT, they are written as TENSOR_FLOAT16, see PoseEstimationConfig. With RAW_YUV_INPUT,
+// the camera planes are read from a buffer and converted to RGB by the shader, as CpuRenderer does.
 const char* kComputeShaderBody = R"glsl(
 layout (local_size_x = WORK_GROUP_SIZE_X, local_size_y = WORK_GROUP_SIZE_Y) in;
 
 layout (std430, binding=0) buffer Output {
+#if defined(QUANT8_OUTPUT) || defined(FLOAT16_OUTPUT)
+    uint data[];
+#else
     float data[];
+#endif
 } outputBuffer;
 
+#ifdef RAW_YUV_INPUT
+// The bytes of the camera planes, see GlComputeRenderer::uploadCameraPlanes
+layout (std430, binding=1) readonly buffer CameraPlanes {
+    uint data[];
+} cameraPlanes;
+
+// The size of the Y plane, the offsets in bytes of the Y, U and V planes, and the row stride of
+// the Y plane followed by the row and pixel strides of the U and V planes
+uniform uvec2 cameraSize;
+uniform uvec3 planeOffsets;
+uniform uvec3 planeStrides;
+
+float readByte(uint offset) {
+    return float((cameraPlanes.data[offset >> 2u] >> ((offset & 3u) * 8u)) & 0xffu);
+}
+
+// Bilinearly sample a plane, clamped to the edges as the texture sampler does
+float samplePlane(uint offset, uint rowStride, uint pixelStride, uvec2 size, vec2 texCoord) {
+    vec2 position = clamp(texCoord * vec2(size) - 0.5, vec2(0.0), vec2(size - 1u));
+    uvec2 p0 = uvec2(position);
+    uvec2 p1 = min(p0 + 1u, size - 1u);
+    vec2 weight = position - vec2(p0);
+    uint row0 = offset + p0.y * rowStride;
+    uint row1 = offset + p1.y * rowStride;
+    float top = mix(readByte(row0 + p0.x * pixelStride), readByte(row0 + p1.x * pixelStride),
+                    weight.x);
+    float bottom = mix(readByte(row1 + p0.x * pixelStride), readByte(row1 + p1.x * pixelStride),
+                       weight.x);
+    return mix(top, bottom, weight.y);
+}
+#else
 uniform samplerExternalOES cameraTexture;
+#endif
 uniform mat4 textureTransform;
 
-void main() {
-    if (gl_GlobalInvocationID.x >= 257u || gl_GlobalInvocationID.y >= 257u) return;
-
+// Sample the color of an output pixel, normalized to [-1.0, 1.0]
+vec3 sampleColor(uint x, uint y) {
     // Compute the texture coordinate
-    float fx = float(gl_GlobalInvocationID.x) / 256.0;
-    float fy = float(gl_GlobalInvocationID.y) / 256.0;
+    float fx = float(x) / 256.0;
+    float fy = float(y) / 256.0;
     vec2 texCoord = (textureTransform * vec4(fx, fy, 0.0, 1.0)).xy;
 
+#ifdef RAW_YUV_INPUT
+    // Sample the planes at the texture coordinate, and convert the full range BT.601 YUV to RGB
+    uvec2 chromaSize = (cameraSize + 1u) / 2u;
+    float luma = samplePlane(planeOffsets.x, planeStrides.x, 1u, cameraSize, texCoord);
+    float cb = samplePlane(planeOffsets.y, planeStrides.y, planeStrides.z, chromaSize, texCoord);
+    float cr = samplePlane(planeOffsets.z, planeStrides.y, planeStrides.z, chromaSize, texCoord);
+    cb -= 128.0;
+    cr -= 128.0;
+    vec3 rgb = vec3(luma + 1.402 * cr, luma - 0.344136 * cb - 0.714136 * cr, luma + 1.772 * cb);
+
+    // Normalize the color from [0.0, 255.0] to [-1.0, 1.0]
+    return clamp(rgb, 0.0, 255.0) * (2.0 / 255.0) - 1.0;
+#else
     // Sample the color at the texture coordinate, resulting in a RGBA vector with range [0.0, 1.0]
     vec4 color = texture(cameraTexture, texCoord);
 
     // Normalize the color to [-1.0, 1.0]
-    color = color * 2.0 - 1.0;
+    return color.rgb * 2.0 - 1.0;
+#endif
+}
+
+void main() {
+    if (gl_GlobalInvocationID.x >= 257u || gl_GlobalInvocationID.y >= 257u) return;
+
+#if defined(QUANT8_OUTPUT) || defined(FLOAT16_OUTPUT)
+    // GLES has no 8-bit or 16-bit storage, so every invocation writes whole 32-bit words holding 4
+    // consecutive channels, which span at most 2 pixels: one word of quantized channels, or two
+    // words of half-precision ones. Only the first 3/4 of the invocations have channels to write.
+    uint group = gl_GlobalInvocationID.y * 257u + gl_GlobalInvocationID.x;
+    if (group * 4u >= 257u * 257u * 3u) return;
+    uint firstPixel = group * 4u / 3u;
+    vec3 colors[2];
+    for (uint i = 0u; i < 2u; i++) {
+        uint pixel = min(firstPixel + i, 257u * 257u - 1u);
+        colors[i] = sampleColor(pixel % 257u, pixel / 257u);
+    }
+    vec4 values;
+    for (uint i = 0u; i < 4u; i++) {
+        uint channel = group * 4u + i;
+        values[i] = colors[channel / 3u - firstPixel][channel % 3u];
+    }
+#ifdef QUANT8_OUTPUT
+    uvec4 quantized = uvec4(clamp(round(values * 128.0) + 128.0, 0.0, 255.0));
+    outputBuffer.data[group] =
+            quantized.x | (quantized.y << 8u) | (quantized.z << 16u) | (quantized.w << 24u);
+#else
+    outputBuffer.data[group * 2u] = packHalf2x16(values.xy);
+    outputBuffer.data[group * 2u + 1u] = packHalf2x16(values.zw);
+#endif
+#else
+    vec3 color = sampleColor(gl_GlobalInvocationID.x, gl_GlobalInvocationID.y);
 
     // Write rgb colors to the output buffer
     int index = (int(gl_GlobalInvocationID.y) * 257 + int(gl_GlobalInvocationID.x)) * 3;
     outputBuffer.data[index] = color.r;
     outputBuffer.data[index + 1] = color.g;
     outputBuffer.data[index + 2] = color.b;
+#endif
 }
 )glsl";
 
@@ -123,8 +213,19 @@ inline GLuint compileShader(GLenum type, const char* header, const char* body,
 
 }  // namespace
 
+GlCameraImage::GlCameraImage(EGLDisplay display, AHardwareBuffer* buffer) : mDisplay(display) {
+    EGLClientBuffer eglBuffer = eglGetNativeClientBufferANDROID(buffer);
+    CHECK(eglBuffer != nullptr);
+    EGLint attrs[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+    mImage = eglCreateImageKHR(mDisplay, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID, eglBuffer,
+                               attrs);
+    CHECK(mImage != EGL_NO_IMAGE_KHR);
+}
+
+GlCameraImage::~GlCameraImage() { CHECK(eglDestroyImageKHR(mDisplay, mImage)); }
+
 GlComputeRenderer::GlComputeRenderer(PoseEstimationConfig config, const float* textureTransform)
-    : RendererBase(config) {
+    : RendererBase(config), mCachedCameraImages(config.maxNumberOfCameraImages) {
     LOGI("GlComputeRenderer::GlComputeRenderer");
 
     // Initialize EGL
@@ -170,12 +271,22 @@ GlComputeRenderer::GlComputeRenderer(PoseEstimationConfig config, const float* t
     checkGLError("Initialize GL");
 
     // Compile shader program
+    std::map<std::string, std::string> defines = {
+            {"WORK_GROUP_SIZE_X", std::to_string(mWorkGroupSize)},
+            {"WORK_GROUP_SIZE_Y", std::to_string(mWorkGroupSize)},
+    };
+    if (mConfig.mlExecutor == MlExecutor::NATIVE_NNAPI_QUANT8) {
+        static_assert(kRendererOutputQuant8Scale == 1.0f / 128.0f &&
+                      kRendererOutputQuant8ZeroPoint == 128);
+        defines["QUANT8_OUTPUT"] = "1";
+    } else if (mConfig.float16RendererOutput) {
+        defines["FLOAT16_OUTPUT"] = "1";
+    }
+    if (mConfig.rawYuvCameraInput) {
+        defines["RAW_YUV_INPUT"] = "1";
+    }
     unsigned int computeShader =
-            compileShader(GL_COMPUTE_SHADER, kComputeShaderHeader, kComputeShaderBody,
-                          {
-                                  {"WORK_GROUP_SIZE_X", std::to_string(mWorkGroupSize)},
-                                  {"WORK_GROUP_SIZE_Y", std::to_string(mWorkGroupSize)},
-                          });
+            compileShader(GL_COMPUTE_SHADER, kComputeShaderHeader, kComputeShaderBody, defines);
     mProgram = glCreateProgram();
     glAttachShader(mProgram, computeShader);
     glLinkProgram(mProgram);
@@ -191,42 +302,67 @@ GlComputeRenderer::GlComputeRenderer(PoseEstimationConfig config, const float* t
     glUseProgram(mProgram);
     checkGLError("Compile program");
 
-    // Create input camera texture
-    glGenTextures(1, &mCameraTexture);
-    glBindTexture(GL_TEXTURE_EXTERNAL_OES, mCameraTexture);
-    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+    // Create input camera texture, or the buffers of the raw camera planes
+    if (mConfig.rawYuvCameraInput) {
+        mCameraPlaneBuffers.resize(config.pipelineDepth);
+        mCameraPlaneBufferSizes.resize(config.pipelineDepth, 0);
+        glGenBuffers(mCameraPlaneBuffers.size(), mCameraPlaneBuffers.data());
+    } else {
+        glGenTextures(1, &mCameraTexture);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, mCameraTexture);
+        glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_EXTERNAL_OES, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+    }
     checkGLError("Create input camera texture");
 
-    // Create output buffer
-    glGenBuffers(1, &mOutputBuffer);
+    // Create output buffers
+    mOutputBuffers.resize(config.pipelineDepth);
+    glGenBuffers(mOutputBuffers.size(), mOutputBuffers.data());
+    mCameraImagesInFlight.resize(config.pipelineDepth);
+
+    // Create timestamp queries
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    mSupportsTimerQuery =
+            extensions != nullptr && strstr(extensions, "GL_EXT_disjoint_timer_query") != nullptr;
+    if (mSupportsTimerQuery) {
+        mTimestampQueries.resize(config.pipelineDepth * 2);
+        glGenQueriesEXT(mTimestampQueries.size(), mTimestampQueries.data());
+    }
+    LOGI("GPU timestamps are %ssupported", mSupportsTimerQuery ? "" : "not ");
+    mFrameTimestamps.resize(config.pipelineDepth);
+    checkGLError("Create timestamp queries");
 
     // Set uniform values
-    GLint cameraTextureLocation = glGetUniformLocation(mProgram, "cameraTexture");
-    glUniform1i(cameraTextureLocation, 0);
-    GLint textureTransformLocation = glGetUniformLocation(mProgram, "textureTransform");
-    glUniformMatrix4fv(textureTransformLocation, 1, GL_FALSE, textureTransform);
+    mTextureTransformLocation = glGetUniformLocation(mProgram, "textureTransform");
+    glUniformMatrix4fv(mTextureTransformLocation, 1, GL_FALSE, textureTransform);
+    if (mConfig.rawYuvCameraInput) {
+        mCameraSizeLocation = glGetUniformLocation(mProgram, "cameraSize");
+        mPlaneOffsetsLocation = glGetUniformLocation(mProgram, "planeOffsets");
+        mPlaneStridesLocation = glGetUniformLocation(mProgram, "planeStrides");
+    }
     checkGLError("Set uniform values");
 
     // Prepare for compute
     glUseProgram(mProgram);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_EXTERNAL_OES, mCameraTexture);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mOutputBuffer);
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, /*index=*/0, mOutputBuffer);
-    glUniform1i(cameraTextureLocation, 0);
+    if (!mConfig.rawYuvCameraInput) {
+        GLint cameraTextureLocation = glGetUniformLocation(mProgram, "cameraTexture");
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, mCameraTexture);
+        glUniform1i(cameraTextureLocation, 0);
+    }
     checkGLError("Prepare for compute");
 }
 
-void GlComputeRenderer::setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) {
+void GlComputeRenderer::setOutputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) {
     LOGI("GlComputeRenderer::setOutputFromHardwareBuffer");
+    CHECK(slot < mOutputBuffers.size());
     AHardwareBuffer_Desc desc;
     AHardwareBuffer_describe(ahwb, &desc);
     EGLClientBuffer clientBuffer = eglGetNativeClientBufferANDROID(ahwb);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mOutputBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mOutputBuffers[slot]);
     glBufferStorageExternalEXT(GL_SHADER_STORAGE_BUFFER, 0, desc.width, clientBuffer,
                                GL_DYNAMIC_STORAGE_BIT_EXT);
     checkGLError("setOutputFromHardwareBuffer");
@@ -234,84 +370,147 @@ void GlComputeRenderer::setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) {
 
 GlComputeRenderer::~GlComputeRenderer() {
     LOGI("GlComputeRenderer::~GlComputeRenderer");
-    for (const auto& [_, eglImage] : mCachedCameraEglImages) {
-        CHECK(eglDestroyImageKHR(mEglDisplay, eglImage));
+    if (!mConfig.rawYuvCameraInput) {
+        mCachedCameraImages.logStats("EGL image");
     }
-    if (mCameraEglImageWithoutId != EGL_NO_IMAGE_KHR) {
-        CHECK(eglDestroyImageKHR(mEglDisplay, mCameraEglImageWithoutId));
+    mCachedCameraImages.clear();
+    mCameraImagesInFlight.clear();
+    if (mSupportsTimerQuery) {
+        glDeleteQueriesEXT(mTimestampQueries.size(), mTimestampQueries.data());
     }
     glDeleteTextures(1, &mCameraTexture);
-    glDeleteBuffers(1, &mOutputBuffer);
+    glDeleteBuffers(mCameraPlaneBuffers.size(), mCameraPlaneBuffers.data());
+    glDeleteBuffers(mOutputBuffers.size(), mOutputBuffers.data());
     glDeleteProgram(mProgram);
+
+    // Release the context, selectCameraPreprocessing creates several renderers in a row
+    CHECK(eglMakeCurrent(mEglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+    CHECK(eglDestroySurface(mEglDisplay, mEglSurface));
+    CHECK(eglDestroyContext(mEglDisplay, mEglContext));
 }
 
-EGLImageKHR GlComputeRenderer::getCameraEglImage(AHardwareBuffer* cameraInput) {
-    // Cleanup any EGL image without a cache ID
-    if (mCameraEglImageWithoutId != EGL_NO_IMAGE_KHR) {
-        CHECK(eglDestroyImageKHR(mEglDisplay, mCameraEglImageWithoutId));
-    }
+EGLImageKHR GlComputeRenderer::getCameraEglImage(AHardwareBuffer* cameraInput, uint32_t slot) {
+    // The frame previously rendered on this slot has finished, release its EGL image, unless it
+    // is still cached
+    std::shared_ptr<GlCameraImage>& image = mCameraImagesInFlight[slot];
+    image = mCachedCameraImages.get(cameraInput, [this, cameraInput] {
+        return std::make_shared<GlCameraImage>(mEglDisplay, cameraInput);
+    });
+    return image->image();
+}
 
-    // Get the system wide unique ID for an AHardwareBuffer if supported
-    std::optional<uint64_t> maybeAhwbId;
-    if (NdkFunctions::apiLevel() >= 31) {
-        uint64_t ahwbId;
-        CHECK(NdkFunctions::get().AHardwareBuffer_getId(cameraInput, &ahwbId) == 0);
-        maybeAhwbId = ahwbId;
-    }
+void GlComputeRenderer::onCameraBufferReleased(AHardwareBuffer* cameraInput) {
+    mCachedCameraImages.release(cameraInput);
+}
 
-    // If cache hit, used the cache directly
-    auto cachedEglImage =
-            maybeAhwbId ? mCachedCameraEglImages.find(*maybeAhwbId) : mCachedCameraEglImages.end();
-    if (cachedEglImage != mCachedCameraEglImages.end()) {
-        return cachedEglImage->second;
+void GlComputeRenderer::setTextureTransform(const float* textureTransform) {
+    // The program stays in use on the context, so the uniform is simply replaced
+    glUniformMatrix4fv(mTextureTransformLocation, 1, GL_FALSE, textureTransform);
+    checkGLError("GlComputeRenderer::setTextureTransform");
+}
+
+void GlComputeRenderer::uploadCameraPlanes(AHardwareBuffer* cameraInput, uint32_t slot) {
+    TRACE_SCOPE("GlComputeRenderer::uploadCameraPlanes");
+    AHardwareBuffer_Desc desc;
+    AHardwareBuffer_describe(cameraInput, &desc);
+    AHardwareBuffer_Planes planes;
+    CHECK(AHardwareBuffer_lockPlanes(cameraInput, AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN, -1,
+                                     nullptr, &planes) == 0);
+    const CameraPlanesLayout layout = getCameraPlanesLayout(desc, planes);
+
+    // GLES cannot import a YUV AHardwareBuffer as a buffer, so the planes are copied through the
+    // CPU mapping
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, mCameraPlaneBuffers[slot]);
+    if (mCameraPlaneBufferSizes[slot] != layout.bufferSize) {
+        glBufferData(GL_SHADER_STORAGE_BUFFER, layout.bufferSize, nullptr, GL_STREAM_DRAW);
+        mCameraPlaneBufferSizes[slot] = layout.bufferSize;
     }
+    for (const CameraPlanesLayout::Span& span : layout.spans) {
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, span.offset, span.size, span.data);
+    }
+    CHECK(AHardwareBuffer_unlock(cameraInput, nullptr) == 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, /*index=*/1, mCameraPlaneBuffers[slot]);
 
-    // Import the camera input AHardwareBuffer to GLES
-    EGLClientBuffer eglBuffer = eglGetNativeClientBufferANDROID(cameraInput);
-    CHECK(eglBuffer != nullptr);
-    EGLint attrs[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
-    EGLImageKHR eglImage = eglCreateImageKHR(mEglDisplay, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID,
-                                             eglBuffer, attrs);
-    CHECK(eglImage != EGL_NO_IMAGE_KHR);
+    glUniform2uiv(mCameraSizeLocation, 1, layout.cameraSize);
+    glUniform3uiv(mPlaneOffsetsLocation, 1, layout.planeOffsets);
+    glUniform3uiv(mPlaneStridesLocation, 1, layout.planeStrides);
+    checkGLError("uploadCameraPlanes");
+}
+
+UniqueFd GlComputeRenderer::run(AHardwareBuffer* cameraInput, uint32_t slot,
+                                bool preferSyncFence) {
+    TRACE_SCOPE("GlComputeRenderer::run");
+    CHECK(slot < mOutputBuffers.size());
 
-    if (maybeAhwbId) {
-        // Cache the EGL image if we have the unique ID
-        mCachedCameraEglImages.emplace(*maybeAhwbId, eglImage);
+    // Update the camera input, either the raw planes or the imported EGL image of the texture
+    if (mConfig.rawYuvCameraInput) {
+        uploadCameraPlanes(cameraInput, slot);
     } else {
-        // Otherwise, we still need to record the EGL image because we have to destroy it in the
-        // next run
-        mCameraEglImageWithoutId = eglImage;
+        glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, getCameraEglImage(cameraInput, slot));
     }
-    return eglImage;
-}
 
-UniqueFd GlComputeRenderer::run(AHardwareBuffer* cameraInput, bool preferSyncFence) {
-    // Create or get the imported EGL image for camera input texture
-    EGLImageKHR eglImage = getCameraEglImage(cameraInput);
-
-    // Update the camera input texture
-    glEGLImageTargetTexture2DOES(GL_TEXTURE_EXTERNAL_OES, eglImage);
+    // Bind the output buffer of the slot
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, /*index=*/0, mOutputBuffers[slot]);
+
+    // Correlate the GPU clock with CLOCK_MONOTONIC
+    FrameTimestamps& timestamps = mFrameTimestamps[slot];
+    timestamps = {};
+    if (mSupportsTimerQuery) {
+        GLint64 gpuTimeNs;
+        glGetInteger64v(GL_TIMESTAMP_EXT, &gpuTimeNs);
+        timestamps.gpuToMonotonicOffsetNs = monotonicTimeNs() - gpuTimeNs;
+        glQueryCounterEXT(mTimestampQueries[slot * 2], GL_TIMESTAMP_EXT);
+    }
 
     // Dispatch compute
     const uint32_t groupCountX = (kRendererOutputWidth + mWorkGroupSize - 1) / mWorkGroupSize;
     const uint32_t groupCountY = (kRendererOutputHeight + mWorkGroupSize - 1) / mWorkGroupSize;
     glDispatchCompute(groupCountX, groupCountY, 1);
+    if (mSupportsTimerQuery) {
+        glQueryCounterEXT(mTimestampQueries[slot * 2 + 1], GL_TIMESTAMP_EXT);
+    }
 
     // For ExecutionMode::FENCED, export a Android sync fence FD and immediately return;
     // otherwise, wait until everything is finished
+    // The work is submitted to the GPU by glFlush or glFinish
     UniqueFd syncFenceFd;
+    timestamps.submittedNs = monotonicTimeNs();
     if (preferSyncFence && supportsAndroidSyncFence()) {
         EGLSyncKHR sync = eglCreateSyncKHR(mEglDisplay, EGL_SYNC_NATIVE_FENCE_ANDROID, nullptr);
         CHECK(sync != EGL_NO_SYNC_KHR);
         glFlush();
         syncFenceFd = UniqueFd(eglDupNativeFenceFD(mEglDisplay, sync));
         CHECK(eglDestroySyncKHR(mEglDisplay, sync));
+        timestamps.syncFence = UniqueFd(dup(syncFenceFd.get()));
     } else {
+        TRACE_SCOPE("glFinish");
         glFinish();
+        timestamps.waitFinishedNs = monotonicTimeNs();
     }
 
     checkGLError("GlComputeRenderer::run");
     return syncFenceFd;
 }
 
+RenderTiming GlComputeRenderer::getTiming(uint32_t slot) {
+    CHECK(slot < mFrameTimestamps.size());
+    FrameTimestamps& timestamps = mFrameTimestamps[slot];
+    if (mSupportsTimerQuery && timestamps.submittedNs != 0) {
+        GLuint64 gpuStartNs, gpuEndNs;
+        glGetQueryObjectui64vEXT(mTimestampQueries[slot * 2], GL_QUERY_RESULT_EXT, &gpuStartNs);
+        glGetQueryObjectui64vEXT(mTimestampQueries[slot * 2 + 1], GL_QUERY_RESULT_EXT, &gpuEndNs);
+
+        // The timestamps are meaningless if e.g. the GPU frequency has changed in between. Reading
+        // the disjoint state clears it, so with several frames in flight, a disjoint operation
+        // only discards the timestamps of the first frame finished after it.
+        GLint disjoint;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        timestamps.hasGpuTimestamps = !disjoint;
+        timestamps.gpuStartNs = gpuStartNs;
+        timestamps.gpuEndNs = gpuEndNs;
+        checkGLError("GlComputeRenderer::getTiming");
+    }
+    return timestamps.computeRenderTiming();
+}
+
 }  // namespace pose_estimation
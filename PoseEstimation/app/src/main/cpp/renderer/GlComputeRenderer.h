@@ -19,25 +19,52 @@
 
 #include <android/hardware_buffer.h>
 
-#include <map>
+#include <memory>
+#include <vector>
 
 #include "../PoseEstimationConfig.h"
+#include "CameraImportCache.h"
 #include "GlUtils.h"
+#include "RenderTiming.h"
 #include "RendererBase.h"
 
 namespace pose_estimation {
 
+// An EGL image imported from a camera AHardwareBuffer
+class GlCameraImage {
+    DISABLE_COPY_AND_ASSIGN(GlCameraImage);
+
+   public:
+    GlCameraImage(EGLDisplay display, AHardwareBuffer* buffer);
+    ~GlCameraImage();
+
+    EGLImageKHR image() const { return mImage; }
+
+   private:
+    EGLDisplay mDisplay;
+    EGLImageKHR mImage = EGL_NO_IMAGE_KHR;
+};
+
 class GlComputeRenderer : public RendererBase {
    public:
     GlComputeRenderer(PoseEstimationConfig config, const float* textureTransform);
     ~GlComputeRenderer() override;
 
-    void setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) override;
+    void setOutputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) override;
+
+    UniqueFd run(AHardwareBuffer* cameraInput, uint32_t slot, bool preferSyncFence) override;
+
+    RenderTiming getTiming(uint32_t slot) override;
+
+    void onCameraBufferReleased(AHardwareBuffer* cameraInput) override;
 
-    UniqueFd run(AHardwareBuffer* cameraInput, bool preferSyncFence) override;
+    void setTextureTransform(const float* textureTransform) override;
 
    private:
-    EGLImageKHR getCameraEglImage(AHardwareBuffer* cameraInput);
+    EGLImageKHR getCameraEglImage(AHardwareBuffer* cameraInput, uint32_t slot);
+    // With mConfig.rawYuvCameraInput, copies the planes of the camera input to the buffer of the
+    // slot and sets their layout in the uniforms
+    void uploadCameraPlanes(AHardwareBuffer* cameraInput, uint32_t slot);
     bool supportsAndroidSyncFence() const { return mPfnEglDupNativeFenceFDANDROID != nullptr; }
     int eglDupNativeFenceFD(EGLDisplay display, EGLSyncKHR sync) const {
         CHECK(mPfnEglDupNativeFenceFDANDROID != nullptr);
@@ -57,22 +84,34 @@ class GlComputeRenderer : public RendererBase {
 
     // Shader program
     GLint mProgram = 0;
+    GLint mTextureTransformLocation = -1;
 
     // Camera input
     GLuint mCameraTexture = 0;
-    // A map of {unique_ahwb_id -> imported_egl_image}.
-    // We will cache the imported EGL image if the unique AHardwareBuffer ID is available, so that
-    // we can avoid the overhead of importing AHardwareBuffer to GLES again when the same
-    // AHardwareBuffer is reused for another camera frame.
-    std::map<uint64_t, EGLImageKHR> mCachedCameraEglImages;
-    // If the unique AHardwareBuffer ID is not available, we have to import the AHardwareBuffer in
-    // every GlComputeRenderer::run. The imported EGL image will be held here because we want its
-    // lifetime to outlive GlComputeRenderer::run for fenced execution. It will be cleaned up at the
-    // beginning of the next GlComputeRenderer::run.
-    EGLImageKHR mCameraEglImageWithoutId = EGL_NO_IMAGE_KHR;
-
-    // Output
-    GLuint mOutputBuffer = 0;
+    // With mConfig.rawYuvCameraInput, the camera planes are read from a buffer per slot instead,
+    // resized when the layout of the camera frames changes
+    std::vector<GLuint> mCameraPlaneBuffers;
+    std::vector<size_t> mCameraPlaneBufferSizes;
+    GLint mCameraSizeLocation = -1;
+    GLint mPlaneOffsetsLocation = -1;
+    GLint mPlaneStridesLocation = -1;
+    // The EGL images imported for the camera inputs, so that the same AHardwareBuffer is not
+    // imported to GLES again when it is reused for another camera frame
+    CameraImportCache<GlCameraImage> mCachedCameraImages;
+    // The EGL image last sampled on each slot. Its lifetime must outlive GlComputeRenderer::run
+    // for fenced execution, even if it is evicted from the cache. It will be released at the
+    // beginning of the next GlComputeRenderer::run on the same slot.
+    std::vector<std::shared_ptr<GlCameraImage>> mCameraImagesInFlight;
+
+    // Output buffers, one per slot
+    std::vector<GLuint> mOutputBuffers;
+
+    // GPU timestamps, only recorded if GL_EXT_disjoint_timer_query is supported
+    bool mSupportsTimerQuery = false;
+    // Two timestamp queries per slot, before and after the dispatch
+    std::vector<GLuint> mTimestampQueries;
+    // The timestamps of the frame last rendered on each slot
+    std::vector<FrameTimestamps> mFrameTimestamps;
 };
 
 }  // namespace pose_estimation
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_LRU_CACHE_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_LRU_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "../Utils.h"
+
+namespace pose_estimation {
+
+// A map with a bounded number of entries that evicts the least recently used entry on overflow.
+//
+// The renderers use it to cache the GPU resources imported for each camera AHardwareBuffer, keyed
+// by the AHardwareBuffer ID. The camera reuses a small set of buffers, but reallocates them e.g.
+// on a resolution change, so an unbounded cache would keep the resources of stale buffers forever.
+// Evicted values are destroyed right away, so a value still in use by the GPU must be kept alive
+// by another reference, e.g. a std::shared_ptr held until the frame has finished.
+template <typename Key, typename Value>
+class LruCache {
+    DISABLE_COPY_AND_ASSIGN(LruCache);
+
+   public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    explicit LruCache(size_t capacity) : mCapacity(capacity) { CHECK(capacity > 0); }
+
+    // Returns the value of the key and marks it as the most recently used, or nullptr if absent.
+    // The returned pointer is valid until the next insert, erase or clear.
+    Value* find(const Key& key) {
+        auto it = mIndex.find(key);
+        if (it == mIndex.end()) {
+            mStats.misses++;
+            return nullptr;
+        }
+        mStats.hits++;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return &it->second->second;
+    }
+
+    // Inserts a value for a key that is not in the cache, evicting the least recently used entry
+    // if the cache is full
+    Value& insert(const Key& key, Value value) {
+        CHECK(mIndex.count(key) == 0);
+        if (mEntries.size() == mCapacity) {
+            mIndex.erase(mEntries.back().first);
+            mEntries.pop_back();
+            mStats.evictions++;
+        }
+        mEntries.emplace_front(key, std::move(value));
+        mIndex.emplace(key, mEntries.begin());
+        return mEntries.front().second;
+    }
+
+    // Removes the entry of the key, returns false if absent
+    bool erase(const Key& key) {
+        auto it = mIndex.find(key);
+        if (it == mIndex.end()) {
+            return false;
+        }
+        mEntries.erase(it->second);
+        mIndex.erase(it);
+        return true;
+    }
+
+    void clear() {
+        mIndex.clear();
+        mEntries.clear();
+    }
+
+    // Invokes fn(key, value) on every entry, from the most to the least recently used
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const auto& [key, value] : mEntries) {
+            fn(key, value);
+        }
+    }
+
+    size_t size() const { return mEntries.size(); }
+    size_t capacity() const { return mCapacity; }
+    const Stats& stats() const { return mStats; }
+
+   private:
+    using Entry = std::pair<Key, Value>;
+
+    const size_t mCapacity;
+    // Ordered from the most to the least recently used
+    std::list<Entry> mEntries;
+    std::unordered_map<Key, typename std::list<Entry>::iterator> mIndex;
+    Stats mStats;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_LRU_CACHE_H
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_RENDER_TIMING_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_RENDER_TIMING_H
+
+#include <android/sync.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "../Utils.h"
+#include "RendererBase.h"
+
+namespace pose_estimation {
+
+// The CLOCK_MONOTONIC time in nanoseconds, the clock of the sync fence timestamps
+inline int64_t monotonicTimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+// Returns the CLOCK_MONOTONIC time in nanoseconds at which the sync fence has signaled, or
+// std::nullopt if it has not signaled yet
+inline std::optional<int64_t> getSyncFenceSignalTimeNs(int syncFenceFd) {
+    struct sync_file_info* info = sync_file_info(syncFenceFd);
+    if (info == nullptr) return std::nullopt;
+
+    // A merged sync fence signals with the last of its fences
+    std::optional<int64_t> signalTimeNs;
+    if (info->status == 1) {
+        const struct sync_fence_info* fences = sync_get_fence_info(info);
+        signalTimeNs = 0;
+        for (uint32_t i = 0; i < info->num_fences; i++) {
+            signalTimeNs = std::max<int64_t>(*signalTimeNs, fences[i].timestamp_ns);
+        }
+    }
+    sync_file_info_free(info);
+    return signalTimeNs;
+}
+
+// The CPU and GPU timestamps of a frame, recorded by a renderer to compute its RenderTiming
+struct FrameTimestamps {
+    // The CLOCK_MONOTONIC time at which the work was submitted to the GPU
+    int64_t submittedNs = 0;
+
+    // The GPU timestamps of the start and the end of the work, in nanoseconds of the GPU clock
+    bool hasGpuTimestamps = false;
+    int64_t gpuStartNs = 0;
+    int64_t gpuEndNs = 0;
+
+    // The difference between CLOCK_MONOTONIC and the GPU clock, if the GPU clock can be correlated
+    std::optional<int64_t> gpuToMonotonicOffsetNs;
+
+    // A duplicate of the sync fence exported for the frame, if any
+    UniqueFd syncFence;
+    // Otherwise, the CLOCK_MONOTONIC time at which the CPU wait for the work has returned
+    int64_t waitFinishedNs = 0;
+
+    RenderTiming computeRenderTiming() const {
+        constexpr float kNsPerMs = 1000'000.0f;
+        RenderTiming timing;
+        if (!hasGpuTimestamps) return timing;
+        timing.gpuExecutionMs = (gpuEndNs - gpuStartNs) / kNsPerMs;
+
+        // The other durations span both clocks
+        if (!gpuToMonotonicOffsetNs) return timing;
+        const int64_t startNs = gpuStartNs + *gpuToMonotonicOffsetNs;
+        const int64_t endNs = gpuEndNs + *gpuToMonotonicOffsetNs;
+        timing.queueWaitMs = (startNs - submittedNs) / kNsPerMs;
+        const std::optional<int64_t> signaledNs =
+                syncFence.ok() ? getSyncFenceSignalTimeNs(syncFence.get()) : waitFinishedNs;
+        if (signaledNs) {
+            timing.fenceSignalMs = (*signaledNs - endNs) / kNsPerMs;
+        }
+        return timing;
+    }
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_RENDER_TIMING_H
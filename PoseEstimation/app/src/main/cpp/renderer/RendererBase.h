@@ -19,6 +19,7 @@
 
 #include <android/asset_manager_jni.h>
 
+#include <cmath>
 #include <utility>
 
 #include "../PoseEstimationConfig.h"
@@ -26,6 +27,18 @@
 
 namespace pose_estimation {
 
+// The GPU timing of a rendered frame, split by where the time went. Every duration is NaN if the
+// renderer or the device cannot measure it.
+struct RenderTiming {
+    // From the submission of the work to the start of its execution on the GPU
+    float queueWaitMs = NAN;
+    // The execution of the work on the GPU
+    float gpuExecutionMs = NAN;
+    // From the end of the execution on the GPU to the signal of the sync fence, or to the return
+    // of the CPU wait if the frame is not fenced
+    float fenceSignalMs = NAN;
+};
+
 class RendererBase {
     DISABLE_COPY_AND_ASSIGN(RendererBase);
 
@@ -33,13 +46,32 @@ class RendererBase {
     RendererBase(PoseEstimationConfig config) : mConfig(config) {}
     virtual ~RendererBase() = default;
 
-    // Must be invoked prior to RendererBase::run
+    // Must be invoked for every slot in [0, mConfig.pipelineDepth) prior to RendererBase::run
     // Imports the AHardwareBuffer to the GPU framework and sets up related resources
-    virtual void setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) = 0;
+    virtual void setOutputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) = 0;
 
+    // Renders the camera input to the output of the given slot
     // Returns a valid sync fence FD if exporting a sync fence FD is supported and
     // preferSyncFence is true; otherwise, returns an invalid FD
-    virtual UniqueFd run(AHardwareBuffer* cameraInput, bool preferSyncFence) = 0;
+    virtual UniqueFd run(AHardwareBuffer* cameraInput, uint32_t slot, bool preferSyncFence) = 0;
+
+    // Returns the GPU timing of the frame rendered on the given slot
+    // Must be invoked after the frame has finished, i.e. after its sync fence has signaled, and
+    // before the next RendererBase::run on the same slot
+    virtual RenderTiming getTiming(uint32_t /*slot*/) { return {}; }
+
+    // Drops the resources imported for a camera AHardwareBuffer that the camera no longer uses,
+    // e.g. after the ImageReader has been closed or has reallocated its buffers. The resources of
+    // the frames still in flight are released once they have finished.
+    //
+    // The app does not call this, as ImageReader does not report when it drops a buffer, and
+    // relies on the eviction of the cache instead. This is for callers that own their buffers.
+    virtual void onCameraBufferReleased(AHardwareBuffer* /*cameraInput*/) {}
+
+    // Replaces the column-major 4x4 transform from the output coordinates to the camera texture
+    // coordinates, e.g. after the display has rotated. Applies from the next RendererBase::run, the
+    // frames in flight are rendered with the previous transform.
+    virtual void setTextureTransform(const float* textureTransform) = 0;
 
    protected:
     PoseEstimationConfig mConfig;
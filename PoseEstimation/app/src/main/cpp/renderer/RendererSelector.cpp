@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RendererSelector.h"
+
+#include <android/hardware_buffer.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../PoseEstimationConfig.h"
+#include "../Utils.h"
+#include "CpuRenderer.h"
+#ifndef POSE_ESTIMATION_HOST_BUILD
+#include "GlComputeRenderer.h"
+#include "VulkanComputeRenderer.h"
+#endif
+
+namespace pose_estimation {
+namespace {
+
+const char* describe(const CameraPreprocessing& preprocessing) {
+    switch (preprocessing.renderer) {
+        case Renderer::CPU:
+            return "CPU";
+        case Renderer::GLES:
+            return preprocessing.rawYuvCameraInput ? "GLES, raw YUV" : "GLES, implicit conversion";
+        default:
+            return "unknown";
+    }
+}
+
+// Fills the planes of a YUV AHardwareBuffer with a smooth pattern
+void fillSyntheticFrame(AHardwareBuffer* frame, const AHardwareBuffer_Desc& desc) {
+    AHardwareBuffer_Planes planes;
+    CHECK(AHardwareBuffer_lockPlanes(frame, AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN, -1, nullptr,
+                                     &planes) == 0);
+    for (uint32_t p = 0; p < planes.planeCount; p++) {
+        const AHardwareBuffer_Plane& plane = planes.planes[p];
+        const uint32_t subsampling = p == 0 ? 1 : 2;
+        for (uint32_t y = 0; y < desc.height / subsampling; y++) {
+            auto* row = static_cast<uint8_t*>(plane.data) + y * plane.rowStride;
+            for (uint32_t x = 0; x < desc.width / subsampling; x++) {
+                row[x * plane.pixelStride] = (x + y + p * 85) & 0xff;
+            }
+        }
+    }
+    CHECK(AHardwareBuffer_unlock(frame, nullptr) == 0);
+}
+
+}  // namespace
+
+std::unique_ptr<RendererBase> createRenderer(const PoseEstimationConfig& config,
+                                             AAssetManager* assetManager,
+                                             const float* textureTransform) {
+    // The host build has no GPU, see host/CMakeLists.txt
+    switch (config.renderer) {
+        case Renderer::CPU:
+            return std::make_unique<CpuRenderer>(config, textureTransform);
+#ifndef POSE_ESTIMATION_HOST_BUILD
+        case Renderer::GLES:
+            return std::make_unique<GlComputeRenderer>(config, textureTransform);
+        case Renderer::VULKAN:
+            return std::make_unique<VulkanComputeRenderer>(config, assetManager, textureTransform);
+#endif
+        default:
+            LOG_FATAL("Renderer %d is not available", static_cast<int>(config.renderer));
+    }
+}
+
+CameraPreprocessing selectCameraPreprocessing(const PoseEstimationConfig& config,
+                                              AAssetManager* assetManager,
+                                              const float* textureTransform,
+                                              const CameraPreprocessingOptions& options) {
+    CHECK(config.cameraWidth > 0 && config.cameraHeight > 0);
+    CHECK(options.timedRuns > 0);
+    const auto selectionStart = std::chrono::steady_clock::now();
+
+    // The synthetic camera frame, sampled by the GPU if the device supports it
+    AHardwareBuffer_Desc desc = {
+            .width = config.cameraWidth,
+            .height = config.cameraHeight,
+            .layers = 1,
+            .format = AHARDWAREBUFFER_FORMAT_Y8Cb8Cr8_420,
+            .usage = AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN | AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN |
+                     AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE,
+    };
+    AHardwareBuffer* frame = nullptr;
+    const bool gpuSampled = AHardwareBuffer_allocate(&desc, &frame) == 0;
+    if (!gpuSampled) {
+        LOGI("A YUV AHardwareBuffer cannot be sampled by the GPU, skipping the implicit conversion");
+        desc.usage &= ~AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE;
+        CHECK(AHardwareBuffer_allocate(&desc, &frame) == 0);
+    }
+    fillSyntheticFrame(frame, desc);
+
+    std::vector<CameraPreprocessing> candidates;
+#ifndef POSE_ESTIMATION_HOST_BUILD
+    if (gpuSampled) {
+        candidates.push_back({.renderer = Renderer::GLES, .rawYuvCameraInput = false});
+    }
+    candidates.push_back({.renderer = Renderer::GLES, .rawYuvCameraInput = true});
+#endif
+    candidates.push_back({.renderer = Renderer::CPU, .rawYuvCameraInput = true});
+
+    // The fp32 output is the largest of the output formats
+    ManagedBlobAhwb output(kRendererOutputSizeBytes, AHARDWAREBUFFER_USAGE_GPU_DATA_BUFFER |
+                                                             AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN |
+                                                             AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN);
+    CameraPreprocessing best;
+    float bestMs = std::numeric_limits<float>::infinity();
+    for (const CameraPreprocessing& candidate : candidates) {
+        PoseEstimationConfig candidateConfig = config;
+        candidateConfig.renderer = candidate.renderer;
+        candidateConfig.rawYuvCameraInput = candidate.rawYuvCameraInput;
+        candidateConfig.pipelineDepth = 1;
+        auto renderer = createRenderer(candidateConfig, assetManager, textureTransform);
+        renderer->setOutputFromHardwareBuffer(0, output.handle());
+
+        // Without a sync fence, every run waits for the end of the render
+        for (uint32_t i = 0; i < options.warmupRuns; i++) {
+            renderer->run(frame, 0, /*preferSyncFence=*/false);
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < options.timedRuns; i++) {
+            renderer->run(frame, 0, /*preferSyncFence=*/false);
+        }
+        const std::chrono::duration<float, std::milli> duration =
+                std::chrono::steady_clock::now() - start;
+        const float ms = duration.count() / options.timedRuns;
+        LOGI("Camera preprocessing selection: %s: %.2f ms", describe(candidate), ms);
+        if (ms < bestMs) {
+            best = candidate;
+            bestMs = ms;
+        }
+    }
+    AHardwareBuffer_release(frame);
+
+    const std::chrono::duration<float, std::milli> selectionDuration =
+            std::chrono::steady_clock::now() - selectionStart;
+    LOGI("Camera preprocessing selection picked %s, the selection took %.2f ms", describe(best),
+         selectionDuration.count());
+    return best;
+}
+
+}  // namespace pose_estimation
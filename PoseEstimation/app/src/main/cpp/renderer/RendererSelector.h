@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_RENDERER_SELECTOR_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_RENDERER_SELECTOR_H
+
+#include <android/asset_manager_jni.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "../PoseEstimationConfig.h"
+#include "RendererBase.h"
+
+namespace pose_estimation {
+
+// Creates the renderer of the config, which must not be Renderer::AUTO
+std::unique_ptr<RendererBase> createRenderer(const PoseEstimationConfig& config,
+                                             AAssetManager* assetManager,
+                                             const float* textureTransform);
+
+// A way to preprocess the camera frames, picked by selectCameraPreprocessing
+struct CameraPreprocessing {
+    Renderer renderer = Renderer::GLES;
+    // See PoseEstimationConfig::rawYuvCameraInput
+    bool rawYuvCameraInput = false;
+};
+
+struct CameraPreprocessingOptions {
+    // The runs of every candidate before and while it is timed
+    uint32_t warmupRuns = 3;
+    uint32_t timedRuns = 10;
+};
+
+// Picks the cheapest way to preprocess the camera frames of config.cameraWidth x
+// config.cameraHeight on this device.
+//
+// Every candidate renders a synthetic YUV frame of the camera size, and is timed from the
+// submission to the end of the render, including the copy of the planes to the GPU for the raw
+// input. The candidates are the GLES renderer sampling through the implicit conversion of the
+// driver, the GLES renderer with the fused conversion of the raw planes, and the CPU renderer. The
+// implicit conversion is skipped if the device cannot allocate a YUV AHardwareBuffer that is both
+// written by the CPU and sampled by the GPU. The Vulkan renderer is left out, as it is not
+// available on every device that GLES runs on.
+CameraPreprocessing selectCameraPreprocessing(const PoseEstimationConfig& config,
+                                              AAssetManager* assetManager,
+                                              const float* textureTransform,
+                                              const CameraPreprocessingOptions& options = {});
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_RENDERER_SELECTOR_H
@@ -18,10 +18,14 @@
 
 #include <android/hardware_buffer.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <vector>
 
-#include "../NdkFunctions.h"
+#include "../Trace.h"
+#include "CameraPlanes.h"
 #include "VulkanUtils.h"
 
 namespace pose_estimation {
@@ -82,6 +86,26 @@ bool isExportingSyncFenceFdSupported(VkPhysicalDevice device) {
     return true;
 }
 
+bool isCalibratingTimestampsSupported(VkInstance instance, VkPhysicalDevice device) {
+    if (!areExtensionsSupported(device, {VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME})) {
+        return false;
+    }
+
+    // Both the GPU clock and CLOCK_MONOTONIC must be calibrateable
+    auto pfnGetTimeDomains = (PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT)
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT");
+    if (pfnGetTimeDomains == nullptr) return false;
+    uint32_t numberOfTimeDomains = 0;
+    CALL_VK(pfnGetTimeDomains, device, &numberOfTimeDomains, nullptr);
+    std::vector<VkTimeDomainEXT> timeDomains(numberOfTimeDomains);
+    CALL_VK(pfnGetTimeDomains, device, &numberOfTimeDomains, timeDomains.data());
+    auto hasTimeDomain = [&timeDomains](VkTimeDomainEXT timeDomain) {
+        return std::find(timeDomains.begin(), timeDomains.end(), timeDomain) != timeDomains.end();
+    };
+    return hasTimeDomain(VK_TIME_DOMAIN_DEVICE_EXT) &&
+           hasTimeDomain(VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT);
+}
+
 // Choose the work group size of the compute shader.
 // In this sample app, we are using a square execution dimension.
 uint32_t chooseWorkGroupSize(const VkPhysicalDeviceLimits& limits) {
@@ -167,6 +191,18 @@ void addBufferTransitionBarrier(VkCommandBuffer commandBuffer, VkBuffer buffer,
                          &bufferBarrier, 0, nullptr);
 }
 
+// The Parameters uniform block of the shaders, in the std140 layout. Only shader_raw_yuv.comp.spv
+// reads the layout of the camera planes.
+struct ShaderParameters {
+    float textureTransform[16];
+    uint32_t cameraSize[2];
+    uint32_t padding0[2];
+    uint32_t planeOffsets[3];
+    uint32_t padding1;
+    uint32_t planeStrides[3];
+    uint32_t padding2;
+};
+
 }  // namespace
 
 VulkanContext::VulkanContext() {
@@ -206,6 +242,7 @@ VulkanContext::VulkanContext() {
         for (uint32_t i = 0; i < queueFamilies.size(); i++) {
             if (queueFamilies[i].queueFlags & VK_QUEUE_COMPUTE_BIT) {
                 pickedQueueFamilyIndex = i;
+                mTimestampValidBits = queueFamilies[i].timestampValidBits;
                 hasComputeQueue = true;
                 break;
             }
@@ -259,6 +296,13 @@ VulkanContext::VulkanContext() {
                                 deviceExtensionsToExportSyncFenceFd.end());
     }
 
+    // This extension is optional to correlate the GPU timestamps with the CPU
+    const bool supportsCalibratingTimestamps =
+            supportsTimestamps() && isCalibratingTimestampsSupported(mInstance, mPhysicalDevice);
+    if (supportsCalibratingTimestamps) {
+        deviceExtensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+    }
+
     // Create logical device
     const float queuePriority = 1.0f;
     const VkDeviceQueueCreateInfo queueDesc = {
@@ -287,6 +331,12 @@ VulkanContext::VulkanContext() {
     } else {
         LOGI("Android sync fence is not supported");
     }
+    if (supportsCalibratingTimestamps) {
+        mPfnVkGetCalibratedTimestamps = (PFN_vkGetCalibratedTimestampsEXT)vkGetDeviceProcAddr(
+                mDevice, "vkGetCalibratedTimestampsEXT");
+    }
+    LOGI("GPU timestamps are %ssupported, %scalibrated with the CPU",
+         supportsTimestamps() ? "" : "not ", mPfnVkGetCalibratedTimestamps ? "" : "not ");
 }
 
 VulkanContext::~VulkanContext() {
@@ -310,6 +360,32 @@ uint32_t VulkanContext::findMemoryType(uint32_t memoryTypeBitsRequirement,
     return 0;
 }
 
+int64_t VulkanContext::timestampToNs(uint64_t timestamp) const {
+    // Only the valid bits hold the timestamp, the other bits are undefined
+    if (mTimestampValidBits < 64) timestamp &= (1ull << mTimestampValidBits) - 1;
+    return static_cast<int64_t>(timestamp * double(mPhysicalDeviceProperties.limits.timestampPeriod));
+}
+
+std::optional<int64_t> VulkanContext::getGpuToMonotonicOffsetNs() const {
+    if (mPfnVkGetCalibratedTimestamps == nullptr) return std::nullopt;
+    const VkCalibratedTimestampInfoEXT timestampInfos[] = {
+            {
+                    .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT,
+                    .pNext = nullptr,
+                    .timeDomain = VK_TIME_DOMAIN_DEVICE_EXT,
+            },
+            {
+                    .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT,
+                    .pNext = nullptr,
+                    .timeDomain = VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT,
+            },
+    };
+    uint64_t timestamps[2];
+    uint64_t maxDeviation;
+    CALL_VK(mPfnVkGetCalibratedTimestamps, mDevice, 2, timestampInfos, timestamps, &maxDeviation);
+    return static_cast<int64_t>(timestamps[1]) - timestampToNs(timestamps[0]);
+}
+
 VulkanAHardwareBufferImage::VulkanAHardwareBufferImage(VulkanContext* context,
                                                        AHardwareBuffer* buffer)
     : mContext(context) {
@@ -464,19 +540,65 @@ VulkanAHardwareBufferImage::~VulkanAHardwareBufferImage() {
     vkDestroyImage(mContext->device(), mImage, nullptr);
 }
 
+VulkanHostBuffer::VulkanHostBuffer(VulkanContext* context, VkDeviceSize size,
+                                   VkBufferUsageFlags usage)
+    : mContext(context), mSize(size) {
+    const VkBufferCreateInfo bufferCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0u,
+            .size = size,
+            .usage = usage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0u,
+            .pQueueFamilyIndices = nullptr,
+    };
+    CALL_VK(vkCreateBuffer, mContext->device(), &bufferCreateInfo, nullptr, &mBuffer);
+
+    // Coherent memory needs no flush, the writes of the host are visible to the queue submitted
+    // after them
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(mContext->device(), mBuffer, &memoryRequirements);
+    const VkMemoryAllocateInfo memoryAllocInfo = {
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .pNext = nullptr,
+            .allocationSize = memoryRequirements.size,
+            .memoryTypeIndex = mContext->findMemoryType(
+                    memoryRequirements.memoryTypeBits,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+    };
+    CALL_VK(vkAllocateMemory, mContext->device(), &memoryAllocInfo, nullptr, &mMemory);
+    CALL_VK(vkBindBufferMemory, mContext->device(), mBuffer, mMemory, 0);
+    CALL_VK(vkMapMemory, mContext->device(), mMemory, 0, VK_WHOLE_SIZE, 0, &mData);
+}
+
+VulkanHostBuffer::~VulkanHostBuffer() {
+    vkUnmapMemory(mContext->device(), mMemory);
+    vkFreeMemory(mContext->device(), mMemory, nullptr);
+    vkDestroyBuffer(mContext->device(), mBuffer, nullptr);
+}
+
 VulkanComputePipeline::VulkanComputePipeline(VulkanContext* context,
                                              VulkanComputeRenderer* renderer,
                                              AHardwareBuffer* cameraInput)
-    : mContext(context), mRenderer(renderer), mCameraTexture(context, cameraInput) {
+    : mContext(context), mRenderer(renderer) {
+    if (cameraInput != nullptr) {
+        mCameraTexture = std::make_unique<VulkanAHardwareBufferImage>(context, cameraInput);
+    }
+
     // Create descriptor set layout
-    VkSampler sampler = mCameraTexture.sampler();
-    const std::vector<VkDescriptorSetLayoutBinding> descriptorsetLayoutBinding = {
+    const bool rawYuvCameraInput = mCameraTexture == nullptr;
+    VkSampler sampler = rawYuvCameraInput ? VK_NULL_HANDLE : mCameraTexture->sampler();
+    std::vector<VkDescriptorSetLayoutBinding> descriptorsetLayoutBinding = {
             {
-                    .binding = 0,  // input image
-                    .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                    .binding = 0,  // input image, or input camera planes
+                    .descriptorType = rawYuvCameraInput ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                                                        : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
                     .descriptorCount = 1,
                     .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
-                    .pImmutableSamplers = mCameraTexture.isSamplerImmutable() ? &sampler : nullptr,
+                    .pImmutableSamplers = !rawYuvCameraInput && mCameraTexture->isSamplerImmutable()
+                                                  ? &sampler
+                                                  : nullptr,
             },
             {
                     .binding = 1,  // output buffer
@@ -484,7 +606,12 @@ VulkanComputePipeline::VulkanComputePipeline(VulkanContext* context,
                     .descriptorCount = 1,
                     .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
             },
-
+            {
+                    .binding = 2,  // shader parameters
+                    .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                    .descriptorCount = 1,
+                    .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+            },
     };
     const VkDescriptorSetLayoutCreateInfo descriptorsetLayoutDesc = {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
@@ -494,38 +621,31 @@ VulkanComputePipeline::VulkanComputePipeline(VulkanContext* context,
     CALL_VK(vkCreateDescriptorSetLayout, mContext->device(), &descriptorsetLayoutDesc, nullptr,
             &mDescriptorSetLayout);
 
-    // Allocate descriptor set
-    const VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = {
-            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-            .descriptorPool = mRenderer->mDescriptorPool,
-            .descriptorSetCount = 1,
-            .pSetLayouts = &mDescriptorSetLayout,
-    };
-    CALL_VK(vkAllocateDescriptorSets, mContext->device(), &descriptorSetAllocateInfo,
-            &mDescriptorSet);
-
     // Create pipeline layout
-    const VkPushConstantRange pushConstantRange = {
-            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
-            .offset = 0,
-            .size = static_cast<uint32_t>(mRenderer->mTextureTransform.size() * sizeof(float)),
-    };
     const VkPipelineLayoutCreateInfo layoutDesc = {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
             .setLayoutCount = 1,
             .pSetLayouts = &mDescriptorSetLayout,
-            .pushConstantRangeCount = 1,
-            .pPushConstantRanges = &pushConstantRange,
+            .pushConstantRangeCount = 0,
+            .pPushConstantRanges = nullptr,
     };
     CALL_VK(vkCreatePipelineLayout, mContext->device(), &layoutDesc, nullptr, &mPipelineLayout);
 
     // Create compute pipeline
+    static_assert(kRendererOutputQuant8Scale == 1.0f / 128.0f &&
+                  kRendererOutputQuant8ZeroPoint == 128);
     const uint32_t workgroupSize = mContext->workgroupSize();
-    const uint32_t specializationData[] = {workgroupSize, workgroupSize};
+    const PoseEstimationConfig& config = mRenderer->mConfig;
+    const VkBool32 quant8Output = config.mlExecutor == MlExecutor::NATIVE_NNAPI_QUANT8;
+    const VkBool32 float16Output = config.float16RendererOutput;
+    const uint32_t specializationData[] = {workgroupSize, workgroupSize, quant8Output,
+                                           float16Output};
     const std::vector<VkSpecializationMapEntry> specializationMap = {
             // clang-format off
             {0, 0 * sizeof(uint32_t), sizeof(uint32_t)},
             {1, 1 * sizeof(uint32_t), sizeof(uint32_t)},
+            {2, 2 * sizeof(uint32_t), sizeof(VkBool32)},
+            {3, 3 * sizeof(uint32_t), sizeof(VkBool32)},
             // clang-format on
     };
     const VkSpecializationInfo specializationInfo = {
@@ -546,103 +666,219 @@ VulkanComputePipeline::VulkanComputePipeline(VulkanContext* context,
                     },
             .layout = mPipelineLayout,
     };
-    CALL_VK(vkCreateComputePipelines, mContext->device(), mRenderer->mPipelineCache, 1,
+    // Compiling the shader dominates the creation of a compute pipeline, unless the pipeline cache
+    // has been seeded with the compiled shader by a previous launch
+    const auto start = std::chrono::high_resolution_clock::now();
+    CALL_VK(vkCreateComputePipelines, mContext->device(), mRenderer->mPipelineCache->handle(), 1,
             &pipelineDesc, nullptr, &mPipeline);
+    const std::chrono::duration<float, std::milli> elapsed =
+            std::chrono::high_resolution_clock::now() - start;
+    LOGI("Vulkan compute pipeline creation took %.2f ms, pipeline cache %s", elapsed.count(),
+         mRenderer->mPipelineCache->isWarm() ? "warm" : "cold");
+
+    // The descriptor sets and command buffers are created per slot on first use
+    mDescriptorSets.resize(mRenderer->mOutputBuffers.size(), VK_NULL_HANDLE);
+    mCommandBuffers.resize(mRenderer->mOutputBuffers.size(), VK_NULL_HANDLE);
+    mBoundCameraPlaneBuffers.resize(mRenderer->mOutputBuffers.size(), VK_NULL_HANDLE);
+}
 
-    // Create the descriptor sets.
-    const VkDescriptorImageInfo cameraTextureDesc = {
-            .sampler = mCameraTexture.sampler(),
-            .imageView = mCameraTexture.view(),
-            .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-    };
-    const VkDescriptorBufferInfo outputBufferDesc = {
-            .buffer = mRenderer->mOutputBuffer,
+VkCommandBuffer VulkanComputePipeline::commandBuffer(uint32_t slot) {
+    CHECK(slot < mCommandBuffers.size());
+    // The previous frame of the slot has finished by now, so its command buffer can be recorded
+    // again if the buffer of the camera planes has changed since
+    if (mCommandBuffers[slot] == VK_NULL_HANDLE ||
+        (mCameraTexture == nullptr &&
+         mBoundCameraPlaneBuffers[slot] != mRenderer->mCameraPlaneBuffers[slot]->buffer())) {
+        recordCommandBuffer(slot);
+    }
+    return mCommandBuffers[slot];
+}
+
+void VulkanComputePipeline::writeCameraInputDescriptor(uint32_t slot) {
+    if (mCameraTexture != nullptr) {
+        const VkDescriptorImageInfo cameraTextureDesc = {
+                .sampler = mCameraTexture->sampler(),
+                .imageView = mCameraTexture->view(),
+                .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        };
+        const VkWriteDescriptorSet writeDst = {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = nullptr,
+                .dstSet = mDescriptorSets[slot],
+                .dstBinding = 0,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                .pImageInfo = &cameraTextureDesc,
+                .pBufferInfo = nullptr,
+                .pTexelBufferView = nullptr,
+        };
+        vkUpdateDescriptorSets(mContext->device(), 1, &writeDst, 0, nullptr);
+        return;
+    }
+
+    const VkBuffer cameraPlaneBuffer = mRenderer->mCameraPlaneBuffers[slot]->buffer();
+    const VkDescriptorBufferInfo cameraPlanesDesc = {
+            .buffer = cameraPlaneBuffer,
             .offset = 0,
             .range = VK_WHOLE_SIZE,
     };
-    const std::vector<VkWriteDescriptorSet> writeDst = {
-            {
-                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                    .pNext = nullptr,
-                    .dstSet = mDescriptorSet,
-                    .dstBinding = 0,
-                    .dstArrayElement = 0,
-                    .descriptorCount = 1,
-                    .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                    .pImageInfo = &cameraTextureDesc,
-                    .pBufferInfo = nullptr,
-                    .pTexelBufferView = nullptr,
-            },
-            {
-                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                    .pNext = nullptr,
-                    .dstSet = mDescriptorSet,
-                    .dstBinding = 1,
-                    .dstArrayElement = 0,
-                    .descriptorCount = 1,
-                    .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                    .pImageInfo = nullptr,
-                    .pBufferInfo = &outputBufferDesc,
-                    .pTexelBufferView = nullptr,
-            },
+    const VkWriteDescriptorSet writeDst = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .pNext = nullptr,
+            .dstSet = mDescriptorSets[slot],
+            .dstBinding = 0,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .pImageInfo = nullptr,
+            .pBufferInfo = &cameraPlanesDesc,
+            .pTexelBufferView = nullptr,
     };
-    vkUpdateDescriptorSets(mContext->device(), writeDst.size(), writeDst.data(), 0, nullptr);
+    vkUpdateDescriptorSets(mContext->device(), 1, &writeDst, 0, nullptr);
+    mBoundCameraPlaneBuffers[slot] = cameraPlaneBuffer;
+}
+
+void VulkanComputePipeline::recordCommandBuffer(uint32_t slot) {
+    const VkBuffer outputBuffer = mRenderer->mOutputBuffers[slot].buffer;
+    CHECK(outputBuffer != VK_NULL_HANDLE);
+    VkDescriptorSet& descriptorSet = mDescriptorSets[slot];
+    VkCommandBuffer& commandBuffer = mCommandBuffers[slot];
+
+    if (descriptorSet == VK_NULL_HANDLE) {
+        // Allocate descriptor set
+        const VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                .descriptorPool = mRenderer->mDescriptorPool,
+                .descriptorSetCount = 1,
+                .pSetLayouts = &mDescriptorSetLayout,
+        };
+        CALL_VK(vkAllocateDescriptorSets, mContext->device(), &descriptorSetAllocateInfo,
+                &descriptorSet);
+
+        // Update the descriptor set.
+        const VkDescriptorBufferInfo outputBufferDesc = {
+                .buffer = outputBuffer,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE,
+        };
+        const VkWriteDescriptorSet writeDst = {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = nullptr,
+                .dstSet = descriptorSet,
+                .dstBinding = 1,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .pImageInfo = nullptr,
+                .pBufferInfo = &outputBufferDesc,
+                .pTexelBufferView = nullptr,
+        };
+        vkUpdateDescriptorSets(mContext->device(), 1, &writeDst, 0, nullptr);
+        const VkDescriptorBufferInfo parametersDesc = {
+                .buffer = mRenderer->mParameterBuffers[slot]->buffer(),
+                .offset = 0,
+                .range = VK_WHOLE_SIZE,
+        };
+        const VkWriteDescriptorSet writeParameters = {
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = nullptr,
+                .dstSet = descriptorSet,
+                .dstBinding = 2,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                .pImageInfo = nullptr,
+                .pBufferInfo = &parametersDesc,
+                .pTexelBufferView = nullptr,
+        };
+        vkUpdateDescriptorSets(mContext->device(), 1, &writeParameters, 0, nullptr);
+    }
+    // The buffer of the camera planes may have been replaced since the last recording
+    writeCameraInputDescriptor(slot);
 
     // Create a command buffer
-    const VkCommandBufferAllocateInfo cmdBufferCreateInfo = {
-            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-            .pNext = nullptr,
-            .commandPool = mRenderer->mCommandPool,
-            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-            .commandBufferCount = 1,
-    };
-    CALL_VK(vkAllocateCommandBuffers, mContext->device(), &cmdBufferCreateInfo, &mCommandBuffer);
+    // Beginning an existing command buffer implicitly resets it, as the command pool is created
+    // with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT
+    if (commandBuffer == VK_NULL_HANDLE) {
+        const VkCommandBufferAllocateInfo cmdBufferCreateInfo = {
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+                .pNext = nullptr,
+                .commandPool = mRenderer->mCommandPool,
+                .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+                .commandBufferCount = 1,
+        };
+        CALL_VK(vkAllocateCommandBuffers, mContext->device(), &cmdBufferCreateInfo,
+                &commandBuffer);
+    }
 
     // Record command buffer
+    // The image barrier refers to the camera image, so the command buffer has to be recorded
+    // again whenever the camera input of the slot is replaced
     const VkCommandBufferBeginInfo commandBufferBeginInfo = {
             .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
             .pNext = nullptr,
             .flags = 0,
             .pInheritanceInfo = nullptr,
     };
-    CALL_VK(vkBeginCommandBuffer, mCommandBuffer, &commandBufferBeginInfo);
+    CALL_VK(vkBeginCommandBuffer, commandBuffer, &commandBufferBeginInfo);
+
+    // Timestamp the start of the work
+    const VkQueryPool queryPool = mRenderer->mTimestampQueryPool;
+    if (queryPool != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(commandBuffer, queryPool, slot * 2, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, slot * 2);
+    }
 
     // Image and buffer barriers to get the input camera texture and output buffer ready for the
-    // compute shader kernel
-    addImageTransitionBarrier(mCommandBuffer, mCameraTexture.image(),
-                              VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_ACCESS_SHADER_READ_BIT,
-                              VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-                              VK_QUEUE_FAMILY_FOREIGN_EXT, mContext->queueFamilyIndex());
-    addBufferTransitionBarrier(mCommandBuffer, mRenderer->mOutputBuffer,
-                               VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+    // compute shader kernel. The camera planes are written by the host before the submission,
+    // which makes them visible to the queue.
+    if (mCameraTexture != nullptr) {
+        addImageTransitionBarrier(
+                commandBuffer, mCameraTexture->image(), VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_ACCESS_SHADER_READ_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_QUEUE_FAMILY_FOREIGN_EXT, mContext->queueFamilyIndex());
+    }
+    addBufferTransitionBarrier(commandBuffer, outputBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
                                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_ACCESS_SHADER_WRITE_BIT,
                                VK_QUEUE_FAMILY_FOREIGN_EXT, mContext->queueFamilyIndex());
 
     // Setup resources and dispatch compute
-    vkCmdBindPipeline(mCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
-    vkCmdBindDescriptorSets(mCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, 1,
-                            &mDescriptorSet, 0, nullptr);
-    vkCmdPushConstants(mCommandBuffer, mPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
-                       mRenderer->mTextureTransform.size() * sizeof(float),
-                       mRenderer->mTextureTransform.data());
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, 1,
+                            &descriptorSet, 0, nullptr);
+    const uint32_t workgroupSize = mContext->workgroupSize();
     const uint32_t groupCountX = (kRendererOutputWidth + workgroupSize - 1) / workgroupSize;
     const uint32_t groupCountY = (kRendererOutputHeight + workgroupSize - 1) / workgroupSize;
-    vkCmdDispatch(mCommandBuffer, groupCountX, groupCountY, 1);
+    vkCmdDispatch(commandBuffer, groupCountX, groupCountY, 1);
 
     // Buffer barrier to get the buffer ready for host reading
-    addBufferTransitionBarrier(mCommandBuffer, mRenderer->mOutputBuffer,
-                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
-                               VK_ACCESS_SHADER_WRITE_BIT, 0, mContext->queueFamilyIndex(),
-                               VK_QUEUE_FAMILY_FOREIGN_EXT);
+    addBufferTransitionBarrier(commandBuffer, outputBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                               VK_PIPELINE_STAGE_HOST_BIT, VK_ACCESS_SHADER_WRITE_BIT, 0,
+                               mContext->queueFamilyIndex(), VK_QUEUE_FAMILY_FOREIGN_EXT);
+
+    // Timestamp the end of the work
+    if (queryPool != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool,
+                            slot * 2 + 1);
+    }
 
     // Finish recording the command buffer
-    CALL_VK(vkEndCommandBuffer, mCommandBuffer);
+    CALL_VK(vkEndCommandBuffer, commandBuffer);
 }
 
 VulkanComputePipeline::~VulkanComputePipeline() {
-    vkFreeCommandBuffers(mContext->device(), mRenderer->mCommandPool, 1, &mCommandBuffer);
-    vkResetDescriptorPool(mContext->device(), mRenderer->mDescriptorPool, 0);
+    for (uint32_t i = 0; i < mCommandBuffers.size(); i++) {
+        if (mCommandBuffers[i] != VK_NULL_HANDLE) {
+            vkFreeCommandBuffers(mContext->device(), mRenderer->mCommandPool, 1,
+                                 &mCommandBuffers[i]);
+        }
+        if (mDescriptorSets[i] != VK_NULL_HANDLE) {
+            vkFreeDescriptorSets(mContext->device(), mRenderer->mDescriptorPool, 1,
+                                 &mDescriptorSets[i]);
+        }
+    }
     vkDestroyPipeline(mContext->device(), mPipeline, nullptr);
     vkDestroyDescriptorSetLayout(mContext->device(), mDescriptorSetLayout, nullptr);
     vkDestroyPipelineLayout(mContext->device(), mPipelineLayout, nullptr);
@@ -651,9 +887,11 @@ VulkanComputePipeline::~VulkanComputePipeline() {
 VulkanComputeRenderer::VulkanComputeRenderer(PoseEstimationConfig config,
                                              AAssetManager* assetManager,
                                              const float* textureTransform)
-    : RendererBase(config) {
+    : RendererBase(config), mCachedComputePipelines(config.maxNumberOfCameraImages) {
     // Create shader module
-    const auto shaderCode = readShaderCodeFromAsset(assetManager, "shaders/shader.comp.spv");
+    const auto shaderCode = readShaderCodeFromAsset(
+            assetManager, config.rawYuvCameraInput ? "shaders/shader_raw_yuv.comp.spv"
+                                                   : "shaders/shader.comp.spv");
     const VkShaderModuleCreateInfo shaderDesc = {
             .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
             .flags = 0,
@@ -671,19 +909,32 @@ VulkanComputeRenderer::VulkanComputeRenderer(PoseEstimationConfig config,
     CALL_VK(vkCreateCommandPool, mContext.device(), &cmdpoolDesc, nullptr, &mCommandPool);
 
     // Create descriptor pool
+    // There is one descriptor set for each pair of compute pipeline and slot. Besides the cached
+    // compute pipelines, each slot may hold one more compute pipeline in flight, see
+    // mComputePipelinesInFlight. The descriptor sets are individually freed when the owning
+    // compute pipeline is destroyed. With the raw YUV camera input, the camera planes take a
+    // second storage buffer.
+    const uint32_t maxNumberOfComputePipelines =
+            std::max(config.maxNumberOfCameraImages, 1u) + config.pipelineDepth;
+    const uint32_t maxNumberOfDescriptorSets = maxNumberOfComputePipelines * config.pipelineDepth;
     const std::vector<VkDescriptorPoolSize> descriptorPoolSizes = {
             {
                     .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                    .descriptorCount = config.maxNumberOfCameraImages,
+                    .descriptorCount = maxNumberOfDescriptorSets,
             },
             {
                     .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                    .descriptorCount = config.maxNumberOfCameraImages,
+                    .descriptorCount = maxNumberOfDescriptorSets * 2,
+            },
+            {
+                    .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                    .descriptorCount = maxNumberOfDescriptorSets,
             },
     };
     const VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {
             .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-            .maxSets = config.maxNumberOfCameraImages,
+            .flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+            .maxSets = maxNumberOfDescriptorSets,
             .poolSizeCount = static_cast<uint32_t>(descriptorPoolSizes.size()),
             .pPoolSizes = descriptorPoolSizes.data(),
     };
@@ -691,15 +942,15 @@ VulkanComputeRenderer::VulkanComputeRenderer(PoseEstimationConfig config,
             &mDescriptorPool);
 
     // Create pipeline cache
-    const VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {
-            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .initialDataSize = 0,
-            .pInitialData = nullptr,
-    };
-    CALL_VK(vkCreatePipelineCache, mContext.device(), &pipelineCacheCreateInfo, nullptr,
-            &mPipelineCache);
+    // The compiled pipelines depend on the shader code and its specialization, besides the device
+    CompilationCacheTokenBuilder pipelineCacheKey;
+    pipelineCacheKey.update(shaderCode.data(), shaderCode.size());
+    pipelineCacheKey.update(mContext.workgroupSize());
+    pipelineCacheKey.update(config.mlExecutor);
+    pipelineCacheKey.update(config.float16RendererOutput);
+    mPipelineCache = std::make_unique<VulkanPipelineCache>(
+            mContext.device(), mContext.physicalDeviceProperties(), config.compilationCacheDir,
+            pipelineCacheKey.finish());
 
     // Create fence
     const VkExportFenceCreateInfo exportFenceCreateInfo = {
@@ -716,10 +967,41 @@ VulkanComputeRenderer::VulkanComputeRenderer(PoseEstimationConfig config,
 
     // Save the texture transform matrix
     mTextureTransform = std::vector<float>(textureTransform, textureTransform + 16);
+
+    // Create timestamp query pool
+    if (mContext.supportsTimestamps()) {
+        const VkQueryPoolCreateInfo queryPoolCreateInfo = {
+                .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .queryType = VK_QUERY_TYPE_TIMESTAMP,
+                .queryCount = config.pipelineDepth * 2,
+                .pipelineStatistics = 0,
+        };
+        CALL_VK(vkCreateQueryPool, mContext.device(), &queryPoolCreateInfo, nullptr,
+                &mTimestampQueryPool);
+    }
+    mFrameTimestamps.resize(config.pipelineDepth);
+
+    mOutputBuffers.resize(config.pipelineDepth);
+    mComputePipelinesInFlight.resize(config.pipelineDepth);
+
+    // Create the parameter buffers, and the buffers of the raw camera planes, which are sized by
+    // the first camera image
+    for (uint32_t i = 0; i < config.pipelineDepth; i++) {
+        mParameterBuffers.push_back(std::make_unique<VulkanHostBuffer>(
+                &mContext, sizeof(ShaderParameters), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT));
+    }
+    if (config.rawYuvCameraInput) {
+        mCameraPlaneBuffers.resize(config.pipelineDepth);
+    }
 }
 
-void VulkanComputeRenderer::setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) {
+void VulkanComputeRenderer::setOutputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) {
     LOGI("VulkanComputeRenderer::setOutputFromHardwareBuffer");
+    CHECK(slot < mOutputBuffers.size());
+    OutputBuffer& outputBuffer = mOutputBuffers[slot];
+    CHECK(outputBuffer.buffer == VK_NULL_HANDLE);
 
     // Check the AHardwareBuffer format and usage bits
     AHardwareBuffer_Desc desc;
@@ -750,7 +1032,7 @@ void VulkanComputeRenderer::setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) {
             .queueFamilyIndexCount = 0u,
             .pQueueFamilyIndices = nullptr,
     };
-    CALL_VK(vkCreateBuffer, mContext.device(), &bufferCreateInfo, nullptr, &mOutputBuffer);
+    CALL_VK(vkCreateBuffer, mContext.device(), &bufferCreateInfo, nullptr, &outputBuffer.buffer);
 
     // Import the AHardwareBuffer memory
     const VkImportAndroidHardwareBufferInfoANDROID importMemoryAllocateInfo = {
@@ -764,66 +1046,113 @@ void VulkanComputeRenderer::setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) {
             .allocationSize = properties.allocationSize,
             .memoryTypeIndex = mContext.findMemoryType(properties.memoryTypeBits, 0),
     };
-    CALL_VK(vkAllocateMemory, mContext.device(), &memoryAllocInfo, nullptr, &mOutputBufferMemory);
+    CALL_VK(vkAllocateMemory, mContext.device(), &memoryAllocInfo, nullptr, &outputBuffer.memory);
 
     // Bind the memory with the buffer
-    CALL_VK(vkBindBufferMemory, mContext.device(), mOutputBuffer, mOutputBufferMemory, 0);
+    CALL_VK(vkBindBufferMemory, mContext.device(), outputBuffer.buffer, outputBuffer.memory, 0);
 }
 
 VulkanComputeRenderer::~VulkanComputeRenderer() {
-    for (auto& [_, pipeline] : mCachedComputePipelines) {
+    mCachedComputePipelines.logStats("Compute pipeline");
+    mCachedComputePipelines.clear();
+    for (auto& pipeline : mComputePipelinesInFlight) {
         pipeline.reset();
     }
-    mComputePipelineWithoutId.reset();
-    vkFreeMemory(mContext.device(), mOutputBufferMemory, nullptr);
-    vkDestroyBuffer(mContext.device(), mOutputBuffer, nullptr);
+    mRawYuvComputePipeline.reset();
+    mCameraPlaneBuffers.clear();
+    mParameterBuffers.clear();
+    for (const auto& outputBuffer : mOutputBuffers) {
+        vkFreeMemory(mContext.device(), outputBuffer.memory, nullptr);
+        vkDestroyBuffer(mContext.device(), outputBuffer.buffer, nullptr);
+    }
     vkDestroyFence(mContext.device(), mFence, nullptr);
-    vkDestroyPipelineCache(mContext.device(), mPipelineCache, nullptr);
+    vkDestroyQueryPool(mContext.device(), mTimestampQueryPool, nullptr);
+    mPipelineCache.reset();
     vkDestroyShaderModule(mContext.device(), mShaderModule, nullptr);
     vkDestroyCommandPool(mContext.device(), mCommandPool, nullptr);
     vkDestroyDescriptorPool(mContext.device(), mDescriptorPool, nullptr);
 }
 
 std::shared_ptr<VulkanComputePipeline> VulkanComputeRenderer::getComputePipeline(
-        AHardwareBuffer* cameraInput) {
-    // Cleanup any compute pipeline without a cache ID
-    mComputePipelineWithoutId.reset();
-
-    // Get the system wide unique ID for an AHardwareBuffer if supported
-    std::optional<uint64_t> maybeAhwbId;
-    if (NdkFunctions::apiLevel() >= 31) {
-        uint64_t ahwbId;
-        CHECK(NdkFunctions::get().AHardwareBuffer_getId(cameraInput, &ahwbId) == 0);
-        maybeAhwbId = ahwbId;
+        AHardwareBuffer* cameraInput, uint32_t slot) {
+    // The frame previously rendered on this slot has finished, release its compute pipeline
+    mComputePipelinesInFlight[slot].reset();
+
+    // The raw camera planes are copied to the buffers of the renderer, so that every camera input
+    // shares a single compute pipeline
+    if (mConfig.rawYuvCameraInput) {
+        if (mRawYuvComputePipeline == nullptr) {
+            mRawYuvComputePipeline =
+                    std::make_shared<VulkanComputePipeline>(&mContext, this, nullptr);
+        }
+        mComputePipelinesInFlight[slot] = mRawYuvComputePipeline;
+        return mRawYuvComputePipeline;
     }
 
-    // If cache hit, used the cache directly
-    auto cachedPipeline = maybeAhwbId ? mCachedComputePipelines.find(*maybeAhwbId)
-                                      : mCachedComputePipelines.end();
-    if (cachedPipeline != mCachedComputePipelines.end()) {
-        return cachedPipeline->second;
-    }
+    // Create the compute pipeline with the camera input, unless it is cached. This may evict the
+    // least recently used compute pipeline, which is destroyed right away unless it is in flight.
+    auto pipeline = mCachedComputePipelines.get(cameraInput, [this, cameraInput] {
+        return std::make_shared<VulkanComputePipeline>(&mContext, this, cameraInput);
+    });
 
-    // Create the compute pipeline with the camera input
-    auto pipeline = std::make_shared<VulkanComputePipeline>(&mContext, this, cameraInput);
+    // Keep the compute pipeline alive until the next run on the same slot
+    mComputePipelinesInFlight[slot] = pipeline;
+    return pipeline;
+}
 
-    if (maybeAhwbId) {
-        // Cache the compute pipeline if we have the unique ID
-        mCachedComputePipelines.emplace(*maybeAhwbId, pipeline);
-    } else {
-        // Otherwise, we still need to record the compute pipeline because we have to destroy it in
-        // the next run
-        mComputePipelineWithoutId = pipeline;
+void VulkanComputeRenderer::uploadCameraPlanes(AHardwareBuffer* cameraInput, uint32_t slot) {
+    TRACE_SCOPE("VulkanComputeRenderer::uploadCameraPlanes");
+    AHardwareBuffer_Desc desc;
+    AHardwareBuffer_describe(cameraInput, &desc);
+    AHardwareBuffer_Planes planes;
+    CHECK(AHardwareBuffer_lockPlanes(cameraInput, AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN, -1,
+                                     nullptr, &planes) == 0);
+    const CameraPlanesLayout layout = getCameraPlanesLayout(desc, planes);
+
+    // A YUV AHardwareBuffer cannot be imported as a storage buffer, so the planes are copied
+    // through the CPU mapping
+    std::unique_ptr<VulkanHostBuffer>& cameraPlaneBuffer = mCameraPlaneBuffers[slot];
+    if (cameraPlaneBuffer == nullptr || cameraPlaneBuffer->size() < layout.bufferSize) {
+        cameraPlaneBuffer = std::make_unique<VulkanHostBuffer>(&mContext, layout.bufferSize,
+                                                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
     }
-    return pipeline;
+    auto* cameraPlanes = static_cast<uint8_t*>(cameraPlaneBuffer->data());
+    for (const CameraPlanesLayout::Span& span : layout.spans) {
+        memcpy(cameraPlanes + span.offset, span.data, span.size);
+    }
+    CHECK(AHardwareBuffer_unlock(cameraInput, nullptr) == 0);
+
+    auto* parameters = static_cast<ShaderParameters*>(mParameterBuffers[slot]->data());
+    std::copy(layout.cameraSize, layout.cameraSize + 2, parameters->cameraSize);
+    std::copy(layout.planeOffsets, layout.planeOffsets + 3, parameters->planeOffsets);
+    std::copy(layout.planeStrides, layout.planeStrides + 3, parameters->planeStrides);
+}
+
+void VulkanComputeRenderer::onCameraBufferReleased(AHardwareBuffer* cameraInput) {
+    mCachedComputePipelines.release(cameraInput);
 }
 
-UniqueFd VulkanComputeRenderer::run(AHardwareBuffer* cameraInput, bool preferSyncFence) {
+void VulkanComputeRenderer::setTextureTransform(const float* textureTransform) {
+    // The frames in flight keep the transform they were submitted with, as every run writes the
+    // transform to the parameter buffer of its own slot
+    std::copy(textureTransform, textureTransform + 16, mTextureTransform.begin());
+}
+
+UniqueFd VulkanComputeRenderer::run(AHardwareBuffer* cameraInput, uint32_t slot,
+                                    bool preferSyncFence) {
+    TRACE_SCOPE("VulkanComputeRenderer::run");
+    CHECK(slot < mOutputBuffers.size());
+
     // Create or get the compute pipeline
-    auto pipeline = getComputePipeline(cameraInput);
+    auto pipeline = getComputePipeline(cameraInput, slot);
+    if (mConfig.rawYuvCameraInput) {
+        uploadCameraPlanes(cameraInput, slot);
+    }
+    auto* parameters = static_cast<ShaderParameters*>(mParameterBuffers[slot]->data());
+    std::copy(mTextureTransform.begin(), mTextureTransform.end(), parameters->textureTransform);
 
     // Submit to queue
-    VkCommandBuffer commandBuffer = pipeline->commandBuffer();
+    VkCommandBuffer commandBuffer = pipeline->commandBuffer(slot);
     const VkSubmitInfo submitInfo = {
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
             .waitSemaphoreCount = 0,
@@ -834,7 +1163,11 @@ UniqueFd VulkanComputeRenderer::run(AHardwareBuffer* cameraInput, bool preferSyn
             .signalSemaphoreCount = 0,
             .pSignalSemaphores = nullptr,
     };
+    FrameTimestamps& timestamps = mFrameTimestamps[slot];
+    timestamps = {};
+    timestamps.gpuToMonotonicOffsetNs = mContext.getGpuToMonotonicOffsetNs();
     CALL_VK(vkResetFences, mContext.device(), 1, &mFence);
+    timestamps.submittedNs = monotonicTimeNs();
     CALL_VK(vkQueueSubmit, mContext.queue(), 1, &submitInfo, mFence);
 
     // If sync fence is supported and preferred, export a Android sync fence FD and immediately
@@ -850,12 +1183,31 @@ UniqueFd VulkanComputeRenderer::run(AHardwareBuffer* cameraInput, bool preferSyn
         int fd;
         CALL_VK(mContext.vkGetFenceFd, mContext.device(), &fenceGetFdInfo, &fd);
         syncFenceFd = UniqueFd(fd);
+        timestamps.syncFence = UniqueFd(dup(fd));
     } else {
+        TRACE_SCOPE("vkWaitForFences");
         CALL_VK(vkWaitForFences, mContext.device(), 1, &mFence, VK_TRUE,
                 /* infinite timeout */ ~(0ull));
+        timestamps.waitFinishedNs = monotonicTimeNs();
     }
 
     return syncFenceFd;
 }
 
+RenderTiming VulkanComputeRenderer::getTiming(uint32_t slot) {
+    CHECK(slot < mFrameTimestamps.size());
+    FrameTimestamps& timestamps = mFrameTimestamps[slot];
+    if (mTimestampQueryPool != VK_NULL_HANDLE && timestamps.submittedNs != 0) {
+        // The frame has finished, so the results are available without waiting
+        uint64_t results[2] = {};
+        const VkResult result = vkGetQueryPoolResults(
+                mContext.device(), mTimestampQueryPool, slot * 2, 2, sizeof(results), results,
+                sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+        timestamps.hasGpuTimestamps = result == VK_SUCCESS;
+        timestamps.gpuStartNs = mContext.timestampToNs(results[0]);
+        timestamps.gpuEndNs = mContext.timestampToNs(results[1]);
+    }
+    return timestamps.computeRenderTiming();
+}
+
 }  // namespace pose_estimation
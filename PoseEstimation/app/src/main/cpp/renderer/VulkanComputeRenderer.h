@@ -19,9 +19,14 @@
 
 #include <android/hardware_buffer.h>
 
-#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
 
+#include "CameraImportCache.h"
+#include "RenderTiming.h"
 #include "RendererBase.h"
+#include "VulkanPipelineCache.h"
 #include "VulkanUtils.h"
 
 namespace pose_estimation {
@@ -42,6 +47,10 @@ class VulkanContext {
 
     uint32_t workgroupSize() const { return mWorkGroupSize; }
 
+    const VkPhysicalDeviceProperties& physicalDeviceProperties() const {
+        return mPhysicalDeviceProperties;
+    }
+
     // Find a suitable memory type that matches the memoryTypeBits and the required properties.
     uint32_t findMemoryType(uint32_t memoryTypeBits, VkFlags properties) const;
 
@@ -52,6 +61,16 @@ class VulkanContext {
 
     bool supportsAndroidSyncFence() const { return mPfnVkGetFenceFd != nullptr; }
 
+    // Whether vkCmdWriteTimestamp is supported on the queue
+    bool supportsTimestamps() const { return mTimestampValidBits > 0; }
+
+    // Converts the value of a timestamp query to nanoseconds of the GPU clock
+    int64_t timestampToNs(uint64_t timestamp) const;
+
+    // The difference between CLOCK_MONOTONIC and the GPU clock in nanoseconds, or std::nullopt if
+    // VK_EXT_calibrated_timestamps is not supported
+    std::optional<int64_t> getGpuToMonotonicOffsetNs() const;
+
    private:
     // Instance
     VkInstance mInstance = VK_NULL_HANDLE;
@@ -61,6 +80,7 @@ class VulkanContext {
     VkPhysicalDeviceProperties mPhysicalDeviceProperties{};
     VkPhysicalDeviceMemoryProperties mPhysicalDeviceMemoryProperties{};
     uint32_t mQueueFamilyIndex = 0;
+    uint32_t mTimestampValidBits = 0;
     uint32_t mWorkGroupSize = 32;
 
     // Logical device and queue
@@ -69,6 +89,7 @@ class VulkanContext {
 
     // Extension functions
     PFN_vkGetFenceFdKHR mPfnVkGetFenceFd = nullptr;
+    PFN_vkGetCalibratedTimestampsEXT mPfnVkGetCalibratedTimestamps = nullptr;
 };
 
 // Manages a Vulkan sampled image imported from an AHardwareBuffer
@@ -93,8 +114,30 @@ class VulkanAHardwareBufferImage {
     VkSamplerYcbcrConversion mConversion = VK_NULL_HANDLE;
 };
 
+// Manages a Vulkan buffer in host-visible and coherent memory, mapped for its whole lifetime
+class VulkanHostBuffer {
+    DISABLE_COPY_AND_ASSIGN(VulkanHostBuffer);
+
+   public:
+    VulkanHostBuffer(VulkanContext* context, VkDeviceSize size, VkBufferUsageFlags usage);
+    ~VulkanHostBuffer();
+
+    VkBuffer buffer() const { return mBuffer; }
+    VkDeviceSize size() const { return mSize; }
+    void* data() const { return mData; }
+
+   private:
+    VulkanContext* mContext;
+    VkDeviceSize mSize;
+    VkBuffer mBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory mMemory = VK_NULL_HANDLE;
+    void* mData = nullptr;
+};
+
 // Manages a Vulkan compute pipeline with an AHardwareBuffer as the input texture
-// A VulkanComputePipeline is exclusive for an camera input AHardwareBuffer
+// A VulkanComputePipeline is exclusive for an camera input AHardwareBuffer. With the raw YUV camera
+// input, a single VulkanComputePipeline without a camera input AHardwareBuffer reads the camera
+// planes copied by VulkanComputeRenderer::uploadCameraPlanes instead.
 class VulkanComputePipeline {
     DISABLE_COPY_AND_ASSIGN(VulkanComputePipeline);
 
@@ -103,24 +146,34 @@ class VulkanComputePipeline {
                           AHardwareBuffer* cameraInput);
     ~VulkanComputePipeline();
 
-    VkCommandBuffer commandBuffer() const { return mCommandBuffer; }
+    // Returns the command buffer rendering to the output buffer of the given slot
+    // The descriptor set and the command buffer of a slot are created on first use, and the
+    // command buffer is recorded again after the buffer of the camera planes of the slot is
+    // replaced
+    VkCommandBuffer commandBuffer(uint32_t slot);
 
    private:
+    void recordCommandBuffer(uint32_t slot);
+    void writeCameraInputDescriptor(uint32_t slot);
+
     // Context
     VulkanContext* mContext = nullptr;
     VulkanComputeRenderer* mRenderer = nullptr;
 
-    // Camera input
-    VulkanAHardwareBufferImage mCameraTexture;
+    // Camera input, nullptr with the raw YUV camera input
+    std::unique_ptr<VulkanAHardwareBufferImage> mCameraTexture;
 
     // Compute pipeline
     VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
-    VkDescriptorSet mDescriptorSet = VK_NULL_HANDLE;
     VkPipelineLayout mPipelineLayout = VK_NULL_HANDLE;
     VkPipeline mPipeline = VK_NULL_HANDLE;
 
-    // Command buffer
-    VkCommandBuffer mCommandBuffer = VK_NULL_HANDLE;
+    // Descriptor sets and command buffers, one per slot
+    std::vector<VkDescriptorSet> mDescriptorSets;
+    std::vector<VkCommandBuffer> mCommandBuffers;
+    // With the raw YUV camera input, the buffer of the camera planes in the descriptor set of each
+    // slot
+    std::vector<VkBuffer> mBoundCameraPlaneBuffers;
 };
 
 class VulkanComputeRenderer : public RendererBase {
@@ -129,14 +182,32 @@ class VulkanComputeRenderer : public RendererBase {
                           const float* textureTransform);
     ~VulkanComputeRenderer() override;
 
-    void setOutputFromHardwareBuffer(AHardwareBuffer* ahwb) override;
+    void setOutputFromHardwareBuffer(uint32_t slot, AHardwareBuffer* ahwb) override;
+
+    UniqueFd run(AHardwareBuffer* cameraInput, uint32_t slot, bool preferSyncFence) override;
+
+    RenderTiming getTiming(uint32_t slot) override;
+
+    void onCameraBufferReleased(AHardwareBuffer* cameraInput) override;
 
-    UniqueFd run(AHardwareBuffer* cameraInput, bool preferSyncFence) override;
+    void setTextureTransform(const float* textureTransform) override;
+
+    using ComputePipelineCache = CameraImportCache<VulkanComputePipeline>;
+
+    // The counters of the per-AHardwareBuffer compute pipeline cache
+    ComputePipelineCache::Stats computePipelineCacheStats() const {
+        return mCachedComputePipelines.stats();
+    }
 
    private:
     friend VulkanComputePipeline;
 
-    std::shared_ptr<VulkanComputePipeline> getComputePipeline(AHardwareBuffer* cameraInput);
+    std::shared_ptr<VulkanComputePipeline> getComputePipeline(AHardwareBuffer* cameraInput,
+                                                              uint32_t slot);
+
+    // With mConfig.rawYuvCameraInput, copies the planes of the camera input to the buffer of the
+    // slot, and writes their layout to the parameter buffer of the slot
+    void uploadCameraPlanes(AHardwareBuffer* cameraInput, uint32_t slot);
 
     // Context
     VulkanContext mContext;
@@ -147,26 +218,49 @@ class VulkanComputeRenderer : public RendererBase {
 
     // Pipeline
     VkShaderModule mShaderModule = VK_NULL_HANDLE;
-    VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+    // Persisted in PoseEstimationConfig::compilationCacheDir, if any
+    std::unique_ptr<VulkanPipelineCache> mPipelineCache;
+    // Written to the uniform buffer of the slot by every VulkanComputeRenderer::run
     std::vector<float> mTextureTransform;
-    // A map of {unique_ahwb_id -> imported_egl_image}.
+    // The compute pipelines created for the camera inputs, see CameraImportCache.
     // A VulkanComputePipeline is exclusive for an camera input AHardwareBuffer. We will cache the
-    // compute pipeline if the unique AHardwareBuffer ID is available, so that we can avoid the
-    // overhead of creating the Vulkan compute pipeline again when the same AHardwareBuffer is
-    // reused for another camera frame.
-    std::map<uint64_t, std::shared_ptr<VulkanComputePipeline>> mCachedComputePipelines;
-    // If the unique AHardwareBuffer ID is not available, we have to create the compute pipeline in
-    // every VulkanComputeRenderer::run. The created compute pipeline will be held here because we
-    // want its lifetime to outlive VulkanComputeRenderer::run for fenced execution. It will be
-    // cleaned up at the beginning of the next VulkanComputeRenderer::run.
-    std::shared_ptr<VulkanComputePipeline> mComputePipelineWithoutId;
-
-    // Output buffer
-    VkBuffer mOutputBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory mOutputBufferMemory = VK_NULL_HANDLE;
+    // compute pipeline, so that we can avoid the overhead of creating the Vulkan compute pipeline
+    // again when the same AHardwareBuffer is reused for another camera frame. The pipelines of the
+    // buffers the camera no longer uses are evicted as new buffers come in, or released with
+    // onCameraBufferReleased.
+    ComputePipelineCache mCachedComputePipelines;
+    // The compute pipeline last run on each slot. Its lifetime must outlive
+    // VulkanComputeRenderer::run for fenced execution, even if it is evicted or released from the
+    // cache. It will be released at the beginning of the next VulkanComputeRenderer::run on the
+    // same slot.
+    std::vector<std::shared_ptr<VulkanComputePipeline>> mComputePipelinesInFlight;
+    // With mConfig.rawYuvCameraInput, the compute pipeline of every camera input
+    std::shared_ptr<VulkanComputePipeline> mRawYuvComputePipeline;
+
+    // The uniform buffers of the shader parameters, i.e. the texture transform and the layout of
+    // the camera planes, and with mConfig.rawYuvCameraInput, the buffers of the camera planes, one
+    // of each per slot. The previous frame of a slot has finished when VulkanComputeRenderer::run
+    // is called on it again, so the buffers are simply rewritten in place, and the recorded
+    // command buffers stay valid. The buffer of the camera planes is only replaced when a camera
+    // image does not fit.
+    std::vector<std::unique_ptr<VulkanHostBuffer>> mParameterBuffers;
+    std::vector<std::unique_ptr<VulkanHostBuffer>> mCameraPlaneBuffers;
+
+    // Output buffers, one per slot
+    struct OutputBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+    };
+    std::vector<OutputBuffer> mOutputBuffers;
 
     // Fence
     VkFence mFence = VK_NULL_HANDLE;
+
+    // GPU timestamps, two per slot at the start and the end of the command buffer. The query pool
+    // is VK_NULL_HANDLE if timestamps are not supported on the queue.
+    VkQueryPool mTimestampQueryPool = VK_NULL_HANDLE;
+    // The timestamps of the frame last rendered on each slot
+    std::vector<FrameTimestamps> mFrameTimestamps;
 };
 
 }  // namespace pose_estimation
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VulkanPipelineCache.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pose_estimation {
+namespace {
+
+constexpr uint32_t kFileMagic = 0x50435056;  // "VPCP"
+constexpr uint32_t kFileVersion = 1;
+constexpr char kFileName[] = "vulkan_pipeline_cache.bin";
+
+CompilationCacheToken checksum(const std::vector<uint8_t>& data) {
+    CompilationCacheTokenBuilder builder;
+    builder.update(data.data(), data.size());
+    return builder.finish();
+}
+
+// The number of bytes from the current position to the end of the file, or -1 on failure
+long remainingFileSize(FILE* file) {
+    const long position = ftell(file);
+    if (position < 0 || fseek(file, 0, SEEK_END) != 0) return -1;
+    const long end = ftell(file);
+    if (end < 0 || fseek(file, position, SEEK_SET) != 0) return -1;
+    return end - position;
+}
+
+}  // namespace
+
+VulkanPipelineCache::VulkanPipelineCache(VkDevice device,
+                                         const VkPhysicalDeviceProperties& properties,
+                                         std::string cacheDir, const CompilationCacheToken& key)
+    : mDevice(device), mProperties(properties), mKey(key) {
+    if (!cacheDir.empty()) {
+        mPath = std::move(cacheDir) + "/" + kFileName;
+    }
+
+    const std::vector<uint8_t> initialData = load();
+    mWarm = !initialData.empty();
+    if (mWarm) mLoadedChecksum = checksum(initialData);
+    const VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .initialDataSize = initialData.size(),
+            .pInitialData = initialData.empty() ? nullptr : initialData.data(),
+    };
+    CALL_VK(vkCreatePipelineCache, mDevice, &pipelineCacheCreateInfo, nullptr, &mPipelineCache);
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+    if (!mPath.empty()) save();
+    vkDestroyPipelineCache(mDevice, mPipelineCache, nullptr);
+}
+
+VulkanPipelineCache::FileHeader VulkanPipelineCache::makeHeader() const {
+    FileHeader header = {
+            .magic = kFileMagic,
+            .version = kFileVersion,
+            .vendorId = mProperties.vendorID,
+            .deviceId = mProperties.deviceID,
+            .driverVersion = mProperties.driverVersion,
+            .key = mKey,
+    };
+    std::memcpy(header.pipelineCacheUuid, mProperties.pipelineCacheUUID, VK_UUID_SIZE);
+    return header;
+}
+
+std::vector<uint8_t> VulkanPipelineCache::load() const {
+    if (mPath.empty()) return {};
+    FILE* file = fopen(mPath.c_str(), "rb");
+    if (file == nullptr) {
+        LOGI("No Vulkan pipeline cache at %s", mPath.c_str());
+        return {};
+    }
+
+    // Only accept data written for the same device, driver and key, in full
+    const FileHeader expected = makeHeader();
+    FileHeader header;
+    std::vector<uint8_t> data;
+    const char* error = nullptr;
+    if (fread(&header, sizeof(header), 1, file) != 1) {
+        error = "truncated header";
+    } else if (header.magic != expected.magic || header.version != expected.version) {
+        error = "unknown file format";
+    } else if (header.vendorId != expected.vendorId || header.deviceId != expected.deviceId ||
+               std::memcmp(header.pipelineCacheUuid, expected.pipelineCacheUuid, VK_UUID_SIZE)) {
+        error = "different device";
+    } else if (header.driverVersion != expected.driverVersion) {
+        error = "different driver version";
+    } else if (header.key != expected.key) {
+        error = "different shader";
+    } else if (const long remaining = remainingFileSize(file);
+               remaining < 0 || header.dataSize != static_cast<uint64_t>(remaining)) {
+        // Checked before allocating, as the size comes from the file
+        error = "unexpected data size";
+    } else {
+        data.resize(header.dataSize);
+        if (fread(data.data(), 1, data.size(), file) != data.size() || fgetc(file) != EOF) {
+            error = "unexpected data size";
+        } else if (checksum(data) != header.dataChecksum) {
+            error = "corrupted data";
+        }
+    }
+    fclose(file);
+
+    if (error != nullptr) {
+        LOGI("Discarding the Vulkan pipeline cache at %s: %s", mPath.c_str(), error);
+        return {};
+    }
+    LOGI("Loaded %zu bytes of Vulkan pipeline cache from %s", data.size(), mPath.c_str());
+    return data;
+}
+
+void VulkanPipelineCache::save() const {
+    size_t size = 0;
+    CALL_VK(vkGetPipelineCacheData, mDevice, mPipelineCache, &size, nullptr);
+    std::vector<uint8_t> data(size);
+    CALL_VK(vkGetPipelineCacheData, mDevice, mPipelineCache, &size, data.data());
+    data.resize(size);
+
+    FileHeader header = makeHeader();
+    header.dataChecksum = checksum(data);
+    header.dataSize = data.size();
+    if (mWarm && header.dataChecksum == mLoadedChecksum) return;
+
+    // Write a temporary file and rename it over the previous one, which is atomic
+    const std::string tempPath = mPath + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        LOGE("Failed to create %s", tempPath.c_str());
+        return;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(data.data(), 1, data.size(), file) == data.size();
+    written = fflush(file) == 0 && fsync(fileno(file)) == 0 && written;
+    written = fclose(file) == 0 && written;
+    if (!written || rename(tempPath.c_str(), mPath.c_str()) != 0) {
+        LOGE("Failed to write the Vulkan pipeline cache to %s", mPath.c_str());
+        unlink(tempPath.c_str());
+        return;
+    }
+    LOGI("Saved %zu bytes of Vulkan pipeline cache to %s", data.size(), mPath.c_str());
+}
+
+}  // namespace pose_estimation
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_VULKAN_PIPELINE_CACHE_H
+#define NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_VULKAN_PIPELINE_CACHE_H
+
+#include <string>
+#include <vector>
+
+#include "../ml/NnapiCompilationCache.h"
+#include "VulkanUtils.h"
+
+namespace pose_estimation {
+
+// A VkPipelineCache persisted in an app-private directory across launches.
+//
+// The cache data is stored with a header identifying the device, the driver and the shader it has
+// been created with. Data that does not match the current ones, or that has been truncated, is
+// discarded rather than handed to the driver. The data is written back on destruction, through a
+// temporary file renamed over the previous one so that a crash never leaves a partial file behind.
+class VulkanPipelineCache {
+    DISABLE_COPY_AND_ASSIGN(VulkanPipelineCache);
+
+   public:
+    // Persistence is disabled if cacheDir is empty. The key must cover everything the compiled
+    // pipelines depend on besides the device and the driver, e.g. the shader code.
+    VulkanPipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties,
+                        std::string cacheDir, const CompilationCacheToken& key);
+    ~VulkanPipelineCache();
+
+    VkPipelineCache handle() const { return mPipelineCache; }
+
+    // Whether the cache has been seeded with the data of a previous launch
+    bool isWarm() const { return mWarm; }
+
+   private:
+    // The header written in front of the data of vkGetPipelineCacheData
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vendorId;
+        uint32_t deviceId;
+        uint32_t driverVersion;
+        uint8_t pipelineCacheUuid[VK_UUID_SIZE];
+        CompilationCacheToken key;
+        CompilationCacheToken dataChecksum;
+        uint64_t dataSize;
+    };
+
+    FileHeader makeHeader() const;
+    std::vector<uint8_t> load() const;
+    void save() const;
+
+    VkDevice mDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties mProperties;
+    std::string mPath;
+    CompilationCacheToken mKey;
+    CompilationCacheToken mLoadedChecksum = {};
+    VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+    bool mWarm = false;
+};
+
+}  // namespace pose_estimation
+
+#endif  // NNAPI_POSE_ESTIMATION_DEMO_APP_SRC_MAIN_CPP_RENDERER_VULKAN_PIPELINE_CACHE_H
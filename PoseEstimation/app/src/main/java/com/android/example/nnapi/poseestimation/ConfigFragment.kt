@@ -40,7 +40,8 @@ import kotlin.time.ExperimentalTime
  * The Fragment for the configuration screen.
  *
  * It is the starting point of the application for user to choose which camera,
- * GPU renderer, and ML executor to use for the pose estimation task. Once it is
+ * GPU renderer, ML executor, pipeline depth, number of poses, frame dropping and
+ * renderer output precision to use for the pose estimation task. Once it is
  * properly configured, the user can press the "START" button to launch a pose
  * estimation session implemented in PoseEstimationFragment.
  *
@@ -79,9 +80,24 @@ class ConfigFragment : Fragment() {
         configureEnumSpinner<Renderer>(binding.rendererSpinner) {
             configModel.config.renderer = it
         }
-        configureEnumSpinner<MlExecutor>(binding.mlExecutorSpinner) {
+        // Only offer the ML executors whose model assets are packaged
+        val assets = requireContext().assets.list("").orEmpty().toSet()
+        val mlExecutors = enumValues<MlExecutor>().filter { assets.containsAll(it.assets) }
+        configureEnumSpinner(binding.mlExecutorSpinner, mlExecutors.toTypedArray()) {
             configModel.config.mlExecutor = it
         }
+        configureEnumSpinner<PipelineDepth>(binding.pipelineDepthSpinner) {
+            configModel.config.pipelineDepth = it
+        }
+        configureEnumSpinner<MaxNumberOfPoses>(binding.maxNumberOfPosesSpinner) {
+            configModel.config.maxNumberOfPoses = it
+        }
+        configureEnumSpinner<FrameDropPolicy>(binding.frameDropPolicySpinner) {
+            configModel.config.frameDropPolicy = it
+        }
+        configureEnumSpinner<RendererOutput>(binding.rendererOutputSpinner) {
+            configModel.config.rendererOutput = it
+        }
 
         // Button to start the pose estimation fragment
         binding.startButton.setOnClickListener { startCameraPreview() }
@@ -112,16 +128,17 @@ class ConfigFragment : Fragment() {
         }
     }
 
-    // Helper method to setup a spinner with options from a Enum class
+    // Helper method to setup a spinner with options from a Enum class, or a subset of them
     private inline fun <reified T : Enum<T>> configureEnumSpinner(
         spinner: Spinner,
+        values: Array<T> = enumValues<T>(),
         crossinline onItemSelected: (T) -> Unit
     ) {
         spinner.apply {
             adapter = ArrayAdapter(
                 requireContext(),
                 android.R.layout.simple_spinner_item,
-                enumValues<T>()
+                values
             ).apply {
                 setDropDownViewResource(android.R.layout.simple_spinner_dropdown_item)
             }
@@ -132,7 +149,7 @@ class ConfigFragment : Fragment() {
                     position: Int,
                     id: Long
                 ) {
-                    onItemSelected(enumValues<T>()[position])
+                    onItemSelected(values[position])
                 }
 
                 override fun onNothingSelected(parent: AdapterView<*>?) {}
@@ -158,7 +175,8 @@ class ConfigFragment : Fragment() {
     private fun checkConfiguration(): Boolean {
         val pm = requireActivity().packageManager
         when (configModel.config.renderer) {
-            Renderer.GLES -> {
+            // AUTO picks among the GLES and CPU renderers
+            Renderer.GLES, Renderer.AUTO -> {
                 // GLES 3.1 is required
                 val glesVersion =
                     pm.systemAvailableFeatures.find { it.name == null }?.reqGlEsVersion ?: 0
@@ -184,6 +202,9 @@ class ConfigFragment : Fragment() {
                     return false
                 }
             }
+            Renderer.CPU -> {
+                // The CPU renderer runs on any device
+            }
         }
         return true
     }
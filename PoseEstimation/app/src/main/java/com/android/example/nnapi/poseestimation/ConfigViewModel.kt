@@ -28,13 +28,45 @@ enum class CameraFacing(val value: Int) {
 // Corresponds to Renderer in cpp/PoseEstimationConfig.h
 @Keep
 enum class Renderer(val value: Int) {
-    VULKAN(0), GLES(1)
+    VULKAN(0), GLES(1), CPU(2), AUTO(3)
 }
 
-// Corresponds to MlExecutor in cpp/PoseEstimationConfig.h
+// Corresponds to MlExecutor in cpp/PoseEstimationConfig.h, with the model assets it loads.
+// The quantized model assets are only there if tools/quantize_model.py has been run.
 @Keep
-enum class MlExecutor(val value: Int) {
-    NATIVE_NNAPI(0)
+enum class MlExecutor(val value: Int, val assets: List<String>) {
+    NATIVE_NNAPI(0, listOf("model_graph.bin", "model_data.bin")),
+    NATIVE_NNAPI_QUANT8(1, listOf("model_graph_quant8.bin", "model_data_quant8.bin"))
+}
+
+// The precision of the model input written by the renderer, corresponds to float16RendererOutput
+// in cpp/PoseEstimationConfig.h. FLOAT16 only applies to NATIVE_NNAPI.
+enum class RendererOutput(val float16: Boolean) {
+    FLOAT32(false), FLOAT16(true)
+}
+
+// The number of camera frames in flight, corresponds to pipelineDepth in
+// cpp/PoseEstimationConfig.h
+enum class PipelineDepth(val value: Int) {
+    SERIAL(1), DOUBLE_BUFFERED(2), TRIPLE_BUFFERED(3)
+}
+
+// The maximum number of persons to detect, corresponds to maxNumberOfPoses in
+// cpp/PoseEstimationConfig.h
+enum class MaxNumberOfPoses(val value: Int) {
+    SINGLE(1), MULTIPLE(5)
+}
+
+// Which camera frames are dropped when the pipeline falls behind the camera, corresponds to
+// FrameDropPolicy in cpp/PoseEstimationConfig.h with its targetFps and frameDeadlineMs
+enum class FrameDropPolicy(
+    val value: Int,
+    val targetFps: Float = 0.0f,
+    val frameDeadlineMs: Float = 0.0f
+) {
+    LATEST_FRAME_WINS(0),
+    TARGET_FPS_15(1, targetFps = 15.0f),
+    DEADLINE_100_MS(2, frameDeadlineMs = 100.0f)
 }
 
 // The pose estimation pipeline configuration
@@ -44,6 +76,13 @@ data class PoseEstimationConfig(
     // The following fields correspond to PoseEstimationConfig in cpp/PoseEstimationConfig.h
     var renderer: Renderer,
     var mlExecutor: MlExecutor,
+    var pipelineDepth: PipelineDepth,
+    var maxNumberOfPoses: MaxNumberOfPoses,
+    var frameDropPolicy: FrameDropPolicy,
+    var rendererOutput: RendererOutput,
+
+    // The names of the NNAPI devices to pin the compilation to, empty to let the native side pick
+    var nnapiDevices: List<String> = emptyList(),
 )
 
 @ExperimentalTime
@@ -52,5 +91,9 @@ class ConfigViewModel : ViewModel() {
         CameraFacing.BACK,
         Renderer.VULKAN,
         MlExecutor.NATIVE_NNAPI,
+        PipelineDepth.SERIAL,
+        MaxNumberOfPoses.SINGLE,
+        FrameDropPolicy.LATEST_FRAME_WINS,
+        RendererOutput.FLOAT32,
     )
 }
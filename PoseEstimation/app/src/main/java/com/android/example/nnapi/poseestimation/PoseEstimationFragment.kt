@@ -31,6 +31,7 @@ import android.view.*
 import androidx.fragment.app.Fragment
 import androidx.fragment.app.activityViewModels
 import com.android.example.nnapi.poseestimation.databinding.FragmentPoseEstimationBinding
+import java.io.File
 import kotlin.time.ExperimentalTime
 
 /**
@@ -81,6 +82,19 @@ class PoseEstimationFragment : Fragment() {
     }
 
     private fun startPipeline() {
+        // The preview surface has been recreated, e.g. the window has been resized. As long as the
+        // camera size stays the same, only the camera session is restarted, and the initialized
+        // pose estimator is kept with the new preview config rather than compiling the model again.
+        val estimator = poseEstimator
+        if (estimator != null && camera != null &&
+            estimator.cameraSize == cameraPreviewConfig.cameraSize
+        ) {
+            camera?.close()
+            camera = null
+            estimator.updateCameraPreviewConfig(cameraPreviewConfig)
+            poseEstimatorCallback.onInitialized(estimator)
+            return
+        }
         if (camera != null || poseEstimator != null) {
             stopPipeline()
         }
@@ -94,6 +108,11 @@ class PoseEstimationFragment : Fragment() {
     }
 
     private fun stopPipeline() {
+        // Keep the trace of the pipeline, if the native tracer is built in
+        poseEstimator?.dumpTrace(File(requireContext().cacheDir, TRACE_FILE_NAME))
+        poseEstimator?.requestLatencyStats {
+            Log.i(TAG, "latencyStats = $it, dropRate = ${it.dropRate}")
+        }
         camera?.close()
         poseEstimator?.close()
         camera = null
@@ -301,5 +320,8 @@ class PoseEstimationFragment : Fragment() {
 
         // How many iterations to average for the displayed latency
         private const val NUMBER_OF_LATENCIES_TO_AVERAGE = 100
+
+        // The trace of the pipeline written when it stops, in the cache directory of the app
+        private const val TRACE_FILE_NAME = "pose_estimation_trace.json"
     }
 }
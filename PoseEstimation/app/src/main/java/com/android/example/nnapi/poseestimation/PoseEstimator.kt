@@ -25,13 +25,18 @@ import android.graphics.ImageFormat
 import android.graphics.Paint
 import android.graphics.PorterDuff
 import android.hardware.HardwareBuffer
+import android.media.Image
 import android.media.ImageReader
 import android.opengl.Matrix
 import android.os.Handler
 import android.os.HandlerThread
 import android.os.Process
+import android.util.Size
 import android.view.Surface
-import androidx.annotation.Keep
+import java.io.File
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.FloatBuffer
 import kotlin.time.DurationUnit
 import kotlin.time.ExperimentalTime
 import kotlin.time.measureTimedValue
@@ -62,7 +67,7 @@ class PoseEstimator(
     private val callback: Callback,
     private val callbackHandler: Handler
 ) {
-    // The 17 body parts corresponds to the 17 keypoints in the NativeResult
+    // The 17 body parts corresponds to the 17 keypoints of every pose in the native result
     enum class BodyPart {
         NOSE,
         LEFT_EYE,
@@ -83,26 +88,12 @@ class PoseEstimator(
         RIGHT_ANKLE
     }
 
-    // Describes the pose estimation result of a single keypoint,
-    // corresponds to Keypoint in cpp/PoseEstimator.h
-    @Keep
-    private data class Keypoint(val x: Float, val y: Float, val score: Float)
-
-    // The pose estimation result from the native pipeline,
-    // corresponds to PoseEstimationResult in cpp/PoseEstimator.h
-    @Keep
-    private data class NativeResult(
-        val keypoints: Array<Keypoint>,
-        val renderLatencyMs: Float,
-        val mlLatencyMs: Float,
-    )
-
     // The final pose estimation result reported to the callback
     data class Result(
         // The overlay bitmap with annotations for keypoints and joints
         val overlay: Bitmap,
 
-        // The averaged score over all keypoints
+        // The averaged score over all keypoints of the most confident pose
         // This represents the level of confidence that there is a person in the frame
         val score: Float,
 
@@ -110,8 +101,49 @@ class PoseEstimator(
         val totalLatencyMs: Float,
         val renderLatencyMs: Float,
         val mlLatencyMs: Float,
+
+        // The GPU timing of the render in milliseconds, NaN if not measurable on the device
+        val renderQueueWaitMs: Float,
+        val renderGpuExecutionMs: Float,
+        val renderFenceSignalMs: Float,
+
+        // The timing of the ML execution measured by the NNAPI driver in milliseconds, NaN if not
+        // measured. The fenced durations are only measured for the fenced executions.
+        val mlOnHardwareMs: Float,
+        val mlInDriverMs: Float,
+        val mlFencedOnHardwareMs: Float,
+        val mlFencedInDriverMs: Float,
     )
 
+    // The latency percentiles of a pipeline stage over the recent frames in milliseconds, NaN
+    // before the first frame
+    data class StageLatency(
+        val p50Ms: Float,
+        val p90Ms: Float,
+        val p99Ms: Float,
+        val maxMs: Float,
+    )
+
+    // The latency percentiles of every stage of the native pipeline, see PipelineLatencyStats in
+    // cpp/LatencyHistogram.h
+    data class LatencyStats(
+        val render: StageLatency,
+        val fenceWait: StageLatency,
+        val ml: StageLatency,
+        val postprocess: StageLatency,
+        val endToEnd: StageLatency,
+
+        // The frames processed by the native pipeline, and the camera frames dropped while it
+        // was busy or by the frame scheduler
+        val processedFrames: Long,
+        val droppedFrames: Long,
+    ) {
+        // The fraction of the camera frames that were dropped
+        val dropRate: Float
+            get() = if (processedFrames + droppedFrames == 0L) 0.0f
+            else droppedFrames.toFloat() / (processedFrames + droppedFrames)
+    }
+
     // A callback object for receiving updates related to the pose estimation pipeline
     interface Callback {
         // Called when the pose estimator has been successfully initialized
@@ -127,10 +159,46 @@ class PoseEstimator(
         renderer: Int,
         mlExecutor: Int,
         maxNumberOfCameraImages: Int,
+        cameraWidth: Int,
+        cameraHeight: Int,
+        pipelineDepth: Int,
+        compilationCacheDir: String,
+        maxNumberOfPoses: Int,
+        nnapiDevices: Array<String>,
+        frameDropPolicy: Int,
+        targetFps: Float,
+        frameDeadlineMs: Float,
+        float16RendererOutput: Boolean,
     ): Long
 
     private external fun destroyNativePoseEstimator(handle: Long)
-    private external fun estimatePose(handle: Long, buffer: HardwareBuffer): NativeResult
+
+    // Whether the native renderer reads the planes of YUV_420_888 camera images through a CPU
+    // mapping, rather than sampling PRIVATE images on the GPU
+    private external fun usesRawYuvCameraInput(handle: Long): Boolean
+
+    // Replaces the texture transform given to createNativePoseEstimator from the next frame on
+    private external fun setTextureTransform(handle: Long, textureTransform: FloatArray)
+
+    // Counts the camera frames dropped before reaching estimatePose
+    private external fun recordDroppedFrames(handle: Long, count: Int)
+
+    // Fills the stats array, see the LATENCY_STATS_* constants below
+    private external fun getLatencyStats(handle: Long, stats: FloatArray)
+
+    // Writes the events of the native tracer as Chrome trace JSON, see cpp/Trace.h
+    private external fun writeTrace(path: String): Boolean
+
+    // Submits the camera frame captured at timestampNs, unless the native frame scheduler drops
+    // it, and packs the result of the oldest frame in flight into the direct resultBuffer, see the
+    // RESULT_* constants below. Returns the ESTIMATE_* flags below: no result is packed while the
+    // native pipeline is filling up.
+    private external fun estimatePose(
+        handle: Long,
+        buffer: HardwareBuffer,
+        timestampNs: Long,
+        resultBuffer: FloatBuffer
+    ): Int
 
     // The handler thread on which the whole pose estimation pipeline will run
     private val handlerThread =
@@ -141,28 +209,34 @@ class PoseEstimator(
     private var nativePoseEstimator: Long = 0
 
     // Camera input
-    private val cameraImageReader = ImageReader.newInstance(
-        cameraPreviewConfig.cameraSize.width,
-        cameraPreviewConfig.cameraSize.height,
-        ImageFormat.PRIVATE,
-        NUMBER_OF_SWAP_IMAGES,
-        HardwareBuffer.USAGE_GPU_SAMPLED_IMAGE
-    )
+    // Each frame in flight holds on to its camera image until the native pipeline returns the
+    // result, so we need that many more images on top of the swap images.
+    // The CPU renderer and the raw YUV input of the GLES renderer read the YUV planes directly,
+    // the other renderers sample an opaque image. Renderer.AUTO only picks the renderer when the
+    // native pipeline is created, so the ImageReader is created after it.
+    private val pipelineDepth = poseEstimationConfig.pipelineDepth.value
+    private val maxCameraImages = NUMBER_OF_SWAP_IMAGES + pipelineDepth - 1
+    val cameraSize: Size = cameraPreviewConfig.cameraSize
+    private lateinit var cameraImageReader: ImageReader
     val cameraSurface: Surface get() = cameraImageReader.surface
 
+    // The camera images submitted to the native pipeline whose results are not returned yet,
+    // ordered from the oldest to the newest
+    private val imagesInFlight = ArrayDeque<Pair<Image, HardwareBuffer>>()
+
+    // The native result, written in place on every frame
+    private val nativeResult = ByteBuffer
+        .allocateDirect(resultSize(poseEstimationConfig.maxNumberOfPoses.value) * Float.SIZE_BYTES)
+        .order(ByteOrder.nativeOrder())
+        .asFloatBuffer()
+
     // Overlay result
     private val paint = Paint().apply {
         color = Color.BLUE
         textSize = 50.0f
         strokeWidth = 8.0f
     }
-    private val overlayBitmaps = Array<Bitmap>(NUMBER_OF_SWAP_IMAGES) {
-        Bitmap.createBitmap(
-            cameraPreviewConfig.displaySize.width,
-            cameraPreviewConfig.displaySize.height,
-            Bitmap.Config.ARGB_8888
-        )
-    }
+    private var overlayBitmaps = createOverlayBitmaps(cameraPreviewConfig.displaySize)
     private var currentImageIndex = 0
 
     init {
@@ -172,7 +246,26 @@ class PoseEstimator(
                 getTextureTransform(cameraPreviewConfig),
                 poseEstimationConfig.renderer.value,
                 poseEstimationConfig.mlExecutor.value,
-                cameraImageReader.maxImages + 1,
+                maxCameraImages + 1,
+                cameraPreviewConfig.cameraSize.width,
+                cameraPreviewConfig.cameraSize.height,
+                pipelineDepth,
+                context.codeCacheDir.absolutePath,
+                poseEstimationConfig.maxNumberOfPoses.value,
+                poseEstimationConfig.nnapiDevices.toTypedArray(),
+                poseEstimationConfig.frameDropPolicy.value,
+                poseEstimationConfig.frameDropPolicy.targetFps,
+                poseEstimationConfig.frameDropPolicy.frameDeadlineMs,
+                poseEstimationConfig.rendererOutput.float16,
+            )
+            val rawYuv = usesRawYuvCameraInput(nativePoseEstimator)
+            cameraImageReader = ImageReader.newInstance(
+                cameraPreviewConfig.cameraSize.width,
+                cameraPreviewConfig.cameraSize.height,
+                if (rawYuv) ImageFormat.YUV_420_888 else ImageFormat.PRIVATE,
+                maxCameraImages,
+                if (rawYuv) HardwareBuffer.USAGE_CPU_READ_OFTEN
+                else HardwareBuffer.USAGE_GPU_SAMPLED_IMAGE
             )
             cameraImageReader.setOnImageAvailableListener({ run(it) }, handler)
             callbackHandler.post { callback.onInitialized(this) }
@@ -181,40 +274,118 @@ class PoseEstimator(
 
     // Process one camera frame from the ImageReader
     private fun run(reader: ImageReader) {
-        val image = reader.acquireLatestImage() ?: return
+        // Every callback follows a new camera frame. If there is no image left, the frame has
+        // been skipped by acquireLatestImage in a previous callback, while the pipeline was busy.
+        val image = reader.acquireLatestImage() ?: run {
+            recordDroppedFrames(nativePoseEstimator, 1)
+            return
+        }
 
         // We expect the image to be backed by HardwareBuffer because the ImageReader
-        // is constructed with PRIVATE format and GPU usage
+        // is constructed with a HardwareBuffer usage
         val buffer = image.hardwareBuffer
             ?: throw RuntimeException("expect images from ImageReader backed by HardwareBuffer")
 
         // Run native pose estimation pipeline
-        val (nativeResult, duration) = measureTimedValue {
-            estimatePose(nativePoseEstimator, buffer)
+        // A dropped frame is released right away. The native pipeline may still return the result
+        // of an earlier frame in flight, so that the keypoints do not lag behind.
+        val (status, duration) = measureTimedValue {
+            estimatePose(nativePoseEstimator, buffer, image.timestamp, nativeResult)
         }
+        if (status and ESTIMATE_FRAME_SUBMITTED != 0) {
+            imagesInFlight.addLast(Pair(image, buffer))
+        } else {
+            buffer.close()
+            image.close()
+        }
+        if (status and ESTIMATE_HAS_RESULT == 0) return
 
         // Draw the overlay bitmap
+        val numberOfPoses = nativeResult[RESULT_NUMBER_OF_POSES].toInt()
         val overlay = overlayBitmaps[currentImageIndex]
-        drawOverlay(overlay, nativeResult.keypoints)
+        drawOverlay(overlay, numberOfPoses)
         currentImageIndex = (currentImageIndex + 1) % NUMBER_OF_SWAP_IMAGES
 
         // Compose the final pose estimation result
+        var score = 0.0f
+        for (pose in 0 until numberOfPoses) {
+            score = maxOf(score, nativeResult[RESULT_HEADER_SIZE + pose * RESULT_POSE_SIZE])
+        }
         val result = Result(
             overlay,
-            score = nativeResult.keypoints.map { it.score }.average().toFloat(),
+            score = score,
             totalLatencyMs = duration.toDouble(DurationUnit.MILLISECONDS).toFloat(),
-            renderLatencyMs = nativeResult.renderLatencyMs,
-            mlLatencyMs = nativeResult.mlLatencyMs,
+            renderLatencyMs = nativeResult[RESULT_RENDER_LATENCY_MS],
+            mlLatencyMs = nativeResult[RESULT_ML_LATENCY_MS],
+            renderQueueWaitMs = nativeResult[RESULT_RENDER_QUEUE_WAIT_MS],
+            renderGpuExecutionMs = nativeResult[RESULT_RENDER_GPU_EXECUTION_MS],
+            renderFenceSignalMs = nativeResult[RESULT_RENDER_FENCE_SIGNAL_MS],
+            mlOnHardwareMs = nativeResult[RESULT_ML_ON_HARDWARE_MS],
+            mlInDriverMs = nativeResult[RESULT_ML_IN_DRIVER_MS],
+            mlFencedOnHardwareMs = nativeResult[RESULT_ML_FENCED_ON_HARDWARE_MS],
+            mlFencedInDriverMs = nativeResult[RESULT_ML_FENCED_IN_DRIVER_MS],
         )
         callbackHandler.post { callback.onResult(result) }
 
-        buffer.close()
-        image.close()
+        // The result belongs to the oldest frame in flight, its camera image can be released now
+        imagesInFlight.removeFirst().let { (oldestImage, oldestBuffer) ->
+            oldestBuffer.close()
+            oldestImage.close()
+        }
+    }
+
+    // Applies a new display rotation or size, without rebuilding the native pipeline and compiling
+    // the model again. The camera size must stay the same, as the ImageReader is kept.
+    fun updateCameraPreviewConfig(cameraPreviewConfig: CameraPreviewConfig) {
+        check(cameraPreviewConfig.cameraSize == cameraSize)
+        val textureTransform = getTextureTransform(cameraPreviewConfig)
+        handler.post {
+            setTextureTransform(nativePoseEstimator, textureTransform)
+            val displaySize = cameraPreviewConfig.displaySize
+            if (displaySize.width != overlayBitmaps[0].width ||
+                displaySize.height != overlayBitmaps[0].height
+            ) {
+                overlayBitmaps = createOverlayBitmaps(displaySize)
+            }
+        }
     }
 
+    // Queries the latency percentiles of the recent frames on the pipeline thread, and reports
+    // them on the callback handler
+    fun requestLatencyStats(onLatencyStats: (LatencyStats) -> Unit) {
+        handler.post {
+            val stats = FloatArray(LATENCY_STATS_SIZE)
+            getLatencyStats(nativePoseEstimator, stats)
+            val stageLatency = { stage: Int ->
+                val offset = stage * LATENCY_STATS_STAGE_SIZE
+                StageLatency(stats[offset], stats[offset + 1], stats[offset + 2], stats[offset + 3])
+            }
+            val latencyStats = LatencyStats(
+                render = stageLatency(0),
+                fenceWait = stageLatency(1),
+                ml = stageLatency(2),
+                postprocess = stageLatency(3),
+                endToEnd = stageLatency(4),
+                processedFrames = stats[LATENCY_STATS_PROCESSED_FRAMES].toLong(),
+                droppedFrames = stats[LATENCY_STATS_DROPPED_FRAMES].toLong(),
+            )
+            callbackHandler.post { onLatencyStats(latencyStats) }
+        }
+    }
+
+    // Writes the pipeline stages recorded so far to the file, which chrome://tracing and
+    // ui.perfetto.dev open. Returns false if the native library is built without
+    // POSE_ESTIMATION_TRACING, see cpp/CMakeLists.txt.
+    fun dumpTrace(file: File): Boolean = writeTrace(file.absolutePath)
+
     fun close() {
         handler.post {
             destroyNativePoseEstimator(nativePoseEstimator)
+            imagesInFlight.forEach { (image, buffer) ->
+                buffer.close()
+                image.close()
+            }
+            imagesInFlight.clear()
             cameraImageReader.close()
         }
         handlerThread.quitSafely()
@@ -244,16 +415,30 @@ class PoseEstimator(
         }
     }
 
-    private fun drawOverlay(overlay: Bitmap, keypoints: Array<Keypoint>) {
+    private fun createOverlayBitmaps(displaySize: Size) = Array<Bitmap>(NUMBER_OF_SWAP_IMAGES) {
+        Bitmap.createBitmap(displaySize.width, displaySize.height, Bitmap.Config.ARGB_8888)
+    }
+
+    private fun drawOverlay(overlay: Bitmap, numberOfPoses: Int) {
         val canvas = Canvas(overlay)
         canvas.drawColor(Color.TRANSPARENT, PorterDuff.Mode.CLEAR)
+        for (pose in 0 until numberOfPoses) {
+            drawPose(canvas, pose)
+        }
+    }
 
+    // The index in nativeResult of the x of a keypoint, followed by its y and score
+    private fun keypointIndex(pose: Int, bodyPart: Int): Int =
+        RESULT_HEADER_SIZE + pose * RESULT_POSE_SIZE + 1 + bodyPart * 3
+
+    private fun drawPose(canvas: Canvas, pose: Int) {
         // Draw keypoints
-        keypoints.forEach { keypoint ->
-            if (keypoint.score >= KEYPOINT_SCORE_THRESHOLD) {
+        for (bodyPart in 0 until NUMBER_OF_KEYPOINTS) {
+            val keypoint = keypointIndex(pose, bodyPart)
+            if (nativeResult[keypoint + 2] >= KEYPOINT_SCORE_THRESHOLD) {
                 canvas.drawCircle(
-                    keypoint.x * canvas.width,
-                    keypoint.y * canvas.height,
+                    nativeResult[keypoint] * canvas.width,
+                    nativeResult[keypoint + 1] * canvas.height,
                     8.0f,
                     paint
                 )
@@ -261,18 +446,17 @@ class PoseEstimator(
         }
 
         // Draw body joints
-        check(keypoints.size == BodyPart.values().size)
-        BODY_JOINTS.forEach { joint ->
-            val firstKeypoint = keypoints[joint.first.ordinal]
-            val secondKeypoint = keypoints[joint.second.ordinal]
-            if (firstKeypoint.score >= KEYPOINT_SCORE_THRESHOLD &&
-                secondKeypoint.score >= KEYPOINT_SCORE_THRESHOLD
+        for ((first, second) in BODY_JOINTS) {
+            val firstKeypoint = keypointIndex(pose, first.ordinal)
+            val secondKeypoint = keypointIndex(pose, second.ordinal)
+            if (nativeResult[firstKeypoint + 2] >= KEYPOINT_SCORE_THRESHOLD &&
+                nativeResult[secondKeypoint + 2] >= KEYPOINT_SCORE_THRESHOLD
             ) {
                 canvas.drawLine(
-                    firstKeypoint.x * canvas.width,
-                    firstKeypoint.y * canvas.height,
-                    secondKeypoint.x * canvas.width,
-                    secondKeypoint.y * canvas.height,
+                    nativeResult[firstKeypoint] * canvas.width,
+                    nativeResult[firstKeypoint + 1] * canvas.height,
+                    nativeResult[secondKeypoint] * canvas.width,
+                    nativeResult[secondKeypoint + 1] * canvas.height,
                     paint
                 )
             }
@@ -288,6 +472,40 @@ class PoseEstimator(
         // Keypoint with a score less than this value will not be drawn
         private const val KEYPOINT_SCORE_THRESHOLD = 0.5f
 
+        // The layout of the native result, corresponds to PackedResultLayout in
+        // cpp/PoseEstimator.h. The header comes first, then every pose as its score followed by
+        // the x, y and score of its keypoints. The latencies are in milliseconds, and the GPU and
+        // driver timings are NaN if not measured, see Result.
+        private const val RESULT_NUMBER_OF_POSES = 0
+        private const val RESULT_RENDER_LATENCY_MS = 1
+        private const val RESULT_ML_LATENCY_MS = 2
+        private const val RESULT_RENDER_QUEUE_WAIT_MS = 3
+        private const val RESULT_RENDER_GPU_EXECUTION_MS = 4
+        private const val RESULT_RENDER_FENCE_SIGNAL_MS = 5
+        private const val RESULT_ML_ON_HARDWARE_MS = 6
+        private const val RESULT_ML_IN_DRIVER_MS = 7
+        private const val RESULT_ML_FENCED_ON_HARDWARE_MS = 8
+        private const val RESULT_ML_FENCED_IN_DRIVER_MS = 9
+        private const val RESULT_HEADER_SIZE = 10
+        private val NUMBER_OF_KEYPOINTS = BodyPart.values().size
+        private val RESULT_POSE_SIZE = 1 + NUMBER_OF_KEYPOINTS * 3
+
+        private fun resultSize(maxNumberOfPoses: Int) =
+            RESULT_HEADER_SIZE + maxNumberOfPoses * RESULT_POSE_SIZE
+
+        // The status flags returned by estimatePose, correspond to EstimateStatus in
+        // cpp/PoseEstimationDemo_jni.cpp
+        private const val ESTIMATE_FRAME_SUBMITTED = 1
+        private const val ESTIMATE_HAS_RESULT = 2
+
+        // The layout of the native latency stats, corresponds to getLatencyStats in
+        // cpp/PoseEstimationDemo_jni.cpp. The p50, p90, p99 and max of the render, fence wait,
+        // ML, postprocess and end-to-end stages come first, then the frame counts.
+        private const val LATENCY_STATS_STAGE_SIZE = 4
+        private const val LATENCY_STATS_PROCESSED_FRAMES = 5 * LATENCY_STATS_STAGE_SIZE
+        private const val LATENCY_STATS_DROPPED_FRAMES = LATENCY_STATS_PROCESSED_FRAMES + 1
+        private const val LATENCY_STATS_SIZE = LATENCY_STATS_DROPPED_FRAMES + 1
+
         // List of body joints that should be connected
         private val BODY_JOINTS = listOf(
             Pair(BodyPart.LEFT_WRIST, BodyPart.LEFT_ELBOW),
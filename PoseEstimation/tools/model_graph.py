@@ -0,0 +1,231 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2021 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""Writes the binary model graph consumed by app/src/main/cpp/ml/NnapiModelGraph.cpp.
+
+The graph describes the operands, operations and model inputs and outputs of an NNAPI model. Large
+constant operands refer to a region of the model data file, which is shipped as a separate asset.
+See NnapiModelGraph.h for the layout of the format.
+
+The graph can be converted from the C++ source generated for the NNAPI delegate, i.e. a function
+calling ANeuralNetworksModel_addOperand, setOperandValue(FromMemory), addOperation and
+identifyInputsAndOutputs:
+
+    model_graph.py --from-generated-cpp NnapiModel.cpp model_graph.bin
+"""
+
+import argparse
+import re
+import struct
+
+MAGIC = 0x52474E4E  # "NNGR"
+VERSION = 1
+
+VALUE_NONE = 0
+VALUE_INLINE = 1
+VALUE_MODEL_DATA = 2
+
+# The subset of the NNAPI operand and operation codes understood by the converter
+OPERAND_TYPES = {
+    'ANEURALNETWORKS_FLOAT32': 0,
+    'ANEURALNETWORKS_INT32': 1,
+    'ANEURALNETWORKS_UINT32': 2,
+    'ANEURALNETWORKS_TENSOR_FLOAT32': 3,
+    'ANEURALNETWORKS_TENSOR_INT32': 4,
+    'ANEURALNETWORKS_TENSOR_QUANT8_ASYMM': 5,
+    'ANEURALNETWORKS_BOOL': 6,
+    'ANEURALNETWORKS_TENSOR_QUANT8_ASYMM_SIGNED': 14,
+}
+OPERATION_TYPES = {
+    'ANEURALNETWORKS_ADD': 0,
+    'ANEURALNETWORKS_AVERAGE_POOL_2D': 1,
+    'ANEURALNETWORKS_CONCATENATION': 2,
+    'ANEURALNETWORKS_CONV_2D': 3,
+    'ANEURALNETWORKS_DEPTHWISE_CONV_2D': 4,
+    'ANEURALNETWORKS_DEQUANTIZE': 6,
+    'ANEURALNETWORKS_LOGISTIC': 14,
+    'ANEURALNETWORKS_MAX_POOL_2D': 17,
+    'ANEURALNETWORKS_MUL': 18,
+    'ANEURALNETWORKS_RELU': 19,
+    'ANEURALNETWORKS_RESHAPE': 22,
+    'ANEURALNETWORKS_QUANTIZE': 72,
+}
+
+
+class Operand:
+    def __init__(self, type_code, dimensions, scale=0.0, zero_point=0):
+        self.type_code = type_code
+        self.dimensions = list(dimensions)
+        self.scale = scale
+        self.zero_point = zero_point
+        self.value = None
+        self.model_data_region = None
+
+
+class Graph:
+    def __init__(self):
+        self.operands = []
+        self.operations = []
+        self.inputs = []
+        self.outputs = []
+
+    def add_operand(self, type_code, dimensions, scale=0.0, zero_point=0):
+        self.operands.append(Operand(type_code, dimensions, scale, zero_point))
+        return len(self.operands) - 1
+
+    def set_operand_value(self, index, value):
+        self.operands[index].value = bytes(value)
+
+    def set_operand_value_from_model_data(self, index, offset, length):
+        self.operands[index].model_data_region = (offset, length)
+
+    def add_operation(self, type_code, inputs, outputs):
+        self.operations.append((type_code, list(inputs), list(outputs)))
+
+    def identify_inputs_and_outputs(self, inputs, outputs):
+        self.inputs = list(inputs)
+        self.outputs = list(outputs)
+
+    def serialize(self):
+        words = lambda values: struct.pack('<%dI' % len(values), *values)
+        out = bytearray(words([MAGIC, VERSION, len(self.operands), len(self.operations),
+                               len(self.inputs), len(self.outputs)]))
+        for operand in self.operands:
+            out += struct.pack('<iI', operand.type_code, len(operand.dimensions))
+            out += words(operand.dimensions)
+            out += struct.pack('<fi', operand.scale, operand.zero_point)
+            if operand.value is not None:
+                out += words([VALUE_INLINE, len(operand.value)])
+                out += operand.value + b'\0' * (-len(operand.value) % 4)
+            elif operand.model_data_region is not None:
+                out += words([VALUE_MODEL_DATA, *operand.model_data_region])
+            else:
+                out += words([VALUE_NONE])
+        for type_code, inputs, outputs in self.operations:
+            out += struct.pack('<iI', type_code, len(inputs)) + words(inputs)
+            out += words([len(outputs)]) + words(outputs)
+        out += words(self.inputs) + words(self.outputs)
+        return bytes(out)
+
+    @staticmethod
+    def deserialize(data):
+        """Reads a graph written by serialize."""
+        offset = 0
+
+        def read(count=1):
+            nonlocal offset
+            values = struct.unpack_from('<%dI' % count, data, offset)
+            offset += 4 * count
+            return list(values)
+
+        magic, version, operand_count, operation_count, input_count, output_count = read(6)
+        if magic != MAGIC or version != VERSION:
+            raise ValueError('unsupported model graph: magic 0x%08x, version %d' % (magic, version))
+        graph = Graph()
+        for _ in range(operand_count):
+            type_code, dimension_count = struct.unpack_from('<iI', data, offset)
+            offset += 8
+            dimensions = read(dimension_count)
+            scale, zero_point = struct.unpack_from('<fi', data, offset)
+            offset += 8
+            index = graph.add_operand(type_code, dimensions, scale, zero_point)
+            value_source, = read()
+            if value_source == VALUE_INLINE:
+                length, = read()
+                graph.set_operand_value(index, data[offset:offset + length])
+                offset += (length + 3) & ~3
+            elif value_source == VALUE_MODEL_DATA:
+                graph.set_operand_value_from_model_data(index, *read(2))
+        for _ in range(operation_count):
+            type_code, = struct.unpack_from('<i', data, offset)
+            offset += 4
+            inputs = read(read()[0])
+            outputs = read(read()[0])
+            graph.add_operation(type_code, inputs, outputs)
+        graph.identify_inputs_and_outputs(read(input_count), read(output_count))
+        return graph
+
+
+def parse_int_list(text):
+    return [int(value) for value in text.replace('\n', ' ').split(',') if value.strip()]
+
+
+def from_generated_cpp(source):
+    """Replays the NNAPI calls of a generated model source into a Graph."""
+    graph = Graph()
+    types = {}
+    operand_indexes = {}
+    statement = re.compile(
+        r'ANeuralNetworksOperandType (?P<type_decl>\w+);'
+        r'|(?P<type_field>\w+)\.(?P<field>type|scale|zeroPoint) = (?P<field_value>[\w.\-]+);'
+        r'|uint32_t (?P<dims_name>\w+)Dims\[\] = \{(?P<dims>[^}]*)\};'
+        r'|ANeuralNetworksModel_addOperand\(model, &(?P<add_type>\w+)\);\s*'
+        r'uint32_t (?P<operand_name>\w+) = operandIndex\+\+;'
+        r'|ANeuralNetworksModel_setOperandValueFromMemory\(model, (?P<memory_operand>\w+), memory,'
+        r'\s*(?P<offset>\d+),\s*(?P<length>\d+)\);'
+        r'|uint8_t (?P<value_name>\w+)Value\[\] = \{(?P<value>[^}]*)\};'
+        r'|uint32_t operation\d+InputIndexes\[\] = \{(?P<op_inputs>[^}]*)\};\s*'
+        r'uint32_t operation\d+OutputIndexes\[\] = \{(?P<op_outputs>[^}]*)\};\s*'
+        r'ANeuralNetworksModel_addOperation\(model, (?P<op_type>\w+),'
+        r'|uint32_t modelInputIndexes\[\] = \{(?P<inputs>[^}]*)\};\s*'
+        r'uint32_t modelOutputIndexes\[\] = \{(?P<outputs>[^}]*)\};')
+    values = {}
+    for match in statement.finditer(source):
+        if match['type_decl']:
+            types[match['type_decl']] = {'dims': []}
+        elif match['type_field']:
+            types[match['type_field']][match['field']] = match['field_value']
+        elif match['dims_name']:
+            types[match['dims_name']]['dims'] = parse_int_list(match['dims'])
+        elif match['add_type']:
+            operand_type = types[match['add_type']]
+            operand_indexes[match['operand_name']] = graph.add_operand(
+                OPERAND_TYPES[operand_type['type']], operand_type['dims'],
+                float(operand_type.get('scale', 0)), int(operand_type.get('zeroPoint', 0)))
+        elif match['memory_operand']:
+            graph.set_operand_value_from_model_data(operand_indexes[match['memory_operand']],
+                                                    int(match['offset']), int(match['length']))
+        elif match['value_name']:
+            graph.set_operand_value(operand_indexes[match['value_name']],
+                                    parse_int_list(match['value']))
+        elif match['op_type']:
+            graph.add_operation(OPERATION_TYPES[match['op_type']],
+                                parse_int_list(match['op_inputs']),
+                                parse_int_list(match['op_outputs']))
+        elif match['inputs'] is not None:
+            graph.identify_inputs_and_outputs(parse_int_list(match['inputs']),
+                                              parse_int_list(match['outputs']))
+    return graph
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--from-generated-cpp', required=True, metavar='SOURCE',
+                        help='the generated C++ source to convert')
+    parser.add_argument('output', help='the binary model graph to write')
+    args = parser.parse_args()
+
+    with open(args.from_generated_cpp) as f:
+        graph = from_generated_cpp(f.read())
+    with open(args.output, 'wb') as f:
+        f.write(graph.serialize())
+    print('Wrote %d operands and %d operations to %s' %
+          (len(graph.operands), len(graph.operations), args.output))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,284 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2021 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""Writes the TENSOR_QUANT8_ASYMM variant of the float PoseNet model graph and data.
+
+The float model is run on sample frames to calibrate the range of every activation tensor. The
+activations are quantized with the scale and zero point covering their observed range, the filters
+with the range of their weights, and the biases to TENSOR_INT32 with the product of the input and
+filter scales, as NNAPI requires. The model input uses the fixed quantization written by the
+renderer shader (see QUANT8_OUTPUT in GlComputeRenderer.cpp): the colors in [-1.0, 1.0] with a
+scale of 1/128 and a zero point of 128.
+
+The frames are binary PPM (P6) images of the camera scene, resized to the model input like the
+renderer does. A few dozen frames covering the expected lighting and poses are enough:
+
+    quantize_model.py --graph model_graph.bin --data model_data.bin \\
+        --output-graph model_graph_quant8.bin --output-data model_data_quant8.bin frames/*.ppm
+
+Only the CONV_2D and DEPTHWISE_CONV_2D operations of PoseNet are supported. Requires numpy.
+"""
+
+import argparse
+
+import numpy as np
+
+from model_graph import OPERAND_TYPES, OPERATION_TYPES, Graph
+
+TENSOR_FLOAT32 = OPERAND_TYPES['ANEURALNETWORKS_TENSOR_FLOAT32']
+TENSOR_INT32 = OPERAND_TYPES['ANEURALNETWORKS_TENSOR_INT32']
+TENSOR_QUANT8_ASYMM = OPERAND_TYPES['ANEURALNETWORKS_TENSOR_QUANT8_ASYMM']
+CONV_2D = OPERATION_TYPES['ANEURALNETWORKS_CONV_2D']
+DEPTHWISE_CONV_2D = OPERATION_TYPES['ANEURALNETWORKS_DEPTHWISE_CONV_2D']
+
+PADDING_SAME = 1
+FUSED_RELU, FUSED_RELU1, FUSED_RELU6 = 1, 2, 3
+
+# The quantization of the model input, matching the renderer shader
+INPUT_SCALE = 1.0 / 128.0
+INPUT_ZERO_POINT = 128
+
+
+def read_ppm(path):
+    """Reads a binary PPM image as an HxWx3 uint8 array."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    tokens = []
+    offset = 0
+    while len(tokens) < 4:
+        while data[offset:offset + 1].isspace():
+            offset += 1
+        if data[offset:offset + 1] == b'#':
+            offset = data.index(b'\n', offset)
+            continue
+        end = offset
+        while not data[end:end + 1].isspace():
+            end += 1
+        tokens.append(data[offset:end])
+        offset = end
+    if tokens[0] != b'P6' or tokens[3] != b'255':
+        raise ValueError('%s: only 8-bit binary PPM images are supported' % path)
+    width, height = int(tokens[1]), int(tokens[2])
+    pixels = np.frombuffer(data, np.uint8, width * height * 3, offset + 1)
+    return pixels.reshape(height, width, 3)
+
+
+def frame_to_input(image, size):
+    """Resizes the image to the model input with nearest sampling, normalized to [-1.0, 1.0]."""
+    height, width, _ = image.shape
+    rows = np.arange(size) * (height - 1) // (size - 1)
+    columns = np.arange(size) * (width - 1) // (size - 1)
+    pixels = image[rows][:, columns].astype(np.float32)
+    return (pixels / 255.0 * 2.0 - 1.0)[np.newaxis]
+
+
+class Model:
+    """The float model, with the constant operands read from the model data."""
+
+    def __init__(self, graph, model_data):
+        self.graph = graph
+        self.model_data = model_data
+
+    def constant(self, index):
+        operand = self.graph.operands[index]
+        dtype = np.int32 if operand.type_code in (1, 2, TENSOR_INT32) else np.float32
+        if operand.value is not None:
+            value = np.frombuffer(operand.value, dtype)
+        elif operand.model_data_region is not None:
+            offset, length = operand.model_data_region
+            value = np.frombuffer(self.model_data, dtype, length // 4, offset)
+        else:
+            raise ValueError('operand %d is not a constant' % index)
+        return value.reshape(operand.dimensions) if operand.dimensions else int(value[0])
+
+    def parameters(self, type_code, inputs):
+        """Returns the padding scheme, the strides and the activation of a convolution."""
+        if len(inputs) != (8 if type_code == DEPTHWISE_CONV_2D else 7):
+            raise ValueError('only the implicit padding signature in NHWC is supported')
+        # The depth multiplier of DEPTHWISE_CONV_2D follows from the filter shape
+        padding, stride_w, stride_h = (self.constant(index) for index in inputs[3:6])
+        return padding, stride_w, stride_h, self.constant(inputs[-1])
+
+    def run(self, model_input, observe=None, quantization=None):
+        """Runs the model on an NHWC input and returns the values of all operands by index.
+
+        observe(index, value) is invoked with the output of every operation. With quantization,
+        a map from the operand index to (scale, zero point), every activation and filter is rounded
+        to its quantized value to simulate the quantized model.
+        """
+        def fake_quantize(index, value):
+            if quantization is None:
+                return value
+            return dequantize(quantize(value, *quantization[index]), *quantization[index])
+
+        values = {self.graph.inputs[0]: fake_quantize(self.graph.inputs[0], model_input)}
+        for type_code, inputs, outputs in self.graph.operations:
+            if type_code not in (CONV_2D, DEPTHWISE_CONV_2D):
+                raise ValueError('operation %d is not supported' % type_code)
+            padding, stride_w, stride_h, activation = self.parameters(type_code, inputs)
+            image = values[inputs[0]]
+            weights = fake_quantize(inputs[1], self.constant(inputs[1]))
+            bias = self.constant(inputs[2])
+            output = convolution(image, weights, bias, padding == PADDING_SAME, stride_h,
+                                 stride_w, type_code == DEPTHWISE_CONV_2D)
+            if activation == FUSED_RELU:
+                output = np.maximum(output, 0.0)
+            elif activation == FUSED_RELU1:
+                output = np.clip(output, -1.0, 1.0)
+            elif activation == FUSED_RELU6:
+                output = np.clip(output, 0.0, 6.0)
+            if observe is not None:
+                observe(outputs[0], output)
+            values[outputs[0]] = fake_quantize(outputs[0], output)
+        return values
+
+
+def convolution(image, weights, bias, same_padding, stride_h, stride_w, depthwise):
+    """CONV_2D and DEPTHWISE_CONV_2D in NHWC, with the NNAPI filter layouts."""
+    _, height, width, depth = image.shape
+    filter_height, filter_width = weights.shape[1:3]
+    if same_padding:
+        output_height = (height + stride_h - 1) // stride_h
+        output_width = (width + stride_w - 1) // stride_w
+        pad_h = max((output_height - 1) * stride_h + filter_height - height, 0)
+        pad_w = max((output_width - 1) * stride_w + filter_width - width, 0)
+        image = np.pad(image, ((0, 0), (pad_h // 2, pad_h - pad_h // 2),
+                               (pad_w // 2, pad_w - pad_w // 2), (0, 0)))
+    else:
+        output_height = (height - filter_height) // stride_h + 1
+        output_width = (width - filter_width) // stride_w + 1
+    patches = np.lib.stride_tricks.sliding_window_view(image, (filter_height, filter_width),
+                                                       axis=(1, 2))
+    patches = patches[:, ::stride_h, ::stride_w][:, :output_height, :output_width]
+    # patches: [batch, output height, output width, depth, filter height, filter width]
+    if depthwise:
+        multiplier = weights.shape[3] // depth
+        filters = weights[0].reshape(filter_height, filter_width, depth, multiplier)
+        output = np.einsum('nhwdyx,yxdm->nhwdm', patches, filters)
+        output = output.reshape(output.shape[:3] + (depth * multiplier,))
+    else:
+        output = np.einsum('nhwdyx,oyxd->nhwo', patches, weights)
+    return (output + bias).astype(np.float32)
+
+
+def choose_quantization(minimum, maximum):
+    """The asymmetric uint8 quantization covering [minimum, maximum], which must include 0."""
+    minimum, maximum = min(minimum, 0.0), max(maximum, 0.0)
+    scale = (maximum - minimum) / 255.0 if maximum > minimum else 1.0
+    zero_point = int(np.clip(round(-minimum / scale), 0, 255))
+    return float(np.float32(scale)), zero_point
+
+
+def quantize(value, scale, zero_point):
+    return np.clip(np.round(value / scale) + zero_point, 0, 255).astype(np.uint8)
+
+
+def dequantize(value, scale, zero_point):
+    return (value.astype(np.float32) - zero_point) * scale
+
+
+def calibrate(model, frames, size):
+    """Returns the observed (minimum, maximum) of every operation output."""
+    ranges = {}
+
+    def observe(index, value):
+        low, high = ranges.get(index, (np.inf, -np.inf))
+        ranges[index] = (min(low, float(value.min())), max(high, float(value.max())))
+
+    for path in frames:
+        model.run(frame_to_input(read_ppm(path), size), observe)
+    return ranges
+
+
+def quantize_graph(model, ranges):
+    """Returns the quantized graph and model data, and the quantization of the operands."""
+    graph = model.graph
+    quantization = {graph.inputs[0]: (INPUT_SCALE, INPUT_ZERO_POINT)}
+    for index, (minimum, maximum) in ranges.items():
+        quantization[index] = choose_quantization(minimum, maximum)
+
+    # The filters are quantized with the range of their weights, the biases with the product of
+    # the input and filter scales
+    constants = {}
+    for _, inputs, _ in graph.operations:
+        weights = model.constant(inputs[1])
+        filter_scale, filter_zero_point = choose_quantization(float(weights.min()),
+                                                              float(weights.max()))
+        bias_scale = float(np.float32(quantization[inputs[0]][0] * filter_scale))
+        bias = np.round(model.constant(inputs[2]) / bias_scale).astype(np.int32)
+        quantization[inputs[1]] = (filter_scale, filter_zero_point)
+        constants[inputs[1]] = (TENSOR_QUANT8_ASYMM, filter_scale, filter_zero_point,
+                                quantize(weights, filter_scale, filter_zero_point))
+        constants[inputs[2]] = (TENSOR_INT32, bias_scale, 0, bias)
+
+    # The operands keep their indexes, the scalar parameters are copied as they are
+    quantized = Graph()
+    model_data = bytearray()
+    for index, operand in enumerate(graph.operands):
+        if index in constants:
+            type_code, scale, zero_point, value = constants[index]
+            quantized.add_operand(type_code, operand.dimensions, scale, zero_point)
+            quantized.set_operand_value_from_model_data(index, len(model_data), value.nbytes)
+            model_data += value.tobytes() + b'\0' * (-value.nbytes % 4)
+        elif operand.type_code == TENSOR_FLOAT32:
+            quantized.add_operand(TENSOR_QUANT8_ASYMM, operand.dimensions, *quantization[index])
+        else:
+            quantized.add_operand(operand.type_code, operand.dimensions)
+            if operand.value is not None:
+                quantized.set_operand_value(index, operand.value)
+    for type_code, inputs, outputs in graph.operations:
+        quantized.add_operation(type_code, inputs, outputs)
+    quantized.identify_inputs_and_outputs(graph.inputs, graph.outputs)
+    return quantized, bytes(model_data), quantization
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--graph', required=True, help='the float model graph')
+    parser.add_argument('--data', required=True, help='the float model data')
+    parser.add_argument('--output-graph', required=True, help='the quantized model graph to write')
+    parser.add_argument('--output-data', required=True, help='the quantized model data to write')
+    parser.add_argument('frames', nargs='+', help='the PPM calibration frames')
+    args = parser.parse_args()
+
+    with open(args.graph, 'rb') as f:
+        graph = Graph.deserialize(f.read())
+    with open(args.data, 'rb') as f:
+        model = Model(graph, f.read())
+    size = graph.operands[graph.inputs[0]].dimensions[1]
+
+    ranges = calibrate(model, args.frames, size)
+    quantized, model_data, quantization = quantize_graph(model, ranges)
+    with open(args.output_graph, 'wb') as f:
+        f.write(quantized.serialize())
+    with open(args.output_data, 'wb') as f:
+        f.write(model_data)
+    print('Wrote %d operations to %s and %d bytes to %s' %
+          (len(quantized.operations), args.output_graph, len(model_data), args.output_data))
+
+    # Compare the outputs of the simulated quantized model with the float model
+    for path in args.frames:
+        model_input = frame_to_input(read_ppm(path), size)
+        expected = model.run(model_input)
+        actual = model.run(model_input, quantization=quantization)
+        errors = ['%.4f' % np.abs(actual[index] - expected[index]).max()
+                  for index in graph.outputs]
+        print('%s: max output errors %s' % (path, ', '.join(errors)))
+
+
+if __name__ == '__main__':
+    main()
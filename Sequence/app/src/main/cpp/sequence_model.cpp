@@ -18,6 +18,7 @@
 
 #include <android/log.h>
 #include <android/sharedmem.h>
+#include <android/trace.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -26,6 +27,16 @@
 #include <utility>
 #include <vector>
 
+/**
+ * Marks the enclosing scope as a section of the system trace, which Perfetto and systrace record
+ * with the "app" category.
+ */
+class ScopedTrace {
+   public:
+    explicit ScopedTrace(const char* sectionName) { ATrace_beginSection(sectionName); }
+    ~ScopedTrace() { ATrace_endSection(); }
+};
+
 /**
  * A helper method to allocate an ASharedMemory region and create an
  * ANeuralNetworksMemory object.
@@ -496,6 +507,8 @@ static bool DispatchSingleStep(ANeuralNetworksCompilation* compilation,
                                ANeuralNetworksMemory* sumOut, uint32_t sumOutLength,
                                ANeuralNetworksMemory* stateOut, uint32_t stateOutLength,
                                const ANeuralNetworksEvent* waitFor, ANeuralNetworksEvent** event) {
+    ScopedTrace trace("DispatchSingleStep");
+
     // Create an ANeuralNetworksExecution object from the compiled model.
     ANeuralNetworksExecution* execution;
     int32_t status = ANeuralNetworksExecution_create(compilation, &execution);
@@ -573,6 +586,7 @@ static bool DispatchSingleStep(ANeuralNetworksCompilation* compilation,
  * @return  computed result, or 0.0f if there is error.
  */
 bool SimpleSequenceModel::Compute(float initialValue, uint32_t steps, float* result) {
+    ScopedTrace trace("SimpleSequenceModel::Compute");
     if (!result) {
         return false;
     }
@@ -640,7 +654,9 @@ bool SimpleSequenceModel::Compute(float initialValue, uint32_t steps, float* res
     }
 
     // Since the events are chained, we only need to wait for the last one.
+    ATrace_beginSection("ANeuralNetworksEvent_wait");
     ANeuralNetworksEvent_wait(events.back());
+    ATrace_endSection();
 
     // Get the results.
     float* outputTensorPtr = reinterpret_cast<float*>(
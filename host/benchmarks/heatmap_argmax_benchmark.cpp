@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Micro-benchmark of the keypoint argmax of the pose estimation postprocessing.
+//
+// Compares the previous per-keypoint strided scan with the single-pass scalar and SIMD
+// implementations of computeHeatmapArgmax, on the 9x9 heatmap of the current model and on the
+// larger heatmaps of higher-resolution models. Usage: heatmap_argmax_benchmark [iterations]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "HeatmapArgmax.h"
+#include "Utils.h"
+
+using namespace pose_estimation;
+
+namespace {
+
+// The argmax as computed by PoseEstimator before the single-pass kernel
+void computeHeatmapArgmaxStrided(const float* heatmap, uint32_t numberOfCells,
+                                 uint32_t numberOfChannels, float* maxValues,
+                                 uint32_t* maxCellIndexes) {
+    for (uint32_t c = 0; c < numberOfChannels; c++) {
+        float maxValue = heatmap[c];
+        uint32_t maxIndex = 0;
+        for (uint32_t i = 0; i < numberOfCells; i++) {
+            const float value = heatmap[i * numberOfChannels + c];
+            if (value > maxValue) {
+                maxValue = value;
+                maxIndex = i;
+            }
+        }
+        maxValues[c] = maxValue;
+        maxCellIndexes[c] = maxIndex;
+    }
+}
+
+using ArgmaxFunction = void (*)(const float*, uint32_t, uint32_t, float*, uint32_t*);
+
+// Returns the average time in nanoseconds of one call
+double benchmark(ArgmaxFunction function, const std::vector<float>& heatmap,
+                 uint32_t numberOfCells, uint32_t iterations, std::vector<uint32_t>* indexes) {
+    std::vector<float> values(kNumberOfKeypoints);
+    indexes->resize(kNumberOfKeypoints);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        function(heatmap.data(), numberOfCells, kNumberOfKeypoints, values.data(),
+                 indexes->data());
+        // Keep the compiler from hoisting the call out of the loop
+        asm volatile("" : : "r"(values.data()), "r"(indexes->data()) : "memory");
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+    std::mt19937 generator(42);
+    std::normal_distribution<float> distribution(-4.0f, 2.0f);
+
+    printf("%-10s %14s %14s %14s\n", "heatmap", "strided (ns)", "scalar (ns)", "simd (ns)");
+    bool matches = true;
+    for (uint32_t size : {9u, 17u, 33u}) {
+        const uint32_t numberOfCells = size * size;
+        std::vector<float> heatmap(numberOfCells * kNumberOfKeypoints);
+        for (auto& value : heatmap) value = distribution(generator);
+
+        std::vector<uint32_t> expected, scalar, simd;
+        const double stridedNs = benchmark(computeHeatmapArgmaxStrided, heatmap, numberOfCells,
+                                           iterations, &expected);
+        const double scalarNs = benchmark(computeHeatmapArgmaxScalar, heatmap, numberOfCells,
+                                          iterations, &scalar);
+        const double simdNs =
+                benchmark(computeHeatmapArgmax, heatmap, numberOfCells, iterations, &simd);
+        matches = matches && scalar == expected && simd == expected;
+        printf("%2ux%-7u %14.1f %14.1f %14.1f\n", size, size, stridedNs, scalarNs, simdNs);
+    }
+    if (!matches) {
+        fprintf(stderr, "The single-pass argmax does not match the strided argmax\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
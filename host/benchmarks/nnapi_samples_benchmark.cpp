@@ -0,0 +1,493 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Runs the native code of the samples on the host NNAPI of host/ndk, checks the results and
+// reports the average latencies:
+// - SimpleModel of the Basic sample;
+// - SimpleSequenceModel of the Sequence sample;
+// - NnapiExecutor of the pose estimation sample, with one and two frames in flight;
+// - CpuRenderer of the pose estimation sample, on a 640x480 camera frame;
+// - packPoseEstimationResult of the pose estimation sample, which fills the result buffer read by
+//   the app through JNI;
+// - LatencyHistogram of the pose estimation sample, which keeps the latency percentiles of every
+//   stage;
+// - FrameScheduler of the pose estimation sample, on a simulated 30 FPS camera;
+// - TRACE_SCOPE of the pose estimation sample, if built with POSE_ESTIMATION_TRACING.
+// The pose estimation model data is not part of the repository. Unless the assets directory of
+// the sample holds it, the model is run with random weights, which is as fast as with the real
+// ones. Usage: nnapi_samples_benchmark [iterations] [trace.json]
+// With a trace path, the stages recorded by the pose estimation sample are written there as Chrome
+// trace JSON.
+
+#include <host_ndk.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Every sample defines its own LOG_TAG
+#include "sequence_model.h"
+#undef LOG_TAG
+#include "simple_model.h"
+#undef LOG_TAG
+
+#include "FrameScheduler.h"
+#include "LatencyHistogram.h"
+#include "PoseEstimationConfig.h"
+#include "PoseEstimator.h"
+#include "Trace.h"
+#include "Utils.h"
+#include "ml/NnapiExecutor.h"
+#include "ml/NnapiModelGraph.h"
+#include "renderer/CpuRenderer.h"
+
+using namespace pose_estimation;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+bool fileExists(const std::string& path) { return access(path.c_str(), R_OK) == 0; }
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+// The size of the model data referred to by a model graph, see ml/NnapiModelGraph.h for the
+// format. The graph is assumed to be well-formed, populateModelFromGraph checks it anyway.
+size_t getModelDataSize(const std::vector<uint8_t>& graph) {
+    size_t offset = 0;
+    auto read = [&graph, &offset] {
+        uint32_t value;
+        std::memcpy(&value, graph.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return value;
+    };
+    read();  // magic
+    read();  // version
+    const uint32_t operandCount = read();
+    read();  // operationCount
+    read();  // inputCount
+    read();  // outputCount
+    size_t size = 0;
+    for (uint32_t i = 0; i < operandCount; i++) {
+        read();  // type
+        const uint32_t dimensionCount = read();
+        offset += (dimensionCount + 2) * sizeof(uint32_t);  // dimensions, scale, zeroPoint
+        const uint32_t valueSource = read();
+        if (valueSource == ModelGraphFormat::kValueInline) {
+            offset += (read() + 3) & ~3u;
+        } else if (valueSource == ModelGraphFormat::kValueModelData) {
+            const uint32_t dataOffset = read();
+            size = std::max<size_t>(size, dataOffset + read());
+        }
+    }
+    return size;
+}
+
+// A temporary copy of the pose estimation assets with random model data
+class SyntheticPoseAssets {
+   public:
+    explicit SyntheticPoseAssets(const std::string& assetsDirectory) {
+        char directory[] = "/tmp/nnapi_samples_benchmark.XXXXXX";
+        CHECK(mkdtemp(directory) != nullptr);
+        mDirectory = directory;
+
+        const auto graph = readFile(assetsDirectory + "/model_graph.bin");
+        CHECK(!graph.empty());
+        std::ofstream(mDirectory + "/model_graph.bin", std::ios::binary)
+                .write(reinterpret_cast<const char*>(graph.data()), graph.size());
+
+        std::vector<float> weights((getModelDataSize(graph) + 3) / sizeof(float));
+        std::mt19937 generator(42);
+        std::normal_distribution<float> distribution(0.0f, 0.1f);
+        for (auto& weight : weights) weight = distribution(generator);
+        std::ofstream(mDirectory + "/model_data.bin", std::ios::binary)
+                .write(reinterpret_cast<const char*>(weights.data()),
+                       weights.size() * sizeof(float));
+    }
+    ~SyntheticPoseAssets() {
+        unlink((mDirectory + "/model_graph.bin").c_str());
+        unlink((mDirectory + "/model_data.bin").c_str());
+        rmdir(mDirectory.c_str());
+    }
+
+    const std::string& directory() const { return mDirectory; }
+
+   private:
+    std::string mDirectory;
+};
+
+bool runSimpleModel(uint32_t iterations) {
+    AAssetManager* assetManager = HostNdk_createAssetManager(BASIC_ASSETS_DIR);
+    CHECK(assetManager != nullptr);
+    AAsset* asset = AAssetManager_open(assetManager, "model_data.bin", AASSET_MODE_BUFFER);
+    CHECK(asset != nullptr);
+    auto model = std::make_unique<SimpleModel>(asset);
+    AAsset_close(asset);
+    HostNdk_destroyAssetManager(assetManager);
+    if (!model->CreateCompiledModel()) {
+        fprintf(stderr, "SimpleModel: failed to prepare the model\n");
+        return false;
+    }
+
+    // The model computes (0.5 + input1) * (0.5 + input2), the weights are all 0.5
+    const auto start = Clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        const float input1 = i % 7, input2 = i % 5;
+        float result = 0.0f;
+        if (!model->Compute(input1, input2, &result) ||
+            std::fabs(result - (input1 + 0.5f) * (input2 + 0.5f)) > FLOAT_EPISILON) {
+            fprintf(stderr, "SimpleModel: wrong result %f for %f and %f\n", result, input1,
+                    input2);
+            return false;
+        }
+    }
+    printf("%-40s %12.1f us\n", "SimpleModel::Compute", elapsedUs(start) / iterations);
+    return true;
+}
+
+bool runSimpleSequenceModel(uint32_t iterations) {
+    constexpr float kRatio = 0.5f, kInitialValue = 2.0f;
+    constexpr uint32_t kSteps = 8;
+    auto model = SimpleSequenceModel::Create(kRatio);
+    if (model == nullptr) {
+        fprintf(stderr, "SimpleSequenceModel: failed to create the model\n");
+        return false;
+    }
+
+    // The model sums the geometric progression initialValue * ratio^i over the steps
+    const float expected =
+            kInitialValue * (1.0f - std::pow(kRatio, kSteps)) / (1.0f - kRatio);
+    const auto start = Clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        float result = 0.0f;
+        if (!model->Compute(kInitialValue, kSteps, &result) ||
+            std::fabs(result - expected) > 1e-5f * expected) {
+            fprintf(stderr, "SimpleSequenceModel: wrong result %f, expected %f\n", result,
+                    expected);
+            return false;
+        }
+    }
+    printf("%-40s %12.1f us\n", "SimpleSequenceModel::Compute (8 steps)",
+           elapsedUs(start) / iterations);
+    return true;
+}
+
+bool runNnapiExecutor(AAssetManager* assetManager, uint32_t pipelineDepth, bool float16Input,
+                      uint32_t iterations) {
+    // The default compilation settings keep the runs comparable across builds
+    const PoseEstimationConfig config = {
+            .pipelineDepth = pipelineDepth,
+            .autoTuneCompilation = false,
+            .float16RendererOutput = float16Input,
+    };
+    NnapiExecutor executor(config, assetManager);
+
+    // The inputs are filled once with a random image in [-1, 1], as rendered by the GPU in fp32 or
+    // fp16
+    std::vector<std::unique_ptr<ManagedBlobAhwb>> inputs(pipelineDepth);
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    for (uint32_t slot = 0; slot < pipelineDepth; slot++) {
+        inputs[slot] = std::make_unique<ManagedBlobAhwb>(
+                executor.getRequiredInputMemorySize(),
+                AHARDWAREBUFFER_USAGE_GPU_DATA_BUFFER | AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN);
+        for (uint32_t i = 0; i < kRendererOutputSizeBytes / sizeof(float); i++) {
+            const float value = distribution(generator);
+            if (float16Input) {
+                static_cast<uint16_t*>(inputs[slot]->data())[i] = floatToFloat16(value);
+            } else {
+                static_cast<float*>(inputs[slot]->data())[i] = value;
+            }
+        }
+        executor.setInputFromHardwareBuffer(slot, inputs[slot]->handle());
+    }
+
+    // Keep pipelineDepth frames in flight, as PoseEstimator does
+    float inDriverMs = 0.0f;
+    const auto start = Clock::now();
+    for (uint32_t i = 0; i < iterations + pipelineDepth - 1; i++) {
+        if (i < iterations) {
+            executor.start(i % pipelineDepth, UniqueFd());
+        }
+        if (i + 1 >= pipelineDepth) {
+            const uint32_t slot = (i + 1 - pipelineDepth) % pipelineDepth;
+            executor.wait(slot);
+            inDriverMs += executor.getTiming(slot).inDriverMs;
+            const float* heatmap = executor.getOutputHeatmapAddress(slot);
+            for (uint32_t k = 0; k < kOutputHeatmapSize; k++) {
+                if (!std::isfinite(heatmap[k])) {
+                    fprintf(stderr, "NnapiExecutor: the heatmap is not finite\n");
+                    return false;
+                }
+            }
+        }
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "NnapiExecutor (%s input, %u in flight)",
+             float16Input ? "fp16" : "fp32", pipelineDepth);
+    printf("%-40s %12.1f us\n", name, elapsedUs(start) / iterations);
+    // NaN if the executor does not measure the timing
+    printf("%-40s %12.1f us\n", "  in driver, per execution", inDriverMs * 1000.0f / iterations);
+    return true;
+}
+
+bool runCpuRenderer(uint32_t iterations) {
+    // A YUV camera frame with a gradient in every plane
+    const AHardwareBuffer_Desc cameraDesc = {
+            .width = 640,
+            .height = 480,
+            .layers = 1,
+            .format = AHARDWAREBUFFER_FORMAT_Y8Cb8Cr8_420,
+            .usage = AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN | AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN,
+    };
+    AHardwareBuffer* camera = nullptr;
+    CHECK(AHardwareBuffer_allocate(&cameraDesc, &camera) == 0);
+    AHardwareBuffer_Planes planes;
+    CHECK(AHardwareBuffer_lockPlanes(camera, AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN, -1, nullptr,
+                                     &planes) == 0);
+    for (uint32_t p = 0; p < planes.planeCount; p++) {
+        const AHardwareBuffer_Plane& plane = planes.planes[p];
+        const uint32_t subsampling = p == 0 ? 1 : 2;
+        for (uint32_t y = 0; y < cameraDesc.height / subsampling; y++) {
+            auto* row = static_cast<uint8_t*>(plane.data) + y * plane.rowStride;
+            for (uint32_t x = 0; x < cameraDesc.width / subsampling; x++) {
+                row[x * plane.pixelStride] = (x + y + p * 85) & 0xff;
+            }
+        }
+    }
+    CHECK(AHardwareBuffer_unlock(camera, nullptr) == 0);
+
+    // Rotated by 90 degrees, as the texture transform of a portrait display
+    const float textureTransform[16] = {0, 1, 0, 0, -1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 1};
+    CpuRenderer renderer(PoseEstimationConfig(), textureTransform);
+    ManagedBlobAhwb output(kRendererOutputSizeBytes, AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN |
+                                                             AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN);
+    renderer.setOutputFromHardwareBuffer(0, output.handle());
+
+    const auto start = Clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        renderer.run(camera, 0, /*preferSyncFence=*/false);
+    }
+    const double us = elapsedUs(start) / iterations;
+    AHardwareBuffer_release(camera);
+
+    const float* values = static_cast<const float*>(output.data());
+    for (uint32_t i = 0; i < kRendererOutputSizeBytes / sizeof(float); i++) {
+        if (!(values[i] >= -1.0f && values[i] <= 1.0f)) {
+            fprintf(stderr, "CpuRenderer: the output is not in [-1, 1]\n");
+            return false;
+        }
+    }
+    printf("%-40s %12.1f us\n", "CpuRenderer (640x480 YUV, fp32 output)", us);
+    return true;
+}
+
+bool runResultPacking(uint32_t numberOfPoses, uint32_t iterations) {
+    PoseEstimationResult result = {.renderLatencyMs = 1.0f, .mlLatencyMs = 2.0f};
+    for (uint32_t i = 0; i < numberOfPoses; i++) {
+        Pose pose = {.keypoints = std::vector<Keypoint>(kNumberOfKeypoints), .score = 0.5f};
+        for (uint32_t k = 0; k < kNumberOfKeypoints; k++) {
+            pose.keypoints[k] = {.x = 0.1f * i, .y = 0.01f * k, .score = 0.5f};
+        }
+        result.poses.push_back(std::move(pose));
+    }
+    std::vector<float> buffer(PackedResultLayout::size(numberOfPoses));
+
+    const auto start = Clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        packPoseEstimationResult(result, buffer.data(), buffer.size());
+    }
+    const double us = elapsedUs(start) / iterations;
+
+    const float* lastKeypoint = &buffer.back() - 2;
+    if (buffer[PackedResultLayout::kNumberOfPoses] != numberOfPoses ||
+        buffer[PackedResultLayout::kMlLatencyMs] != 2.0f ||
+        (numberOfPoses > 0 && lastKeypoint[1] != 0.01f * (kNumberOfKeypoints - 1))) {
+        fprintf(stderr, "packPoseEstimationResult: unexpected layout\n");
+        return false;
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "packPoseEstimationResult (%u poses)", numberOfPoses);
+    printf("%-40s %12.3f us\n", name, us);
+    return true;
+}
+
+bool runLatencyHistogram(uint32_t iterations) {
+    // Latencies uniformly spread over [0, 100) ms, more than a window apart
+    LatencyHistogram histogram;
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> latencyMs(0.0f, 100.0f);
+    std::vector<float> latencies(iterations);
+    std::generate(latencies.begin(), latencies.end(), [&] { return latencyMs(generator); });
+
+    const auto start = Clock::now();
+    for (float latency : latencies) {
+        histogram.record(latency);
+    }
+    const double ns = elapsedUs(start) * 1000.0 / iterations;
+    const LatencyPercentiles percentiles = histogram.getPercentiles();
+
+    // Compare with the exact percentiles of the latencies in the window, within the 1/32 bucket
+    // width and the rounding to microseconds
+    const uint32_t windowSize = std::min(iterations, LatencyHistogram::kWindowSize);
+    std::vector<float> window(latencies.end() - windowSize, latencies.end());
+    std::sort(window.begin(), window.end());
+    const auto exact = [&window](float p) {
+        return window[static_cast<size_t>(std::ceil(p * window.size())) - 1];
+    };
+    const auto matches = [](float percentileMs, float exactMs) {
+        return std::abs(percentileMs - exactMs) <= exactMs / 32.0f + 0.001f;
+    };
+    if (percentiles.numberOfFrames != windowSize || !matches(percentiles.p50Ms, exact(0.50f)) ||
+        !matches(percentiles.p90Ms, exact(0.90f)) || !matches(percentiles.p99Ms, exact(0.99f)) ||
+        !matches(percentiles.maxMs, window.back())) {
+        fprintf(stderr, "LatencyHistogram: unexpected percentiles\n");
+        return false;
+    }
+    printf("%-40s %12.1f ns\n", "LatencyHistogram::record", ns);
+    return true;
+}
+
+// Returns the number of frames of a 30 FPS camera the scheduler submits over numberOfFrames, with
+// every submitted frame taking latencyMs and the frames waiting waitedMs before being scheduled
+uint32_t countSubmittedFrames(const PoseEstimationConfig& config, uint32_t numberOfFrames,
+                              float latencyMs, float waitedMs) {
+    constexpr int64_t kCameraFrameIntervalNs = 1'000'000'000 / 30;
+    FrameScheduler scheduler(config);
+    uint32_t submittedFrames = 0;
+    for (uint32_t i = 0; i < numberOfFrames; i++) {
+        const int64_t timestampNs = i * kCameraFrameIntervalNs;
+        // The first frame is scheduled right away, which sets the smallest capture delay
+        const int64_t nowNs = timestampNs + (i == 0 ? 0 : static_cast<int64_t>(waitedMs * 1e6f));
+        if (scheduler.shouldSubmit(timestampNs, nowNs)) {
+            scheduler.onFrameFinished(latencyMs);
+            submittedFrames++;
+        }
+    }
+    return submittedFrames;
+}
+
+bool runFrameScheduler(uint32_t iterations) {
+    const uint32_t numberOfFrames = 30 * 8;
+    PoseEstimationConfig config = {.frameDropPolicy = FrameDropPolicy::LATEST_FRAME_WINS};
+    const uint32_t latestFrameWins = countSubmittedFrames(config, numberOfFrames, 200.0f, 50.0f);
+    config = {.frameDropPolicy = FrameDropPolicy::TARGET_FPS, .targetFps = 15.0f};
+    const uint32_t targetFps = countSubmittedFrames(config, numberOfFrames, 20.0f, 0.0f);
+    // Fresh frames within the deadline, stale frames beyond it, and a pipeline slower than it
+    config = {.frameDropPolicy = FrameDropPolicy::DEADLINE, .frameDeadlineMs = 100.0f};
+    const uint32_t deadlineFresh = countSubmittedFrames(config, numberOfFrames, 20.0f, 0.0f);
+    const uint32_t deadlineStale = countSubmittedFrames(config, numberOfFrames, 20.0f, 90.0f);
+    const uint32_t deadlineSlow = countSubmittedFrames(config, numberOfFrames, 200.0f, 0.0f);
+    const uint32_t everyFewFrames =
+            (numberOfFrames - 1) / FrameScheduler::kMaxConsecutiveDroppedFrames + 1;
+    if (latestFrameWins != numberOfFrames || targetFps != numberOfFrames / 2 ||
+        deadlineFresh != numberOfFrames || deadlineStale != everyFewFrames ||
+        deadlineSlow != everyFewFrames) {
+        fprintf(stderr, "FrameScheduler: unexpected frames submitted %u %u %u %u %u\n",
+                latestFrameWins, targetFps, deadlineFresh, deadlineStale, deadlineSlow);
+        return false;
+    }
+
+    config = {.frameDropPolicy = FrameDropPolicy::DEADLINE, .frameDeadlineMs = 100.0f};
+    const auto start = Clock::now();
+    FrameScheduler scheduler(config);
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (scheduler.shouldSubmit(i * 33'000'000ll, i * 33'000'000ll + 1'000'000)) {
+            scheduler.onFrameFinished(20.0f);
+        }
+    }
+    const double ns = elapsedUs(start) * 1000.0 / iterations;
+    printf("%-40s %12.1f ns\n", "FrameScheduler::shouldSubmit (deadline)", ns);
+    return true;
+}
+
+bool runTracing(uint32_t iterations) {
+    if (!isTracingEnabled()) return true;
+
+    // On a thread of its own, so as not to overwrite the events of the pipeline in the ring buffer
+    // of the main thread
+    double ns = 0.0;
+    std::thread([iterations, &ns] {
+        // The first event of the thread allocates its ring buffer
+        { TRACE_SCOPE("runTracing warmup"); }
+        const auto start = Clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            TRACE_SCOPE("runTracing");
+        }
+        ns = elapsedUs(start) * 1000.0 / iterations;
+    }).join();
+
+    if (dumpChromeTrace().find("\"runTracing\"") == std::string::npos) {
+        fprintf(stderr, "TRACE_SCOPE: the event is missing from the trace\n");
+        return false;
+    }
+    printf("%-40s %12.1f ns\n", "TRACE_SCOPE, per event", ns);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    bool success = runSimpleModel(iterations * 100) && runSimpleSequenceModel(iterations * 10);
+
+    std::unique_ptr<SyntheticPoseAssets> syntheticAssets;
+    std::string poseAssetsDirectory = POSE_ESTIMATION_ASSETS_DIR;
+    if (!fileExists(poseAssetsDirectory + "/model_data.bin")) {
+        syntheticAssets = std::make_unique<SyntheticPoseAssets>(poseAssetsDirectory);
+        poseAssetsDirectory = syntheticAssets->directory();
+    }
+    AAssetManager* assetManager = HostNdk_createAssetManager(poseAssetsDirectory.c_str());
+    CHECK(assetManager != nullptr);
+    // The half-precision input halves the renderer output, at the cost of a CAST in the model
+    for (bool float16Input : {false, true}) {
+        success = success &&
+                  runNnapiExecutor(assetManager, /*pipelineDepth=*/1, float16Input, iterations) &&
+                  runNnapiExecutor(assetManager, /*pipelineDepth=*/2, float16Input, iterations);
+    }
+    HostNdk_destroyAssetManager(assetManager);
+    success = success && runCpuRenderer(iterations * 10);
+    success = success && runResultPacking(1, iterations * 1000) &&
+              runResultPacking(10, iterations * 1000);
+    success = success && runLatencyHistogram(iterations * 10000);
+    success = success && runFrameScheduler(iterations * 10000);
+    success = success && runTracing(iterations * 10000);
+    if (argc > 2) {
+        success = success && writeChromeTrace(argv[2]);
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// libandroid: shared memory, assets, the device API level and tracing
+
+#include <android/api-level.h>
+#include <android/asset_manager.h>
+#include <android/sharedmem.h>
+#include <android/trace.h>
+#include <fcntl.h>
+#include <host_ndk.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+struct AAssetManager {
+    std::string directory;
+};
+
+struct AAsset {
+    int fd = -1;
+    off64_t length = 0;
+    off64_t position = 0;
+    // Mapped on the first AAsset_getBuffer
+    void* buffer = nullptr;
+};
+
+// Shared memory
+
+int ASharedMemory_create(const char* name, size_t size) {
+    if (size == 0) return -1;
+    const int fd = memfd_create(name != nullptr ? name : "", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) return -1;
+    if (ftruncate(fd, size) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+size_t ASharedMemory_getSize(int fd) {
+    struct stat st;
+    return fstat(fd, &st) == 0 ? st.st_size : 0;
+}
+
+int ASharedMemory_setProt(int fd, int prot) {
+    // As with ashmem, the protection can only be reduced: forbid any later writable mapping
+    if ((prot & PROT_WRITE) == 0) {
+        return fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_FUTURE_WRITE) == 0
+                       ? 0
+                       : -1;
+    }
+    return 0;
+}
+
+// Assets
+
+AAssetManager* HostNdk_createAssetManager(const char* directory) {
+    struct stat st;
+    if (directory == nullptr || stat(directory, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        return nullptr;
+    }
+    return new AAssetManager{.directory = directory};
+}
+
+void HostNdk_destroyAssetManager(AAssetManager* assetManager) { delete assetManager; }
+
+AAsset* AAssetManager_open(AAssetManager* mgr, const char* filename, int /*mode*/) {
+    if (mgr == nullptr || filename == nullptr) return nullptr;
+    const std::string path = mgr->directory + "/" + filename;
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    return new AAsset{.fd = fd, .length = st.st_size};
+}
+
+int AAsset_read(AAsset* asset, void* buf, size_t count) {
+    const size_t remaining = asset->length - asset->position;
+    count = std::min(count, remaining);
+    size_t done = 0;
+    while (done < count) {
+        const ssize_t result =
+                pread(asset->fd, static_cast<char*>(buf) + done, count - done,
+                      asset->position + done);
+        if (result <= 0) return done > 0 ? static_cast<int>(done) : -1;
+        done += result;
+    }
+    asset->position += done;
+    return static_cast<int>(done);
+}
+
+void AAsset_close(AAsset* asset) {
+    if (asset == nullptr) return;
+    if (asset->buffer != nullptr) {
+        munmap(asset->buffer, asset->length);
+    }
+    close(asset->fd);
+    delete asset;
+}
+
+const void* AAsset_getBuffer(AAsset* asset) {
+    if (asset->buffer == nullptr && asset->length > 0) {
+        void* buffer = mmap(nullptr, asset->length, PROT_READ, MAP_PRIVATE, asset->fd, 0);
+        if (buffer == MAP_FAILED) return nullptr;
+        asset->buffer = buffer;
+    }
+    return asset->buffer;
+}
+
+off_t AAsset_getLength(AAsset* asset) { return asset->length; }
+
+off64_t AAsset_getLength64(AAsset* asset) { return asset->length; }
+
+// Assets are never compressed on the host, and every asset starts at offset 0 of its own file
+int AAsset_openFileDescriptor64(AAsset* asset, off64_t* outStart, off64_t* outLength) {
+    const int fd = fcntl(asset->fd, F_DUPFD_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    *outStart = 0;
+    *outLength = asset->length;
+    return fd;
+}
+
+int AAsset_openFileDescriptor(AAsset* asset, off_t* outStart, off_t* outLength) {
+    off64_t start = 0, length = 0;
+    const int fd = AAsset_openFileDescriptor64(asset, &start, &length);
+    *outStart = start;
+    *outLength = length;
+    return fd;
+}
+
+// API level
+
+int android_get_device_api_level() {
+    static const int apiLevel = [] {
+        const char* value = std::getenv("HOST_NDK_API_LEVEL");
+        return value != nullptr ? std::atoi(value) : 31;
+    }();
+    return apiLevel;
+}
+
+// Tracing
+
+bool ATrace_isEnabled() { return false; }
+
+void ATrace_beginSection(const char* /*sectionName*/) {}
+
+void ATrace_endSection() {}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// libnativewindow: AHardwareBuffers backed by memfd shared memory
+//
+// There is no GPU on the host, so a buffer is a plain CPU allocation that stays mapped for its
+// whole lifetime. Locking only hands out that mapping, and fences are never produced: the unlock
+// fence is always -1, and a lock fence is waited before returning.
+
+#include <android/hardware_buffer.h>
+#include <android/sharedmem.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+struct AHardwareBuffer {
+    AHardwareBuffer_Desc desc;
+    uint64_t id;
+    int fd;
+    size_t size;
+    void* data;
+    std::atomic<uint32_t> refCount;
+    std::atomic<uint32_t> lockCount;
+};
+
+namespace {
+
+// Returns 0 for the planar formats
+uint32_t bytesPerPixel(uint32_t format) {
+    switch (format) {
+        case AHARDWAREBUFFER_FORMAT_BLOB:
+            return 1;
+        case AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM:
+        case AHARDWAREBUFFER_FORMAT_R8G8B8X8_UNORM:
+            return 4;
+        case AHARDWAREBUFFER_FORMAT_R16G16B16A16_FLOAT:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// Returns 0 for the buffers that cannot be allocated
+size_t bufferSize(const AHardwareBuffer_Desc& desc) {
+    const size_t pixels = static_cast<size_t>(desc.width) * desc.height * desc.layers;
+    if (desc.format == AHARDWAREBUFFER_FORMAT_Y8Cb8Cr8_420) {
+        // The chroma planes are subsampled by 2 along both dimensions
+        if (desc.width % 2 != 0 || desc.height % 2 != 0 || desc.layers != 1) return 0;
+        return pixels + pixels / 2;
+    }
+    return pixels * bytesPerPixel(desc.format);
+}
+
+void waitFence(int32_t fence) {
+    if (fence < 0) return;
+    pollfd fd = {.fd = fence, .events = POLLIN};
+    while (poll(&fd, 1, -1) < 0 && errno == EINTR) {
+    }
+    close(fence);
+}
+
+}  // namespace
+
+int AHardwareBuffer_allocate(const AHardwareBuffer_Desc* desc, AHardwareBuffer** outBuffer) {
+    if (desc == nullptr || outBuffer == nullptr) return -EINVAL;
+    const size_t size = bufferSize(*desc);
+    if (size == 0) return -EINVAL;
+    if (desc->format == AHARDWAREBUFFER_FORMAT_BLOB && (desc->height != 1 || desc->layers != 1)) {
+        return -EINVAL;
+    }
+
+    const int fd = ASharedMemory_create("AHardwareBuffer", size);
+    if (fd < 0) return -ENOMEM;
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        return -ENOMEM;
+    }
+
+    static std::atomic<uint64_t> nextId = 1;
+    auto* buffer = new AHardwareBuffer{
+            .desc = *desc, .id = nextId++, .fd = fd, .size = size, .data = data};
+    buffer->desc.stride = desc->width;
+    buffer->refCount = 1;
+    buffer->lockCount = 0;
+    *outBuffer = buffer;
+    return 0;
+}
+
+void AHardwareBuffer_acquire(AHardwareBuffer* buffer) { buffer->refCount++; }
+
+void AHardwareBuffer_release(AHardwareBuffer* buffer) {
+    if (buffer == nullptr || --buffer->refCount > 0) return;
+    munmap(buffer->data, buffer->size);
+    close(buffer->fd);
+    delete buffer;
+}
+
+void AHardwareBuffer_describe(const AHardwareBuffer* buffer, AHardwareBuffer_Desc* outDesc) {
+    *outDesc = buffer->desc;
+}
+
+int AHardwareBuffer_lock(AHardwareBuffer* buffer, uint64_t usage, int32_t fence,
+                         const ARect* /*rect*/, void** outVirtualAddress) {
+    constexpr uint64_t kCpuUsageMask =
+            AHARDWAREBUFFER_USAGE_CPU_READ_MASK | AHARDWAREBUFFER_USAGE_CPU_WRITE_MASK;
+    if (buffer == nullptr || outVirtualAddress == nullptr || (usage & kCpuUsageMask) == 0 ||
+        (usage & ~kCpuUsageMask) != 0) {
+        return -EINVAL;
+    }
+    waitFence(fence);
+    buffer->lockCount++;
+    *outVirtualAddress = buffer->data;
+    return 0;
+}
+
+int AHardwareBuffer_lockPlanes(AHardwareBuffer* buffer, uint64_t usage, int32_t fence,
+                               const ARect* rect, AHardwareBuffer_Planes* outPlanes) {
+    if (outPlanes == nullptr) return -EINVAL;
+    void* data = nullptr;
+    const int result = AHardwareBuffer_lock(buffer, usage, fence, rect, &data);
+    if (result != 0) return result;
+
+    const AHardwareBuffer_Desc& desc = buffer->desc;
+    auto* bytes = static_cast<uint8_t*>(data);
+    if (desc.format == AHARDWAREBUFFER_FORMAT_Y8Cb8Cr8_420) {
+        const size_t lumaSize = static_cast<size_t>(desc.width) * desc.height;
+        outPlanes->planeCount = 3;
+        outPlanes->planes[0] = {.data = bytes, .pixelStride = 1, .rowStride = desc.width};
+        outPlanes->planes[1] = {
+                .data = bytes + lumaSize, .pixelStride = 1, .rowStride = desc.width / 2};
+        outPlanes->planes[2] = {
+                .data = bytes + lumaSize + lumaSize / 4, .pixelStride = 1,
+                .rowStride = desc.width / 2};
+    } else {
+        const uint32_t pixelSize = bytesPerPixel(desc.format);
+        outPlanes->planeCount = 1;
+        outPlanes->planes[0] = {
+                .data = bytes, .pixelStride = pixelSize, .rowStride = desc.stride * pixelSize};
+    }
+    return 0;
+}
+
+int AHardwareBuffer_unlock(AHardwareBuffer* buffer, int32_t* fence) {
+    if (buffer == nullptr) return -EINVAL;
+    uint32_t lockCount = buffer->lockCount;
+    do {
+        if (lockCount == 0) return -EINVAL;
+    } while (!buffer->lockCount.compare_exchange_weak(lockCount, lockCount - 1));
+    if (fence != nullptr) *fence = -1;
+    return 0;
+}
+
+int AHardwareBuffer_getId(const AHardwareBuffer* buffer, uint64_t* outId) {
+    if (buffer == nullptr || outId == nullptr) return -EINVAL;
+    *outId = buffer->id;
+    return 0;
+}
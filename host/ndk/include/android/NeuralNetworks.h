@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The subset of the NDK <android/NeuralNetworks.h> used by the samples, implemented on the host
+// CPU by libneuralnetworks.so from host/ndk/nnapi. The values of the enums match the NDK.
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_NEURAL_NETWORKS_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_NEURAL_NETWORKS_H
+
+#include <android/hardware_buffer.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ANEURALNETWORKS_FLOAT32 = 0,
+    ANEURALNETWORKS_INT32 = 1,
+    ANEURALNETWORKS_UINT32 = 2,
+    ANEURALNETWORKS_TENSOR_FLOAT32 = 3,
+    ANEURALNETWORKS_TENSOR_INT32 = 4,
+    ANEURALNETWORKS_TENSOR_QUANT8_ASYMM = 5,
+    ANEURALNETWORKS_BOOL = 6,
+    ANEURALNETWORKS_TENSOR_QUANT16_SYMM = 7,
+    ANEURALNETWORKS_TENSOR_FLOAT16 = 8,
+    ANEURALNETWORKS_TENSOR_BOOL8 = 9,
+    ANEURALNETWORKS_FLOAT16 = 10,
+    ANEURALNETWORKS_TENSOR_QUANT8_SYMM_PER_CHANNEL = 11,
+    ANEURALNETWORKS_TENSOR_QUANT16_ASYMM = 12,
+    ANEURALNETWORKS_TENSOR_QUANT8_SYMM = 13,
+    ANEURALNETWORKS_TENSOR_QUANT8_ASYMM_SIGNED = 14,
+    ANEURALNETWORKS_MODEL = 15,
+} OperandCode;
+
+typedef enum {
+    ANEURALNETWORKS_ADD = 0,
+    ANEURALNETWORKS_AVERAGE_POOL_2D = 1,
+    ANEURALNETWORKS_CONCATENATION = 2,
+    ANEURALNETWORKS_CONV_2D = 3,
+    ANEURALNETWORKS_DEPTHWISE_CONV_2D = 4,
+    ANEURALNETWORKS_DEQUANTIZE = 6,
+    ANEURALNETWORKS_LOGISTIC = 14,
+    ANEURALNETWORKS_MAX_POOL_2D = 17,
+    ANEURALNETWORKS_MUL = 18,
+    ANEURALNETWORKS_RELU = 19,
+    ANEURALNETWORKS_RESHAPE = 22,
+    ANEURALNETWORKS_CAST = 45,
+    ANEURALNETWORKS_QUANTIZE = 72,
+} OperationCode;
+
+typedef enum {
+    ANEURALNETWORKS_FUSED_NONE = 0,
+    ANEURALNETWORKS_FUSED_RELU = 1,
+    ANEURALNETWORKS_FUSED_RELU1 = 2,
+    ANEURALNETWORKS_FUSED_RELU6 = 3,
+} FuseCode;
+
+typedef enum {
+    ANEURALNETWORKS_PADDING_SAME = 1,
+    ANEURALNETWORKS_PADDING_VALID = 2,
+} PaddingCode;
+
+typedef enum {
+    ANEURALNETWORKS_PREFER_LOW_POWER = 0,
+    ANEURALNETWORKS_PREFER_FAST_SINGLE_ANSWER = 1,
+    ANEURALNETWORKS_PREFER_SUSTAINED_SPEED = 2,
+} PreferenceCode;
+
+typedef enum {
+    ANEURALNETWORKS_NO_ERROR = 0,
+    ANEURALNETWORKS_OUT_OF_MEMORY = 1,
+    ANEURALNETWORKS_INCOMPLETE = 2,
+    ANEURALNETWORKS_UNEXPECTED_NULL = 3,
+    ANEURALNETWORKS_BAD_DATA = 4,
+    ANEURALNETWORKS_OP_FAILED = 5,
+    ANEURALNETWORKS_BAD_STATE = 6,
+    ANEURALNETWORKS_UNMAPPABLE = 7,
+    ANEURALNETWORKS_OUTPUT_INSUFFICIENT_SIZE = 8,
+    ANEURALNETWORKS_UNAVAILABLE_DEVICE = 9,
+    ANEURALNETWORKS_MISSED_DEADLINE_TRANSIENT = 10,
+    ANEURALNETWORKS_MISSED_DEADLINE_PERSISTENT = 11,
+    ANEURALNETWORKS_RESOURCE_EXHAUSTED_TRANSIENT = 12,
+    ANEURALNETWORKS_RESOURCE_EXHAUSTED_PERSISTENT = 13,
+    ANEURALNETWORKS_DEAD_OBJECT = 14,
+} ResultCode;
+
+typedef enum {
+    ANEURALNETWORKS_DEVICE_UNKNOWN = 0,
+    ANEURALNETWORKS_DEVICE_OTHER = 1,
+    ANEURALNETWORKS_DEVICE_CPU = 2,
+    ANEURALNETWORKS_DEVICE_GPU = 3,
+    ANEURALNETWORKS_DEVICE_ACCELERATOR = 4,
+} DeviceTypeCode;
+
+typedef enum {
+    ANEURALNETWORKS_DURATION_ON_HARDWARE = 0,
+    ANEURALNETWORKS_DURATION_IN_DRIVER = 1,
+    ANEURALNETWORKS_FENCED_DURATION_ON_HARDWARE = 2,
+    ANEURALNETWORKS_FENCED_DURATION_IN_DRIVER = 3,
+} DurationCode;
+
+enum { ANEURALNETWORKS_MAX_SIZE_OF_IMMEDIATELY_COPIED_VALUES = 128 };
+enum { ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN = 32 };
+
+typedef struct ANeuralNetworksMemory ANeuralNetworksMemory;
+typedef struct ANeuralNetworksModel ANeuralNetworksModel;
+typedef struct ANeuralNetworksCompilation ANeuralNetworksCompilation;
+typedef struct ANeuralNetworksExecution ANeuralNetworksExecution;
+typedef struct ANeuralNetworksBurst ANeuralNetworksBurst;
+typedef struct ANeuralNetworksEvent ANeuralNetworksEvent;
+typedef struct ANeuralNetworksMemoryDesc ANeuralNetworksMemoryDesc;
+typedef struct ANeuralNetworksDevice ANeuralNetworksDevice;
+
+typedef struct ANeuralNetworksOperandType {
+    int32_t type;
+    uint32_t dimensionCount;
+    const uint32_t* dimensions;
+    float scale;
+    int32_t zeroPoint;
+} ANeuralNetworksOperandType;
+
+typedef int32_t ANeuralNetworksOperationType;
+
+int64_t ANeuralNetworks_getRuntimeFeatureLevel(void);
+
+// Device
+int ANeuralNetworks_getDeviceCount(uint32_t* numDevices);
+int ANeuralNetworks_getDevice(uint32_t devIndex, ANeuralNetworksDevice** device);
+int ANeuralNetworksDevice_getName(const ANeuralNetworksDevice* device, const char** name);
+int ANeuralNetworksDevice_getType(const ANeuralNetworksDevice* device, int32_t* type);
+int ANeuralNetworksDevice_getVersion(const ANeuralNetworksDevice* device, const char** version);
+int ANeuralNetworksDevice_getFeatureLevel(const ANeuralNetworksDevice* device,
+                                          int64_t* featureLevel);
+
+// Memory
+int ANeuralNetworksMemory_createFromFd(size_t size, int protect, int fd, size_t offset,
+                                       ANeuralNetworksMemory** memory);
+int ANeuralNetworksMemory_createFromAHardwareBuffer(const AHardwareBuffer* ahwb,
+                                                    ANeuralNetworksMemory** memory);
+int ANeuralNetworksMemory_createFromDesc(const ANeuralNetworksMemoryDesc* desc,
+                                         ANeuralNetworksMemory** memory);
+void ANeuralNetworksMemory_free(ANeuralNetworksMemory* memory);
+
+int ANeuralNetworksMemoryDesc_create(ANeuralNetworksMemoryDesc** desc);
+int ANeuralNetworksMemoryDesc_addInputRole(ANeuralNetworksMemoryDesc* desc,
+                                           const ANeuralNetworksCompilation* compilation,
+                                           uint32_t index, float frequency);
+int ANeuralNetworksMemoryDesc_addOutputRole(ANeuralNetworksMemoryDesc* desc,
+                                            const ANeuralNetworksCompilation* compilation,
+                                            uint32_t index, float frequency);
+int ANeuralNetworksMemoryDesc_finish(ANeuralNetworksMemoryDesc* desc);
+void ANeuralNetworksMemoryDesc_free(ANeuralNetworksMemoryDesc* desc);
+
+// Model
+int ANeuralNetworksModel_create(ANeuralNetworksModel** model);
+void ANeuralNetworksModel_free(ANeuralNetworksModel* model);
+int ANeuralNetworksModel_finish(ANeuralNetworksModel* model);
+int ANeuralNetworksModel_addOperand(ANeuralNetworksModel* model,
+                                    const ANeuralNetworksOperandType* type);
+int ANeuralNetworksModel_setOperandValue(ANeuralNetworksModel* model, int32_t index,
+                                         const void* buffer, size_t length);
+int ANeuralNetworksModel_setOperandValueFromMemory(ANeuralNetworksModel* model, int32_t index,
+                                                   const ANeuralNetworksMemory* memory,
+                                                   size_t offset, size_t length);
+int ANeuralNetworksModel_addOperation(ANeuralNetworksModel* model,
+                                      ANeuralNetworksOperationType type, uint32_t inputCount,
+                                      const uint32_t* inputs, uint32_t outputCount,
+                                      const uint32_t* outputs);
+int ANeuralNetworksModel_identifyInputsAndOutputs(ANeuralNetworksModel* model,
+                                                  uint32_t inputCount, const uint32_t* inputs,
+                                                  uint32_t outputCount, const uint32_t* outputs);
+int ANeuralNetworksModel_relaxComputationFloat32toFloat16(ANeuralNetworksModel* model, bool allow);
+int ANeuralNetworksModel_getSupportedOperationsForDevices(
+        const ANeuralNetworksModel* model, const ANeuralNetworksDevice* const* devices,
+        uint32_t numDevices, bool* supportedOps);
+
+// Compilation
+int ANeuralNetworksCompilation_create(ANeuralNetworksModel* model,
+                                      ANeuralNetworksCompilation** compilation);
+int ANeuralNetworksCompilation_createForDevices(ANeuralNetworksModel* model,
+                                                const ANeuralNetworksDevice* const* devices,
+                                                uint32_t numDevices,
+                                                ANeuralNetworksCompilation** compilation);
+void ANeuralNetworksCompilation_free(ANeuralNetworksCompilation* compilation);
+int ANeuralNetworksCompilation_setPreference(ANeuralNetworksCompilation* compilation,
+                                             int32_t preference);
+int ANeuralNetworksCompilation_setCaching(ANeuralNetworksCompilation* compilation,
+                                          const char* cacheDir, const uint8_t* token);
+int ANeuralNetworksCompilation_finish(ANeuralNetworksCompilation* compilation);
+int ANeuralNetworksCompilation_getPreferredMemoryAlignmentForInput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* alignment);
+int ANeuralNetworksCompilation_getPreferredMemoryPaddingForInput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* padding);
+int ANeuralNetworksCompilation_getPreferredMemoryAlignmentForOutput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* alignment);
+int ANeuralNetworksCompilation_getPreferredMemoryPaddingForOutput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* padding);
+
+// Burst
+int ANeuralNetworksBurst_create(ANeuralNetworksCompilation* compilation,
+                                ANeuralNetworksBurst** burst);
+void ANeuralNetworksBurst_free(ANeuralNetworksBurst* burst);
+
+// Execution
+int ANeuralNetworksExecution_create(ANeuralNetworksCompilation* compilation,
+                                    ANeuralNetworksExecution** execution);
+void ANeuralNetworksExecution_free(ANeuralNetworksExecution* execution);
+int ANeuralNetworksExecution_setReusable(ANeuralNetworksExecution* execution, bool reusable);
+int ANeuralNetworksExecution_enableInputAndOutputPadding(ANeuralNetworksExecution* execution,
+                                                         bool enable);
+int ANeuralNetworksExecution_setInput(ANeuralNetworksExecution* execution, int32_t index,
+                                      const ANeuralNetworksOperandType* type, const void* buffer,
+                                      size_t length);
+int ANeuralNetworksExecution_setInputFromMemory(ANeuralNetworksExecution* execution,
+                                                int32_t index,
+                                                const ANeuralNetworksOperandType* type,
+                                                const ANeuralNetworksMemory* memory,
+                                                size_t offset, size_t length);
+int ANeuralNetworksExecution_setOutput(ANeuralNetworksExecution* execution, int32_t index,
+                                       const ANeuralNetworksOperandType* type, void* buffer,
+                                       size_t length);
+int ANeuralNetworksExecution_setOutputFromMemory(ANeuralNetworksExecution* execution,
+                                                 int32_t index,
+                                                 const ANeuralNetworksOperandType* type,
+                                                 const ANeuralNetworksMemory* memory,
+                                                 size_t offset, size_t length);
+int ANeuralNetworksExecution_setMeasureTiming(ANeuralNetworksExecution* execution, bool measure);
+int ANeuralNetworksExecution_getDuration(const ANeuralNetworksExecution* execution,
+                                         int32_t durationCode, uint64_t* duration);
+int ANeuralNetworksExecution_compute(ANeuralNetworksExecution* execution);
+int ANeuralNetworksExecution_burstCompute(ANeuralNetworksExecution* execution,
+                                          ANeuralNetworksBurst* burst);
+int ANeuralNetworksExecution_startCompute(ANeuralNetworksExecution* execution,
+                                          ANeuralNetworksEvent** event);
+int ANeuralNetworksExecution_startComputeWithDependencies(
+        ANeuralNetworksExecution* execution, const ANeuralNetworksEvent* const* dependencies,
+        uint32_t num_dependencies, uint64_t duration, ANeuralNetworksEvent** event);
+
+// Event
+int ANeuralNetworksEvent_createFromSyncFenceFd(int sync_fence_fd, ANeuralNetworksEvent** event);
+int ANeuralNetworksEvent_wait(ANeuralNetworksEvent* event);
+void ANeuralNetworksEvent_free(ANeuralNetworksEvent* event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_NEURAL_NETWORKS_H
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_API_LEVEL_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_API_LEVEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns 31 on the host, or the value of the HOST_NDK_API_LEVEL environment variable if set
+int android_get_device_api_level(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_API_LEVEL_H
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The subset of the NDK <android/asset_manager.h> used by the samples, implemented on the host by
+// libandroid.so from host/ndk. Assets are read from a directory, see <host_ndk.h>.
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_ASSET_MANAGER_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_ASSET_MANAGER_H
+
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct AAssetManager AAssetManager;
+typedef struct AAsset AAsset;
+
+enum {
+    AASSET_MODE_UNKNOWN = 0,
+    AASSET_MODE_RANDOM = 1,
+    AASSET_MODE_STREAMING = 2,
+    AASSET_MODE_BUFFER = 3,
+};
+
+AAsset* AAssetManager_open(AAssetManager* mgr, const char* filename, int mode);
+int AAsset_read(AAsset* asset, void* buf, size_t count);
+void AAsset_close(AAsset* asset);
+const void* AAsset_getBuffer(AAsset* asset);
+off_t AAsset_getLength(AAsset* asset);
+off64_t AAsset_getLength64(AAsset* asset);
+int AAsset_openFileDescriptor(AAsset* asset, off_t* outStart, off_t* outLength);
+int AAsset_openFileDescriptor64(AAsset* asset, off64_t* outStart, off64_t* outLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_ASSET_MANAGER_H
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// There is no JVM on the host, so this only provides <android/asset_manager.h>
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_ASSET_MANAGER_JNI_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_ASSET_MANAGER_JNI_H
+
+#include <android/asset_manager.h>
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_ASSET_MANAGER_JNI_H
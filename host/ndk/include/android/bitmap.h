@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// There is no JVM on the host, so this only provides the types of <android/bitmap.h>
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_BITMAP_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_BITMAP_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum AndroidBitmapFormat {
+    ANDROID_BITMAP_FORMAT_NONE = 0,
+    ANDROID_BITMAP_FORMAT_RGBA_8888 = 1,
+};
+
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    int32_t format;
+    uint32_t flags;
+} AndroidBitmapInfo;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_BITMAP_H
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The subset of the NDK <android/hardware_buffer.h> used by the samples, implemented on the host
+// by libnativewindow.so from host/ndk. Buffers are backed by memfd shared memory and are always
+// CPU accessible, whatever their usage flags. Y8Cb8Cr8_420 buffers are laid out as I420: the
+// full-resolution Y plane followed by the half-resolution Cb and Cr planes.
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_HARDWARE_BUFFER_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_HARDWARE_BUFFER_H
+
+#include <android/rect.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum AHardwareBuffer_Format {
+    AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM = 1,
+    AHARDWAREBUFFER_FORMAT_R8G8B8X8_UNORM = 2,
+    AHARDWAREBUFFER_FORMAT_R16G16B16A16_FLOAT = 0x16,
+    AHARDWAREBUFFER_FORMAT_BLOB = 0x21,
+    AHARDWAREBUFFER_FORMAT_Y8Cb8Cr8_420 = 0x23,
+};
+
+enum AHardwareBuffer_UsageFlags {
+    AHARDWAREBUFFER_USAGE_CPU_READ_NEVER = 0UL,
+    AHARDWAREBUFFER_USAGE_CPU_READ_RARELY = 2UL,
+    AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN = 3UL,
+    AHARDWAREBUFFER_USAGE_CPU_READ_MASK = 0xFUL,
+    AHARDWAREBUFFER_USAGE_CPU_WRITE_NEVER = 0UL << 4,
+    AHARDWAREBUFFER_USAGE_CPU_WRITE_RARELY = 2UL << 4,
+    AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN = 3UL << 4,
+    AHARDWAREBUFFER_USAGE_CPU_WRITE_MASK = 0xFUL << 4,
+    AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE = 1UL << 8,
+    AHARDWAREBUFFER_USAGE_GPU_FRAMEBUFFER = 1UL << 9,
+    AHARDWAREBUFFER_USAGE_GPU_DATA_BUFFER = 1UL << 24,
+};
+
+typedef struct AHardwareBuffer_Desc {
+    uint32_t width;
+    uint32_t height;
+    uint32_t layers;
+    uint32_t format;
+    uint64_t usage;
+    uint32_t stride;
+    uint32_t rfu0;
+    uint64_t rfu1;
+} AHardwareBuffer_Desc;
+
+typedef struct AHardwareBuffer_Plane {
+    void* data;
+    uint32_t pixelStride;
+    uint32_t rowStride;
+} AHardwareBuffer_Plane;
+
+typedef struct AHardwareBuffer_Planes {
+    uint32_t planeCount;
+    AHardwareBuffer_Plane planes[4];
+} AHardwareBuffer_Planes;
+
+typedef struct AHardwareBuffer AHardwareBuffer;
+
+int AHardwareBuffer_allocate(const AHardwareBuffer_Desc* desc, AHardwareBuffer** outBuffer);
+void AHardwareBuffer_acquire(AHardwareBuffer* buffer);
+void AHardwareBuffer_release(AHardwareBuffer* buffer);
+void AHardwareBuffer_describe(const AHardwareBuffer* buffer, AHardwareBuffer_Desc* outDesc);
+int AHardwareBuffer_lock(AHardwareBuffer* buffer, uint64_t usage, int32_t fence, const ARect* rect,
+                         void** outVirtualAddress);
+int AHardwareBuffer_lockPlanes(AHardwareBuffer* buffer, uint64_t usage, int32_t fence,
+                               const ARect* rect, AHardwareBuffer_Planes* outPlanes);
+int AHardwareBuffer_unlock(AHardwareBuffer* buffer, int32_t* fence);
+int AHardwareBuffer_getId(const AHardwareBuffer* buffer, uint64_t* outId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_HARDWARE_BUFFER_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The NDK <android/sharedmem.h> implemented on the host by libandroid.so from host/ndk, with
+// memfd in place of ashmem
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_SHAREDMEM_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_SHAREDMEM_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int ASharedMemory_create(const char* name, size_t size);
+size_t ASharedMemory_getSize(int fd);
+int ASharedMemory_setProt(int fd, int prot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_SHAREDMEM_H
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The NDK <android/trace.h> implemented on the host by libandroid.so from host/ndk. There is no
+// system tracing on the host, so the sections are dropped.
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_TRACE_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_TRACE_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool ATrace_isEnabled();
+void ATrace_beginSection(const char* sectionName);
+void ATrace_endSection();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_ANDROID_TRACE_H
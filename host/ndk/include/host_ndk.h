@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Host-only entry points of the NDK stand-in in host/ndk, which have no counterpart on Android
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_INCLUDE_HOST_NDK_H
+#define NNAPI_SAMPLES_HOST_NDK_INCLUDE_HOST_NDK_H
+
+#include <android/asset_manager.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Creates an asset manager that opens the assets of the given directory, e.g. the assets
+// directory of a sample app. Returns nullptr if the directory does not exist.
+AAssetManager* HostNdk_createAssetManager(const char* directory);
+void HostNdk_destroyAssetManager(AAssetManager* assetManager);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_INCLUDE_HOST_NDK_H
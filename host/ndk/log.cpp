@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// liblog: the Android log is written to stderr, one line per message
+
+#include <android/log.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+char priorityLetter(int prio) {
+    switch (prio) {
+        case ANDROID_LOG_VERBOSE:
+            return 'V';
+        case ANDROID_LOG_DEBUG:
+            return 'D';
+        case ANDROID_LOG_INFO:
+            return 'I';
+        case ANDROID_LOG_WARN:
+            return 'W';
+        case ANDROID_LOG_ERROR:
+            return 'E';
+        case ANDROID_LOG_FATAL:
+            return 'F';
+        default:
+            return '?';
+    }
+}
+
+// Messages below ANDROID_LOG_INFO are dropped unless HOST_NDK_LOG_PRIORITY lowers the threshold
+int minimumPriority() {
+    static const int priority = [] {
+        const char* value = std::getenv("HOST_NDK_LOG_PRIORITY");
+        return value != nullptr ? std::atoi(value) : static_cast<int>(ANDROID_LOG_INFO);
+    }();
+    return priority;
+}
+
+int vlog(int prio, const char* tag, const char* fmt, va_list args) {
+    if (prio < minimumPriority()) return 0;
+    char message[1024];
+    std::vsnprintf(message, sizeof(message), fmt, args);
+    return __android_log_write(prio, tag, message);
+}
+
+}  // namespace
+
+int __android_log_write(int prio, const char* tag, const char* text) {
+    if (prio < minimumPriority()) return 0;
+    // A single write per line keeps the lines of concurrent threads apart
+    const std::string line = std::string(1, priorityLetter(prio)) + "/" + (tag ? tag : "") + ": " +
+                             (text ? text : "") + "\n";
+    return std::fwrite(line.data(), 1, line.size(), stderr);
+}
+
+int __android_log_print(int prio, const char* tag, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    const int result = vlog(prio, tag, fmt, args);
+    va_end(args);
+    return result;
+}
+
+void __android_log_assert(const char* cond, const char* tag, const char* fmt, ...) {
+    if (fmt != nullptr) {
+        va_list args;
+        va_start(args, fmt);
+        vlog(ANDROID_LOG_FATAL, tag, fmt, args);
+        va_end(args);
+    } else {
+        __android_log_print(ANDROID_LOG_FATAL, tag, "Assertion failed: %s", cond ? cond : "");
+    }
+    std::abort();
+}
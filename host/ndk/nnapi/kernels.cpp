@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kernels.h"
+
+#include <android/NeuralNetworks.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace host_nnapi {
+namespace {
+
+uint32_t numberOfElements(const Dimensions& dimensions) {
+    uint32_t count = 1;
+    for (uint32_t dimension : dimensions) count *= dimension;
+    return count;
+}
+
+void applyActivation(int32_t activation, float* data, uint32_t size) {
+    float low, high;
+    switch (activation) {
+        case ANEURALNETWORKS_FUSED_RELU:
+            for (uint32_t i = 0; i < size; i++) data[i] = std::max(data[i], 0.0f);
+            return;
+        case ANEURALNETWORKS_FUSED_RELU1:
+            low = -1.0f;
+            high = 1.0f;
+            break;
+        case ANEURALNETWORKS_FUSED_RELU6:
+            low = 0.0f;
+            high = 6.0f;
+            break;
+        default:
+            return;
+    }
+    for (uint32_t i = 0; i < size; i++) data[i] = std::clamp(data[i], low, high);
+}
+
+// Computes output = op(a, b) element-wise. The operand dimensions are aligned to the right, and a
+// dimension of 1 is broadcast to the matching output dimension.
+template <typename Op>
+void broadcastBinary(const float* a, const Dimensions& aDimensions, const float* b,
+                     const Dimensions& bDimensions, int32_t activation, float* output,
+                     const Dimensions& outputDimensions, Op op) {
+    const uint32_t size = numberOfElements(outputDimensions);
+    const uint32_t aSize = numberOfElements(aDimensions), bSize = numberOfElements(bDimensions);
+    if (aSize == size && bSize == size) {
+        for (uint32_t i = 0; i < size; i++) output[i] = op(a[i], b[i]);
+    } else if (aSize == size && bSize == 1) {
+        for (uint32_t i = 0; i < size; i++) output[i] = op(a[i], b[0]);
+    } else if (aSize == 1 && bSize == size) {
+        for (uint32_t i = 0; i < size; i++) output[i] = op(a[0], b[i]);
+    } else {
+        // The strides of a and b along every output dimension, 0 for broadcast dimensions
+        const uint32_t rank = outputDimensions.size();
+        std::vector<uint32_t> aStrides(rank, 0), bStrides(rank, 0);
+        auto computeStrides = [rank](const Dimensions& dimensions, std::vector<uint32_t>* strides) {
+            uint32_t stride = 1;
+            for (uint32_t i = 0; i < dimensions.size(); i++) {
+                const uint32_t dimension = dimensions[dimensions.size() - 1 - i];
+                (*strides)[rank - 1 - i] = dimension == 1 ? 0 : stride;
+                stride *= dimension;
+            }
+        };
+        computeStrides(aDimensions, &aStrides);
+        computeStrides(bDimensions, &bStrides);
+        for (uint32_t i = 0; i < size; i++) {
+            uint32_t aIndex = 0, bIndex = 0;
+            for (uint32_t d = rank, rest = i; d-- > 0; rest /= outputDimensions[d]) {
+                const uint32_t coordinate = rest % outputDimensions[d];
+                aIndex += coordinate * aStrides[d];
+                bIndex += coordinate * bStrides[d];
+            }
+            output[i] = op(a[aIndex], b[bIndex]);
+        }
+    }
+    applyActivation(activation, output, size);
+}
+
+float float16ToFloat32(uint16_t half) {
+    const uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1f;
+    const uint32_t mantissa = half & 0x3ff;
+    uint32_t bits;
+    if (exponent == 0) {
+        // Zero or subnormal, in units of 2^-24
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        std::memcpy(&bits, &magnitude, sizeof(bits));
+        bits |= sign;
+    } else if (exponent == 0x1f) {
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t float32ToFloat16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = (bits >> 16) & 0x8000;
+    bits &= 0x7fffffff;
+    if (bits > 0x7f800000) return sign | 0x7e00;
+    if (bits >= 0x477ff000) return sign | 0x7c00;
+    if (bits < 0x38800000) {
+        float magnitude;
+        std::memcpy(&magnitude, &bits, sizeof(magnitude));
+        return sign | static_cast<uint16_t>(std::nearbyint(std::ldexp(magnitude, 24)));
+    }
+    const uint32_t rounded = bits + 0xfff + ((bits >> 13) & 1);
+    return sign | static_cast<uint16_t>((rounded - 0x38000000) >> 13);
+}
+
+}  // namespace
+
+void addFloat32(const float* a, const Dimensions& aDimensions, const float* b,
+                const Dimensions& bDimensions, int32_t activation, float* output,
+                const Dimensions& outputDimensions) {
+    broadcastBinary(a, aDimensions, b, bDimensions, activation, output, outputDimensions,
+                    [](float x, float y) { return x + y; });
+}
+
+void mulFloat32(const float* a, const Dimensions& aDimensions, const float* b,
+                const Dimensions& bDimensions, int32_t activation, float* output,
+                const Dimensions& outputDimensions) {
+    broadcastBinary(a, aDimensions, b, bDimensions, activation, output, outputDimensions,
+                    [](float x, float y) { return x * y; });
+}
+
+void conv2dFloat32(const float* input, const Dimensions& inputDimensions, const float* filter,
+                   const Dimensions& filterDimensions, const float* bias,
+                   const ConvolutionParams& params, float* output,
+                   const Dimensions& outputDimensions) {
+    const uint32_t batches = inputDimensions[0];
+    const uint32_t inputHeight = inputDimensions[1], inputWidth = inputDimensions[2];
+    const uint32_t inputDepth = inputDimensions[3];
+    const uint32_t filterHeight = filterDimensions[1], filterWidth = filterDimensions[2];
+    const uint32_t outputHeight = outputDimensions[1], outputWidth = outputDimensions[2];
+    const uint32_t outputDepth = outputDimensions[3];
+
+    // Transpose the filter to [height, width, depth_in, depth_out], so that the innermost loop
+    // below runs over contiguous output channels and can be vectorized
+    thread_local std::vector<float> transposedFilter;
+    transposedFilter.resize(numberOfElements(filterDimensions));
+    for (uint32_t o = 0; o < outputDepth; o++) {
+        for (uint32_t k = 0; k < filterHeight * filterWidth; k++) {
+            for (uint32_t i = 0; i < inputDepth; i++) {
+                transposedFilter[(k * inputDepth + i) * outputDepth + o] =
+                        filter[(o * filterHeight * filterWidth + k) * inputDepth + i];
+            }
+        }
+    }
+
+    for (uint32_t b = 0; b < batches; b++) {
+        for (uint32_t y = 0; y < outputHeight; y++) {
+            for (uint32_t x = 0; x < outputWidth; x++) {
+                float* out = output + ((b * outputHeight + y) * outputWidth + x) * outputDepth;
+                std::memcpy(out, bias, outputDepth * sizeof(float));
+                for (uint32_t fy = 0; fy < filterHeight; fy++) {
+                    const int64_t inY = static_cast<int64_t>(y * params.strideHeight) -
+                                        params.paddingTop + fy * params.dilationHeight;
+                    if (inY < 0 || inY >= inputHeight) continue;
+                    for (uint32_t fx = 0; fx < filterWidth; fx++) {
+                        const int64_t inX = static_cast<int64_t>(x * params.strideWidth) -
+                                            params.paddingLeft + fx * params.dilationWidth;
+                        if (inX < 0 || inX >= inputWidth) continue;
+                        const float* in =
+                                input + ((b * inputHeight + inY) * inputWidth + inX) * inputDepth;
+                        const float* weights = transposedFilter.data() +
+                                               (fy * filterWidth + fx) * inputDepth * outputDepth;
+                        for (uint32_t i = 0; i < inputDepth; i++) {
+                            const float value = in[i];
+                            const float* w = weights + i * outputDepth;
+                            for (uint32_t o = 0; o < outputDepth; o++) out[o] += value * w[o];
+                        }
+                    }
+                }
+                applyActivation(params.activation, out, outputDepth);
+            }
+        }
+    }
+}
+
+void depthwiseConv2dFloat32(const float* input, const Dimensions& inputDimensions,
+                            const float* filter, const Dimensions& filterDimensions,
+                            const float* bias, const ConvolutionParams& params, float* output,
+                            const Dimensions& outputDimensions) {
+    const uint32_t batches = inputDimensions[0];
+    const uint32_t inputHeight = inputDimensions[1], inputWidth = inputDimensions[2];
+    const uint32_t inputDepth = inputDimensions[3];
+    const uint32_t filterHeight = filterDimensions[1], filterWidth = filterDimensions[2];
+    const uint32_t outputHeight = outputDimensions[1], outputWidth = outputDimensions[2];
+    const uint32_t outputDepth = outputDimensions[3];
+    const uint32_t multiplier = params.depthMultiplier;
+
+    for (uint32_t b = 0; b < batches; b++) {
+        for (uint32_t y = 0; y < outputHeight; y++) {
+            for (uint32_t x = 0; x < outputWidth; x++) {
+                float* out = output + ((b * outputHeight + y) * outputWidth + x) * outputDepth;
+                std::memcpy(out, bias, outputDepth * sizeof(float));
+                for (uint32_t fy = 0; fy < filterHeight; fy++) {
+                    const int64_t inY = static_cast<int64_t>(y * params.strideHeight) -
+                                        params.paddingTop + fy * params.dilationHeight;
+                    if (inY < 0 || inY >= inputHeight) continue;
+                    for (uint32_t fx = 0; fx < filterWidth; fx++) {
+                        const int64_t inX = static_cast<int64_t>(x * params.strideWidth) -
+                                            params.paddingLeft + fx * params.dilationWidth;
+                        if (inX < 0 || inX >= inputWidth) continue;
+                        const float* in =
+                                input + ((b * inputHeight + inY) * inputWidth + inX) * inputDepth;
+                        const float* w = filter + (fy * filterWidth + fx) * outputDepth;
+                        if (multiplier == 1) {
+                            for (uint32_t o = 0; o < outputDepth; o++) out[o] += in[o] * w[o];
+                        } else {
+                            for (uint32_t o = 0; o < outputDepth; o++) {
+                                out[o] += in[o / multiplier] * w[o];
+                            }
+                        }
+                    }
+                }
+                applyActivation(params.activation, out, outputDepth);
+            }
+        }
+    }
+}
+
+void castFloat16ToFloat32(const uint16_t* input, uint32_t size, float* output) {
+    for (uint32_t i = 0; i < size; i++) output[i] = float16ToFloat32(input[i]);
+}
+
+void castFloat32ToFloat16(const float* input, uint32_t size, uint16_t* output) {
+    for (uint32_t i = 0; i < size; i++) output[i] = float32ToFloat16(input[i]);
+}
+
+}  // namespace host_nnapi
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_NNAPI_KERNELS_H
+#define NNAPI_SAMPLES_HOST_NDK_NNAPI_KERNELS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace host_nnapi {
+
+// Reference kernels of the host NNAPI. All tensors are dense TENSOR_FLOAT32, but for the
+// half-precision side of CAST, in the NNAPI layout: NHWC for the images,
+// [depth_out, height, width, depth_in] for the CONV_2D filters, and [1, height, width, depth_out]
+// for the DEPTHWISE_CONV_2D filters.
+
+using Dimensions = std::vector<uint32_t>;
+
+// ADD and MUL with NNAPI broadcasting, and the FuseCode activation applied to the result
+void addFloat32(const float* a, const Dimensions& aDimensions, const float* b,
+                const Dimensions& bDimensions, int32_t activation, float* output,
+                const Dimensions& outputDimensions);
+void mulFloat32(const float* a, const Dimensions& aDimensions, const float* b,
+                const Dimensions& bDimensions, int32_t activation, float* output,
+                const Dimensions& outputDimensions);
+
+struct ConvolutionParams {
+    uint32_t paddingLeft = 0;
+    uint32_t paddingRight = 0;
+    uint32_t paddingTop = 0;
+    uint32_t paddingBottom = 0;
+    uint32_t strideWidth = 1;
+    uint32_t strideHeight = 1;
+    uint32_t dilationWidth = 1;
+    uint32_t dilationHeight = 1;
+    // DEPTHWISE_CONV_2D only
+    uint32_t depthMultiplier = 1;
+    int32_t activation = 0;
+};
+
+void conv2dFloat32(const float* input, const Dimensions& inputDimensions, const float* filter,
+                   const Dimensions& filterDimensions, const float* bias,
+                   const ConvolutionParams& params, float* output,
+                   const Dimensions& outputDimensions);
+void depthwiseConv2dFloat32(const float* input, const Dimensions& inputDimensions,
+                            const float* filter, const Dimensions& filterDimensions,
+                            const float* bias, const ConvolutionParams& params, float* output,
+                            const Dimensions& outputDimensions);
+
+// CAST between TENSOR_FLOAT16, stored as the bits of IEEE 754 half-precision values, and
+// TENSOR_FLOAT32. The conversion to half precision rounds to the nearest value, ties to even.
+void castFloat16ToFloat32(const uint16_t* input, uint32_t size, float* output);
+void castFloat32ToFloat16(const float* input, uint32_t size, uint16_t* output);
+
+}  // namespace host_nnapi
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_NNAPI_KERNELS_H
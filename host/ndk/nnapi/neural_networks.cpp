@@ -0,0 +1,984 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// libneuralnetworks: the NNAPI C API on the host CPU
+//
+// The host NNAPI is a single reference device. Computations run the operations one after the
+// other on the calling thread, or on a thread of their own for the asynchronous computations, and
+// the compilation does no more than validating the model. It is meant to exercise the code of the
+// samples and to compare the cost of their host-side logic, not to be fast.
+
+#include <android/NeuralNetworks.h>
+#include <android/hardware_buffer.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "runtime.h"
+
+using host_nnapi::Dimensions;
+using host_nnapi::Operand;
+using host_nnapi::Operation;
+
+namespace {
+
+// The single device of the host NNAPI
+const ANeuralNetworksDevice kDevice = {
+        .name = host_nnapi::kDeviceName,
+        .type = ANEURALNETWORKS_DEVICE_CPU,
+        .version = host_nnapi::kDeviceVersion,
+        .featureLevel = host_nnapi::kFeatureLevel,
+};
+
+uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+}
+
+// The operand of the model input or output of a compilation
+const Operand* getIoOperand(const ANeuralNetworksCompilation* compilation, bool isInput,
+                            uint32_t index) {
+    const ANeuralNetworksModel* model = compilation->model;
+    const auto& ioIndexes = isInput ? model->inputs : model->outputs;
+    return index < ioIndexes.size() ? &model->operands[ioIndexes[index]] : nullptr;
+}
+
+// Checks that an optional operand type passed to an execution matches the operand of the model
+bool matchesOperand(const ANeuralNetworksOperandType* type, const Operand& operand) {
+    if (type == nullptr) return true;
+    return type->type == operand.type &&
+           Dimensions(type->dimensions, type->dimensions + type->dimensionCount) ==
+                   operand.dimensions;
+}
+
+int sortIntoRunOrder(ANeuralNetworksModel* model) {
+    // Kahn's algorithm over the temporaries and the model outputs, which must be written by
+    // exactly one operation
+    std::vector<int> writer(model->operands.size(), -1);
+    for (uint32_t i = 0; i < model->operations.size(); i++) {
+        for (uint32_t output : model->operations[i].outputs) {
+            const auto lifetime = model->operands[output].lifetime;
+            NN_RETURN_IF(lifetime != Operand::Lifetime::TEMPORARY &&
+                                 lifetime != Operand::Lifetime::MODEL_OUTPUT,
+                         ANEURALNETWORKS_BAD_DATA, "Operand %u cannot be an operation output",
+                         output);
+            NN_RETURN_IF(writer[output] >= 0, ANEURALNETWORKS_BAD_DATA,
+                         "Operand %u is written by more than one operation", output);
+            writer[output] = i;
+        }
+    }
+    for (uint32_t i = 0; i < model->operands.size(); i++) {
+        const auto lifetime = model->operands[i].lifetime;
+        NN_RETURN_IF((lifetime == Operand::Lifetime::TEMPORARY ||
+                      lifetime == Operand::Lifetime::MODEL_OUTPUT) &&
+                             writer[i] < 0,
+                     ANEURALNETWORKS_BAD_DATA, "Operand %u has no value", i);
+    }
+
+    std::vector<uint32_t> missingInputs(model->operations.size(), 0);
+    std::vector<std::vector<uint32_t>> readers(model->operands.size());
+    std::queue<uint32_t> ready;
+    for (uint32_t i = 0; i < model->operations.size(); i++) {
+        for (uint32_t input : model->operations[i].inputs) {
+            if (writer[input] >= 0) {
+                missingInputs[i]++;
+                readers[input].push_back(i);
+            }
+        }
+        if (missingInputs[i] == 0) ready.push(i);
+    }
+    std::vector<Operation> sorted;
+    while (!ready.empty()) {
+        const uint32_t i = ready.front();
+        ready.pop();
+        sorted.push_back(model->operations[i]);
+        for (uint32_t output : model->operations[i].outputs) {
+            for (uint32_t reader : readers[output]) {
+                if (--missingInputs[reader] == 0) ready.push(reader);
+            }
+        }
+    }
+    NN_RETURN_IF(sorted.size() != model->operations.size(), ANEURALNETWORKS_BAD_DATA,
+                 "The model has a cycle");
+    model->operations = std::move(sorted);
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+// Checks the length of an execution argument against its operand
+int validateArgumentLength(const ANeuralNetworksExecution* execution, const Operand& operand,
+                           size_t length) {
+    const size_t size = host_nnapi::byteSize(operand);
+    NN_RETURN_IF(size == 0, ANEURALNETWORKS_BAD_DATA,
+                 "The execution inputs and outputs must be fully specified");
+    NN_RETURN_IF(execution->paddingEnabled ? length < size : length != size,
+                 ANEURALNETWORKS_BAD_DATA, "Invalid argument length %zu, expected %zu", length,
+                 size);
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int setArgument(ANeuralNetworksExecution* execution, bool isInput, int32_t index,
+                const ANeuralNetworksOperandType* type, const ANeuralNetworksMemory* memory,
+                const void* buffer, size_t offset, size_t length) {
+    NN_RETURN_IF(execution == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null execution");
+    std::lock_guard<std::mutex> lock(execution->mutex);
+    NN_RETURN_IF(execution->state != ANeuralNetworksExecution::State::PREPARATION,
+                 ANEURALNETWORKS_BAD_STATE, "The execution has already started");
+    const Operand* operand = getIoOperand(execution->compilation, isInput, index);
+    NN_RETURN_IF(operand == nullptr, ANEURALNETWORKS_BAD_DATA, "Invalid %s index %d",
+                 isInput ? "input" : "output", index);
+    NN_RETURN_IF(!matchesOperand(type, *operand), ANEURALNETWORKS_BAD_DATA,
+                 "The type of %s %d does not match the model", isInput ? "input" : "output",
+                 index);
+    auto& argument = isInput ? execution->inputs[index] : execution->outputs[index];
+    execution->anyArgumentSet = true;
+
+    using Kind = ANeuralNetworksExecution::Argument::Kind;
+    if (memory == nullptr) {
+        if (buffer == nullptr) {
+            NN_RETURN_IF(length != 0 || !isInput, ANEURALNETWORKS_UNEXPECTED_NULL,
+                         "Null buffer");
+            argument = {.kind = Kind::OMITTED};
+            return ANEURALNETWORKS_NO_ERROR;
+        }
+        const int result = validateArgumentLength(execution, *operand, length);
+        if (result != ANEURALNETWORKS_NO_ERROR) return result;
+        argument = {.kind = Kind::POINTER,
+                    .data = static_cast<uint8_t*>(const_cast<void*>(buffer))};
+        return ANEURALNETWORKS_NO_ERROR;
+    }
+
+    if (memory->isDeviceMemory) {
+        // A device memory is used as a whole
+        NN_RETURN_IF(offset != 0 || length != 0, ANEURALNETWORKS_BAD_DATA,
+                     "The offset and length must be 0 for a memory created from a descriptor");
+        NN_RETURN_IF(memory->size != host_nnapi::byteSize(*operand), ANEURALNETWORKS_BAD_DATA,
+                     "The memory does not match %s %d", isInput ? "input" : "output", index);
+    } else {
+        NN_RETURN_IF(offset + length > memory->size, ANEURALNETWORKS_BAD_DATA,
+                     "The argument exceeds the memory: offset %zu, length %zu, size %zu", offset,
+                     length, memory->size);
+        const int result = validateArgumentLength(execution, *operand, length);
+        if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    }
+    argument = {.kind = Kind::MEMORY, .data = memory->data + offset};
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+// Moves the execution to the computation state, if it may compute
+int beginComputation(ANeuralNetworksExecution* execution) {
+    using State = ANeuralNetworksExecution::State;
+    std::lock_guard<std::mutex> lock(execution->mutex);
+    NN_RETURN_IF(execution->state == State::COMPUTATION, ANEURALNETWORKS_BAD_STATE,
+                 "The execution is already computing");
+    NN_RETURN_IF(execution->state == State::COMPLETED && !execution->reusable,
+                 ANEURALNETWORKS_BAD_STATE, "The execution is not reusable");
+    for (const auto* arguments : {&execution->inputs, &execution->outputs}) {
+        for (const auto& argument : *arguments) {
+            NN_RETURN_IF(argument.kind == ANeuralNetworksExecution::Argument::Kind::UNSPECIFIED,
+                         ANEURALNETWORKS_BAD_DATA, "Not all inputs and outputs are set");
+        }
+    }
+    execution->state = State::COMPUTATION;
+    execution->durationOnHardware = UINT64_MAX;
+    execution->durationInDriver = UINT64_MAX;
+    execution->fencedDurationOnHardware = UINT64_MAX;
+    execution->fencedDurationInDriver = UINT64_MAX;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+// Leaves the computation state, and deletes the execution if it was freed meanwhile
+void endComputation(ANeuralNetworksExecution* execution) {
+    bool freeRequested;
+    {
+        std::lock_guard<std::mutex> lock(execution->mutex);
+        execution->state = ANeuralNetworksExecution::State::COMPLETED;
+        freeRequested = execution->freeRequested;
+    }
+    if (freeRequested) delete execution;
+}
+
+// Runs the operations of the model. The computation has entered the driver at driverStartNs, after
+// its dependencies if fenced.
+int runModel(ANeuralNetworksExecution* execution, uint64_t driverStartNs, bool fenced) {
+    const ANeuralNetworksModel* model = execution->compilation->model;
+    const auto& operands = model->operands;
+    if (execution->buffers.empty()) {
+        execution->buffers.resize(operands.size(), nullptr);
+        for (uint32_t i = 0; i < operands.size(); i++) {
+            if (operands[i].lifetime == Operand::Lifetime::TEMPORARY) {
+                execution->temporaries.emplace_back(host_nnapi::byteSize(operands[i]));
+                execution->buffers[i] = execution->temporaries.back().data();
+            } else if (operands[i].lifetime == Operand::Lifetime::CONSTANT) {
+                execution->buffers[i] = const_cast<uint8_t*>(operands[i].value);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < model->inputs.size(); i++) {
+        execution->buffers[model->inputs[i]] = execution->inputs[i].data;
+    }
+    for (uint32_t i = 0; i < model->outputs.size(); i++) {
+        execution->buffers[model->outputs[i]] = execution->outputs[i].data;
+    }
+
+    const uint64_t hardwareStartNs = nowNs();
+    for (const auto& operation : model->operations) {
+        const int result =
+                host_nnapi::runOperation(operands, operation, execution->buffers.data());
+        if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    }
+    const uint64_t endNs = nowNs();
+
+    if (execution->measureTiming) {
+        std::lock_guard<std::mutex> lock(execution->mutex);
+        execution->durationOnHardware = endNs - hardwareStartNs;
+        execution->durationInDriver = endNs - driverStartNs;
+        if (fenced) {
+            execution->fencedDurationOnHardware = execution->durationOnHardware;
+            execution->fencedDurationInDriver = execution->durationInDriver;
+        }
+    }
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int computeSynchronously(ANeuralNetworksExecution* execution) {
+    NN_RETURN_IF(execution == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null execution");
+    const uint64_t startNs = nowNs();
+    int result = beginComputation(execution);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    result = runModel(execution, startNs, /*fenced=*/false);
+    endComputation(execution);
+    return result;
+}
+
+void signalEvent(ANeuralNetworksEvent* event, int result) {
+    {
+        std::lock_guard<std::mutex> lock(event->mutex);
+        event->signaled = true;
+        event->result = result;
+    }
+    event->condition.notify_all();
+}
+
+}  // namespace
+
+int64_t ANeuralNetworks_getRuntimeFeatureLevel() { return host_nnapi::kFeatureLevel; }
+
+// Device
+
+int ANeuralNetworks_getDeviceCount(uint32_t* numDevices) {
+    NN_RETURN_IF(numDevices == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null numDevices");
+    *numDevices = 1;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworks_getDevice(uint32_t devIndex, ANeuralNetworksDevice** device) {
+    NN_RETURN_IF(device == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null device");
+    NN_RETURN_IF(devIndex != 0, ANEURALNETWORKS_BAD_DATA, "Invalid device index %u", devIndex);
+    *device = const_cast<ANeuralNetworksDevice*>(&kDevice);
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksDevice_getName(const ANeuralNetworksDevice* device, const char** name) {
+    NN_RETURN_IF(device == nullptr || name == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null device or name");
+    *name = device->name;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksDevice_getType(const ANeuralNetworksDevice* device, int32_t* type) {
+    NN_RETURN_IF(device == nullptr || type == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null device or type");
+    *type = device->type;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksDevice_getVersion(const ANeuralNetworksDevice* device, const char** version) {
+    NN_RETURN_IF(device == nullptr || version == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null device or version");
+    *version = device->version;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksDevice_getFeatureLevel(const ANeuralNetworksDevice* device,
+                                          int64_t* featureLevel) {
+    NN_RETURN_IF(device == nullptr || featureLevel == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null device or feature level");
+    *featureLevel = device->featureLevel;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+namespace {
+
+int validateDevices(const ANeuralNetworksDevice* const* devices, uint32_t numDevices) {
+    NN_RETURN_IF(devices == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null devices");
+    NN_RETURN_IF(numDevices == 0, ANEURALNETWORKS_BAD_DATA, "No device");
+    for (uint32_t i = 0; i < numDevices; i++) {
+        NN_RETURN_IF(devices[i] != &kDevice, ANEURALNETWORKS_BAD_DATA, "Invalid device %u", i);
+    }
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+}  // namespace
+
+// Memory
+
+int ANeuralNetworksMemory_createFromFd(size_t size, int protect, int fd, size_t offset,
+                                       ANeuralNetworksMemory** memory) {
+    NN_RETURN_IF(memory == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null memory");
+    *memory = nullptr;
+    NN_RETURN_IF(size == 0 || fd < 0, ANEURALNETWORKS_BAD_DATA, "Invalid size or fd");
+    NN_RETURN_IF((protect & ~(PROT_READ | PROT_WRITE)) != 0, ANEURALNETWORKS_BAD_DATA,
+                 "Invalid protection %d", protect);
+    // mmap requires a page-aligned offset
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t alignedOffset = offset / pageSize * pageSize;
+    const size_t mappingSize = size + offset - alignedOffset;
+    void* mapping = mmap(nullptr, mappingSize, protect, MAP_SHARED, fd, alignedOffset);
+    NN_RETURN_IF(mapping == MAP_FAILED, ANEURALNETWORKS_UNMAPPABLE, "mmap failed: %s",
+                 strerror(errno));
+    auto* result = new ANeuralNetworksMemory;
+    result->data = static_cast<uint8_t*>(mapping) + (offset - alignedOffset);
+    result->size = size;
+    result->mapping = mapping;
+    result->mappingSize = mappingSize;
+    *memory = result;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksMemory_createFromAHardwareBuffer(const AHardwareBuffer* ahwb,
+                                                    ANeuralNetworksMemory** memory) {
+    NN_RETURN_IF(ahwb == nullptr || memory == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null AHardwareBuffer or memory");
+    *memory = nullptr;
+    AHardwareBuffer_Desc desc;
+    AHardwareBuffer_describe(ahwb, &desc);
+    NN_RETURN_IF(desc.format != AHARDWAREBUFFER_FORMAT_BLOB, ANEURALNETWORKS_BAD_DATA,
+                 "Only BLOB AHardwareBuffers are supported");
+    auto* buffer = const_cast<AHardwareBuffer*>(ahwb);
+    void* data = nullptr;
+    NN_RETURN_IF(AHardwareBuffer_lock(buffer,
+                                      AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN |
+                                              AHARDWAREBUFFER_USAGE_CPU_WRITE_OFTEN,
+                                      /*fence=*/-1, /*rect=*/nullptr, &data) != 0,
+                 ANEURALNETWORKS_UNMAPPABLE, "Failed to lock the AHardwareBuffer");
+    AHardwareBuffer_acquire(buffer);
+    auto* result = new ANeuralNetworksMemory;
+    result->data = static_cast<uint8_t*>(data);
+    result->size = desc.width;
+    result->hardwareBuffer = buffer;
+    *memory = result;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksMemory_createFromDesc(const ANeuralNetworksMemoryDesc* desc,
+                                         ANeuralNetworksMemory** memory) {
+    NN_RETURN_IF(desc == nullptr || memory == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null descriptor or memory");
+    *memory = nullptr;
+    NN_RETURN_IF(!desc->finished, ANEURALNETWORKS_BAD_STATE, "The descriptor is not finished");
+    auto* result = new ANeuralNetworksMemory;
+    result->deviceMemory.resize(desc->size);
+    result->data = result->deviceMemory.data();
+    result->size = desc->size;
+    result->isDeviceMemory = true;
+    *memory = result;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+void ANeuralNetworksMemory_free(ANeuralNetworksMemory* memory) {
+    if (memory == nullptr) return;
+    if (memory->mapping != nullptr) {
+        munmap(memory->mapping, memory->mappingSize);
+    }
+    if (memory->hardwareBuffer != nullptr) {
+        AHardwareBuffer_unlock(memory->hardwareBuffer, /*fence=*/nullptr);
+        AHardwareBuffer_release(memory->hardwareBuffer);
+    }
+    delete memory;
+}
+
+// Memory descriptor
+
+int ANeuralNetworksMemoryDesc_create(ANeuralNetworksMemoryDesc** desc) {
+    NN_RETURN_IF(desc == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null descriptor");
+    *desc = new ANeuralNetworksMemoryDesc;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+namespace {
+
+int addRole(ANeuralNetworksMemoryDesc* desc, const ANeuralNetworksCompilation* compilation,
+            bool isInput, uint32_t index, float frequency) {
+    NN_RETURN_IF(desc == nullptr || compilation == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null descriptor or compilation");
+    NN_RETURN_IF(desc->finished || !compilation->finished, ANEURALNETWORKS_BAD_STATE,
+                 "The descriptor is finished or the compilation is not");
+    NN_RETURN_IF(getIoOperand(compilation, isInput, index) == nullptr, ANEURALNETWORKS_BAD_DATA,
+                 "Invalid %s index %u", isInput ? "input" : "output", index);
+    NN_RETURN_IF(!(frequency > 0.0f && frequency <= 1.0f), ANEURALNETWORKS_BAD_DATA,
+                 "Invalid frequency %f", frequency);
+    desc->roles.push_back({.compilation = compilation, .isInput = isInput, .index = index});
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+}  // namespace
+
+int ANeuralNetworksMemoryDesc_addInputRole(ANeuralNetworksMemoryDesc* desc,
+                                           const ANeuralNetworksCompilation* compilation,
+                                           uint32_t index, float frequency) {
+    return addRole(desc, compilation, /*isInput=*/true, index, frequency);
+}
+
+int ANeuralNetworksMemoryDesc_addOutputRole(ANeuralNetworksMemoryDesc* desc,
+                                            const ANeuralNetworksCompilation* compilation,
+                                            uint32_t index, float frequency) {
+    return addRole(desc, compilation, /*isInput=*/false, index, frequency);
+}
+
+int ANeuralNetworksMemoryDesc_finish(ANeuralNetworksMemoryDesc* desc) {
+    NN_RETURN_IF(desc == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null descriptor");
+    NN_RETURN_IF(desc->finished, ANEURALNETWORKS_BAD_STATE, "The descriptor is finished");
+    NN_RETURN_IF(desc->roles.empty(), ANEURALNETWORKS_BAD_DATA, "The descriptor has no role");
+    const auto& first = desc->roles.front();
+    const Operand* operand = getIoOperand(first.compilation, first.isInput, first.index);
+    for (const auto& role : desc->roles) {
+        const Operand* other = getIoOperand(role.compilation, role.isInput, role.index);
+        NN_RETURN_IF(other->type != operand->type || other->dimensions != operand->dimensions,
+                     ANEURALNETWORKS_BAD_DATA, "The roles have incompatible operands");
+    }
+    desc->size = host_nnapi::byteSize(*operand);
+    NN_RETURN_IF(desc->size == 0, ANEURALNETWORKS_BAD_DATA,
+                 "The operands of the roles must be fully specified");
+    desc->finished = true;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+void ANeuralNetworksMemoryDesc_free(ANeuralNetworksMemoryDesc* desc) { delete desc; }
+
+// Model
+
+int ANeuralNetworksModel_create(ANeuralNetworksModel** model) {
+    NN_RETURN_IF(model == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null model");
+    *model = new ANeuralNetworksModel;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+void ANeuralNetworksModel_free(ANeuralNetworksModel* model) { delete model; }
+
+int ANeuralNetworksModel_addOperand(ANeuralNetworksModel* model,
+                                    const ANeuralNetworksOperandType* type) {
+    NN_RETURN_IF(model == nullptr || type == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null model or type");
+    NN_RETURN_IF(model->finished, ANEURALNETWORKS_BAD_STATE, "The model is finished");
+    NN_RETURN_IF(type->dimensionCount > 0 && type->dimensions == nullptr,
+                 ANEURALNETWORKS_UNEXPECTED_NULL, "Null dimensions");
+    model->operands.push_back({
+            .type = type->type,
+            .dimensions = Dimensions(type->dimensions, type->dimensions + type->dimensionCount),
+            .scale = type->scale,
+            .zeroPoint = type->zeroPoint,
+    });
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksModel_setOperandValue(ANeuralNetworksModel* model, int32_t index,
+                                         const void* buffer, size_t length) {
+    NN_RETURN_IF(model == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null model");
+    NN_RETURN_IF(model->finished, ANEURALNETWORKS_BAD_STATE, "The model is finished");
+    NN_RETURN_IF(index < 0 || static_cast<size_t>(index) >= model->operands.size(),
+                 ANEURALNETWORKS_BAD_DATA, "Invalid operand index %d", index);
+    Operand& operand = model->operands[index];
+    if (buffer == nullptr) {
+        NN_RETURN_IF(length != 0, ANEURALNETWORKS_UNEXPECTED_NULL, "Null buffer");
+        operand.lifetime = Operand::Lifetime::NO_VALUE;
+        return ANEURALNETWORKS_NO_ERROR;
+    }
+    NN_RETURN_IF(length != host_nnapi::byteSize(operand), ANEURALNETWORKS_BAD_DATA,
+                 "Invalid length %zu of operand %d", length, index);
+    operand.lifetime = Operand::Lifetime::CONSTANT;
+    operand.length = length;
+    if (length <= ANEURALNETWORKS_MAX_SIZE_OF_IMMEDIATELY_COPIED_VALUES) {
+        const auto* bytes = static_cast<const uint8_t*>(buffer);
+        operand.value = model->copiedValues.emplace_back(bytes, bytes + length).data();
+    } else {
+        // Larger values are referenced, the application keeps the buffer alive
+        operand.value = static_cast<const uint8_t*>(buffer);
+    }
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksModel_setOperandValueFromMemory(ANeuralNetworksModel* model, int32_t index,
+                                                   const ANeuralNetworksMemory* memory,
+                                                   size_t offset, size_t length) {
+    NN_RETURN_IF(model == nullptr || memory == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null model or memory");
+    NN_RETURN_IF(model->finished, ANEURALNETWORKS_BAD_STATE, "The model is finished");
+    NN_RETURN_IF(index < 0 || static_cast<size_t>(index) >= model->operands.size(),
+                 ANEURALNETWORKS_BAD_DATA, "Invalid operand index %d", index);
+    NN_RETURN_IF(memory->isDeviceMemory, ANEURALNETWORKS_BAD_DATA,
+                 "A memory created from a descriptor cannot hold constants");
+    NN_RETURN_IF(offset + length > memory->size, ANEURALNETWORKS_BAD_DATA,
+                 "The value exceeds the memory");
+    Operand& operand = model->operands[index];
+    NN_RETURN_IF(length != host_nnapi::byteSize(operand), ANEURALNETWORKS_BAD_DATA,
+                 "Invalid length %zu of operand %d", length, index);
+    operand.lifetime = Operand::Lifetime::CONSTANT;
+    operand.value = memory->data + offset;
+    operand.length = length;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksModel_addOperation(ANeuralNetworksModel* model,
+                                      ANeuralNetworksOperationType type, uint32_t inputCount,
+                                      const uint32_t* inputs, uint32_t outputCount,
+                                      const uint32_t* outputs) {
+    NN_RETURN_IF(model == nullptr || (inputCount > 0 && inputs == nullptr) ||
+                         (outputCount > 0 && outputs == nullptr),
+                 ANEURALNETWORKS_UNEXPECTED_NULL, "Null model, inputs or outputs");
+    NN_RETURN_IF(model->finished, ANEURALNETWORKS_BAD_STATE, "The model is finished");
+    Operation operation = {
+            .type = type,
+            .inputs = std::vector<uint32_t>(inputs, inputs + inputCount),
+            .outputs = std::vector<uint32_t>(outputs, outputs + outputCount),
+    };
+    for (const auto* indexes : {&operation.inputs, &operation.outputs}) {
+        for (uint32_t index : *indexes) {
+            NN_RETURN_IF(index >= model->operands.size(), ANEURALNETWORKS_BAD_DATA,
+                         "Invalid operand index %u", index);
+        }
+    }
+    const int result = host_nnapi::validateOperationSignature(model->operands, operation);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    model->operations.push_back(std::move(operation));
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksModel_identifyInputsAndOutputs(ANeuralNetworksModel* model,
+                                                  uint32_t inputCount, const uint32_t* inputs,
+                                                  uint32_t outputCount, const uint32_t* outputs) {
+    NN_RETURN_IF(model == nullptr || (inputCount > 0 && inputs == nullptr) ||
+                         (outputCount > 0 && outputs == nullptr),
+                 ANEURALNETWORKS_UNEXPECTED_NULL, "Null model, inputs or outputs");
+    NN_RETURN_IF(model->finished || model->inputsAndOutputsIdentified, ANEURALNETWORKS_BAD_STATE,
+                 "The model is finished or its inputs and outputs are identified");
+    auto identify = [model](const uint32_t* indexes, uint32_t count, Operand::Lifetime lifetime,
+                            std::vector<uint32_t>* result) -> int {
+        for (uint32_t i = 0; i < count; i++) {
+            NN_RETURN_IF(indexes[i] >= model->operands.size(), ANEURALNETWORKS_BAD_DATA,
+                         "Invalid operand index %u", indexes[i]);
+            Operand& operand = model->operands[indexes[i]];
+            NN_RETURN_IF(operand.lifetime != Operand::Lifetime::TEMPORARY,
+                         ANEURALNETWORKS_BAD_DATA,
+                         "Operand %u is a constant or already a model input or output",
+                         indexes[i]);
+            operand.lifetime = lifetime;
+        }
+        result->assign(indexes, indexes + count);
+        return ANEURALNETWORKS_NO_ERROR;
+    };
+    int result = identify(inputs, inputCount, Operand::Lifetime::MODEL_INPUT, &model->inputs);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    result = identify(outputs, outputCount, Operand::Lifetime::MODEL_OUTPUT, &model->outputs);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    model->inputsAndOutputsIdentified = true;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksModel_relaxComputationFloat32toFloat16(ANeuralNetworksModel* model, bool allow) {
+    NN_RETURN_IF(model == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null model");
+    NN_RETURN_IF(model->finished, ANEURALNETWORKS_BAD_STATE, "The model is finished");
+    // Relaxed computation is allowed, not required: the host NNAPI always computes in float32
+    model->relaxComputationFloat32toFloat16 = allow;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksModel_finish(ANeuralNetworksModel* model) {
+    NN_RETURN_IF(model == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null model");
+    NN_RETURN_IF(model->finished, ANEURALNETWORKS_BAD_STATE, "The model is finished");
+    NN_RETURN_IF(!model->inputsAndOutputsIdentified || model->outputs.empty(),
+                 ANEURALNETWORKS_BAD_DATA, "The model inputs and outputs are not identified");
+    int result = sortIntoRunOrder(model);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    for (auto& operation : model->operations) {
+        result = host_nnapi::prepareOperation(model->operands, &operation);
+        if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    }
+    model->finished = true;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksModel_getSupportedOperationsForDevices(
+        const ANeuralNetworksModel* model, const ANeuralNetworksDevice* const* devices,
+        uint32_t numDevices, bool* supportedOps) {
+    NN_RETURN_IF(model == nullptr || supportedOps == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null model or supportedOps");
+    NN_RETURN_IF(!model->finished, ANEURALNETWORKS_BAD_STATE, "The model is not finished");
+    const int result = validateDevices(devices, numDevices);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    // The operations were validated as they were added, the device supports all of them
+    std::fill(supportedOps, supportedOps + model->operations.size(), true);
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+// Compilation
+
+int ANeuralNetworksCompilation_create(ANeuralNetworksModel* model,
+                                      ANeuralNetworksCompilation** compilation) {
+    NN_RETURN_IF(model == nullptr || compilation == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null model or compilation");
+    *compilation = nullptr;
+    NN_RETURN_IF(!model->finished, ANEURALNETWORKS_BAD_STATE, "The model is not finished");
+    *compilation = new ANeuralNetworksCompilation{.model = model};
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksCompilation_createForDevices(ANeuralNetworksModel* model,
+                                                const ANeuralNetworksDevice* const* devices,
+                                                uint32_t numDevices,
+                                                ANeuralNetworksCompilation** compilation) {
+    NN_RETURN_IF(compilation == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null compilation");
+    *compilation = nullptr;
+    int result = validateDevices(devices, numDevices);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    result = ANeuralNetworksCompilation_create(model, compilation);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+    // Only a compilation for a single device may measure the timing of its executions
+    if (numDevices == 1) (*compilation)->device = devices[0];
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+void ANeuralNetworksCompilation_free(ANeuralNetworksCompilation* compilation) {
+    delete compilation;
+}
+
+int ANeuralNetworksCompilation_setPreference(ANeuralNetworksCompilation* compilation,
+                                             int32_t preference) {
+    NN_RETURN_IF(compilation == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null compilation");
+    NN_RETURN_IF(compilation->finished, ANEURALNETWORKS_BAD_STATE, "The compilation is finished");
+    NN_RETURN_IF(preference < ANEURALNETWORKS_PREFER_LOW_POWER ||
+                         preference > ANEURALNETWORKS_PREFER_SUSTAINED_SPEED,
+                 ANEURALNETWORKS_BAD_DATA, "Invalid preference %d", preference);
+    compilation->preference = preference;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksCompilation_setCaching(ANeuralNetworksCompilation* compilation,
+                                          const char* cacheDir, const uint8_t* token) {
+    NN_RETURN_IF(compilation == nullptr || cacheDir == nullptr || token == nullptr,
+                 ANEURALNETWORKS_UNEXPECTED_NULL, "Null compilation, cache directory or token");
+    NN_RETURN_IF(compilation->finished, ANEURALNETWORKS_BAD_STATE, "The compilation is finished");
+    // There is nothing worth caching on the host, the directory is only recorded
+    compilation->cacheDir = cacheDir;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksCompilation_finish(ANeuralNetworksCompilation* compilation) {
+    NN_RETURN_IF(compilation == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null compilation");
+    NN_RETURN_IF(compilation->finished, ANEURALNETWORKS_BAD_STATE, "The compilation is finished");
+    compilation->finished = true;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+namespace {
+
+int getPreferredMemoryValue(const ANeuralNetworksCompilation* compilation, bool isInput,
+                            uint32_t index, uint32_t value, uint32_t* result) {
+    NN_RETURN_IF(compilation == nullptr || result == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null compilation or result");
+    NN_RETURN_IF(!compilation->finished, ANEURALNETWORKS_BAD_STATE,
+                 "The compilation is not finished");
+    NN_RETURN_IF(getIoOperand(compilation, isInput, index) == nullptr, ANEURALNETWORKS_BAD_DATA,
+                 "Invalid %s index %u", isInput ? "input" : "output", index);
+    *result = value;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+}  // namespace
+
+int ANeuralNetworksCompilation_getPreferredMemoryAlignmentForInput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* alignment) {
+    return getPreferredMemoryValue(compilation, /*isInput=*/true, index,
+                                   host_nnapi::kPreferredMemoryAlignment, alignment);
+}
+
+int ANeuralNetworksCompilation_getPreferredMemoryPaddingForInput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* padding) {
+    return getPreferredMemoryValue(compilation, /*isInput=*/true, index,
+                                   host_nnapi::kPreferredMemoryPadding, padding);
+}
+
+int ANeuralNetworksCompilation_getPreferredMemoryAlignmentForOutput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* alignment) {
+    return getPreferredMemoryValue(compilation, /*isInput=*/false, index,
+                                   host_nnapi::kPreferredMemoryAlignment, alignment);
+}
+
+int ANeuralNetworksCompilation_getPreferredMemoryPaddingForOutput(
+        const ANeuralNetworksCompilation* compilation, uint32_t index, uint32_t* padding) {
+    return getPreferredMemoryValue(compilation, /*isInput=*/false, index,
+                                   host_nnapi::kPreferredMemoryPadding, padding);
+}
+
+// Burst
+
+int ANeuralNetworksBurst_create(ANeuralNetworksCompilation* compilation,
+                                ANeuralNetworksBurst** burst) {
+    NN_RETURN_IF(compilation == nullptr || burst == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null compilation or burst");
+    *burst = nullptr;
+    NN_RETURN_IF(!compilation->finished, ANEURALNETWORKS_BAD_STATE,
+                 "The compilation is not finished");
+    *burst = new ANeuralNetworksBurst{.compilation = compilation};
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+void ANeuralNetworksBurst_free(ANeuralNetworksBurst* burst) { delete burst; }
+
+// Execution
+
+int ANeuralNetworksExecution_create(ANeuralNetworksCompilation* compilation,
+                                    ANeuralNetworksExecution** execution) {
+    NN_RETURN_IF(compilation == nullptr || execution == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null compilation or execution");
+    *execution = nullptr;
+    NN_RETURN_IF(!compilation->finished, ANEURALNETWORKS_BAD_STATE,
+                 "The compilation is not finished");
+    auto* result = new ANeuralNetworksExecution;
+    result->compilation = compilation;
+    result->inputs.resize(compilation->model->inputs.size());
+    result->outputs.resize(compilation->model->outputs.size());
+    *execution = result;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+void ANeuralNetworksExecution_free(ANeuralNetworksExecution* execution) {
+    if (execution == nullptr) return;
+    {
+        // An execution freed while computing is deleted by its computation thread
+        std::lock_guard<std::mutex> lock(execution->mutex);
+        if (execution->state == ANeuralNetworksExecution::State::COMPUTATION) {
+            execution->freeRequested = true;
+            return;
+        }
+    }
+    delete execution;
+}
+
+int ANeuralNetworksExecution_setReusable(ANeuralNetworksExecution* execution, bool reusable) {
+    NN_RETURN_IF(execution == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null execution");
+    std::lock_guard<std::mutex> lock(execution->mutex);
+    NN_RETURN_IF(execution->state != ANeuralNetworksExecution::State::PREPARATION,
+                 ANEURALNETWORKS_BAD_STATE, "The execution has already started");
+    execution->reusable = reusable;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksExecution_enableInputAndOutputPadding(ANeuralNetworksExecution* execution,
+                                                         bool enable) {
+    NN_RETURN_IF(execution == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null execution");
+    std::lock_guard<std::mutex> lock(execution->mutex);
+    NN_RETURN_IF(execution->state != ANeuralNetworksExecution::State::PREPARATION ||
+                         execution->anyArgumentSet,
+                 ANEURALNETWORKS_BAD_STATE,
+                 "Padding must be enabled before any input or output is set");
+    execution->paddingEnabled = enable;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksExecution_setInput(ANeuralNetworksExecution* execution, int32_t index,
+                                      const ANeuralNetworksOperandType* type, const void* buffer,
+                                      size_t length) {
+    return setArgument(execution, /*isInput=*/true, index, type, /*memory=*/nullptr, buffer,
+                       /*offset=*/0, length);
+}
+
+int ANeuralNetworksExecution_setInputFromMemory(ANeuralNetworksExecution* execution,
+                                                int32_t index,
+                                                const ANeuralNetworksOperandType* type,
+                                                const ANeuralNetworksMemory* memory,
+                                                size_t offset, size_t length) {
+    NN_RETURN_IF(memory == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null memory");
+    return setArgument(execution, /*isInput=*/true, index, type, memory, /*buffer=*/nullptr,
+                       offset, length);
+}
+
+int ANeuralNetworksExecution_setOutput(ANeuralNetworksExecution* execution, int32_t index,
+                                       const ANeuralNetworksOperandType* type, void* buffer,
+                                       size_t length) {
+    return setArgument(execution, /*isInput=*/false, index, type, /*memory=*/nullptr, buffer,
+                       /*offset=*/0, length);
+}
+
+int ANeuralNetworksExecution_setOutputFromMemory(ANeuralNetworksExecution* execution,
+                                                 int32_t index,
+                                                 const ANeuralNetworksOperandType* type,
+                                                 const ANeuralNetworksMemory* memory,
+                                                 size_t offset, size_t length) {
+    NN_RETURN_IF(memory == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null memory");
+    return setArgument(execution, /*isInput=*/false, index, type, memory, /*buffer=*/nullptr,
+                       offset, length);
+}
+
+int ANeuralNetworksExecution_setMeasureTiming(ANeuralNetworksExecution* execution, bool measure) {
+    NN_RETURN_IF(execution == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null execution");
+    NN_RETURN_IF(execution->compilation->device == nullptr, ANEURALNETWORKS_BAD_DATA,
+                 "The compilation is not for a single device");
+    std::lock_guard<std::mutex> lock(execution->mutex);
+    NN_RETURN_IF(execution->state != ANeuralNetworksExecution::State::PREPARATION,
+                 ANEURALNETWORKS_BAD_STATE, "The execution has already started");
+    execution->measureTiming = measure;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksExecution_getDuration(const ANeuralNetworksExecution* execution,
+                                         int32_t durationCode, uint64_t* duration) {
+    NN_RETURN_IF(execution == nullptr || duration == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null execution or duration");
+    std::lock_guard<std::mutex> lock(execution->mutex);
+    NN_RETURN_IF(execution->state != ANeuralNetworksExecution::State::COMPLETED,
+                 ANEURALNETWORKS_BAD_STATE, "The execution has not completed");
+    switch (durationCode) {
+        case ANEURALNETWORKS_DURATION_ON_HARDWARE:
+            *duration = execution->durationOnHardware;
+            break;
+        case ANEURALNETWORKS_DURATION_IN_DRIVER:
+            *duration = execution->durationInDriver;
+            break;
+        case ANEURALNETWORKS_FENCED_DURATION_ON_HARDWARE:
+            *duration = execution->fencedDurationOnHardware;
+            break;
+        case ANEURALNETWORKS_FENCED_DURATION_IN_DRIVER:
+            *duration = execution->fencedDurationInDriver;
+            break;
+        default:
+            NN_LOGE("Invalid duration code %d", durationCode);
+            return ANEURALNETWORKS_BAD_DATA;
+    }
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksExecution_compute(ANeuralNetworksExecution* execution) {
+    return computeSynchronously(execution);
+}
+
+int ANeuralNetworksExecution_burstCompute(ANeuralNetworksExecution* execution,
+                                          ANeuralNetworksBurst* burst) {
+    NN_RETURN_IF(execution == nullptr || burst == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL,
+                 "Null execution or burst");
+    NN_RETURN_IF(burst->compilation != execution->compilation, ANEURALNETWORKS_BAD_DATA,
+                 "The burst and the execution belong to different compilations");
+    return computeSynchronously(execution);
+}
+
+namespace {
+
+// Starts an asynchronous computation after its dependencies. Only the computations started with
+// ANeuralNetworksExecution_startComputeWithDependencies are fenced, even without dependencies.
+int startComputation(ANeuralNetworksExecution* execution,
+                     const ANeuralNetworksEvent* const* dependencies, uint32_t num_dependencies,
+                     bool fenced, ANeuralNetworksEvent** event) {
+    NN_RETURN_IF(execution == nullptr || event == nullptr ||
+                         (num_dependencies > 0 && dependencies == nullptr),
+                 ANEURALNETWORKS_UNEXPECTED_NULL, "Null execution, dependencies or event");
+    *event = nullptr;
+    const int result = beginComputation(execution);
+    if (result != ANEURALNETWORKS_NO_ERROR) return result;
+
+    // The dependencies are waited on the computation thread, so that this call does not block.
+    // The timeout duration is not enforced.
+    auto* finished = new ANeuralNetworksEvent;
+    std::vector<ANeuralNetworksEvent*> waitFor(num_dependencies);
+    for (uint32_t i = 0; i < num_dependencies; i++) {
+        waitFor[i] = const_cast<ANeuralNetworksEvent*>(dependencies[i]);
+    }
+    finished->worker = std::thread([execution, finished, fenced, waitFor = std::move(waitFor)] {
+        int result = ANEURALNETWORKS_NO_ERROR;
+        for (ANeuralNetworksEvent* dependency : waitFor) {
+            if (result == ANEURALNETWORKS_NO_ERROR) result = ANeuralNetworksEvent_wait(dependency);
+        }
+        if (result == ANEURALNETWORKS_NO_ERROR) result = runModel(execution, nowNs(), fenced);
+        endComputation(execution);
+        signalEvent(finished, result);
+    });
+    *event = finished;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+}  // namespace
+
+int ANeuralNetworksExecution_startComputeWithDependencies(
+        ANeuralNetworksExecution* execution, const ANeuralNetworksEvent* const* dependencies,
+        uint32_t num_dependencies, uint64_t /*duration*/, ANeuralNetworksEvent** event) {
+    return startComputation(execution, dependencies, num_dependencies, /*fenced=*/true, event);
+}
+
+int ANeuralNetworksExecution_startCompute(ANeuralNetworksExecution* execution,
+                                          ANeuralNetworksEvent** event) {
+    return startComputation(execution, /*dependencies=*/nullptr, /*num_dependencies=*/0,
+                            /*fenced=*/false, event);
+}
+
+// Event
+
+int ANeuralNetworksEvent_createFromSyncFenceFd(int sync_fence_fd, ANeuralNetworksEvent** event) {
+    NN_RETURN_IF(event == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null event");
+    *event = nullptr;
+    NN_RETURN_IF(sync_fence_fd < 0, ANEURALNETWORKS_BAD_DATA, "Invalid sync fence");
+    const int fd = dup(sync_fence_fd);
+    NN_RETURN_IF(fd < 0, ANEURALNETWORKS_BAD_DATA, "Failed to duplicate the sync fence");
+    auto* result = new ANeuralNetworksEvent;
+    result->syncFenceFd = fd;
+    *event = result;
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int ANeuralNetworksEvent_wait(ANeuralNetworksEvent* event) {
+    NN_RETURN_IF(event == nullptr, ANEURALNETWORKS_UNEXPECTED_NULL, "Null event");
+    if (event->syncFenceFd >= 0) {
+        // A sync fence, or any other pollable fd, signals by becoming readable
+        pollfd fd = {.fd = event->syncFenceFd, .events = POLLIN};
+        int result;
+        while ((result = poll(&fd, 1, -1)) < 0 && errno == EINTR) {
+        }
+        return result > 0 && (fd.revents & POLLERR) == 0 ? ANEURALNETWORKS_NO_ERROR
+                                                          : ANEURALNETWORKS_OP_FAILED;
+    }
+    std::unique_lock<std::mutex> lock(event->mutex);
+    event->condition.wait(lock, [event] { return event->signaled; });
+    return event->result;
+}
+
+void ANeuralNetworksEvent_free(ANeuralNetworksEvent* event) {
+    if (event == nullptr) return;
+    if (event->worker.joinable()) {
+        event->worker.join();
+    }
+    if (event->syncFenceFd >= 0) {
+        close(event->syncFenceFd);
+    }
+    delete event;
+}
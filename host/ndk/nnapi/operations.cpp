@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The operations supported by the host NNAPI: ADD, MUL, CONV_2D and DEPTHWISE_CONV_2D on
+// TENSOR_FLOAT32, CONV_2D and DEPTHWISE_CONV_2D on TENSOR_QUANT8_ASYMM, with NHWC layout only, and
+// CAST between TENSOR_FLOAT16 and TENSOR_FLOAT32
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "kernels.h"
+#include "runtime.h"
+
+namespace host_nnapi {
+namespace {
+
+uint32_t elementSize(int32_t type) {
+    switch (type) {
+        case ANEURALNETWORKS_TENSOR_QUANT8_ASYMM:
+        case ANEURALNETWORKS_BOOL:
+        case ANEURALNETWORKS_TENSOR_BOOL8:
+        case ANEURALNETWORKS_TENSOR_QUANT8_SYMM_PER_CHANNEL:
+        case ANEURALNETWORKS_TENSOR_QUANT8_SYMM:
+        case ANEURALNETWORKS_TENSOR_QUANT8_ASYMM_SIGNED:
+            return 1;
+        case ANEURALNETWORKS_TENSOR_QUANT16_SYMM:
+        case ANEURALNETWORKS_TENSOR_FLOAT16:
+        case ANEURALNETWORKS_FLOAT16:
+        case ANEURALNETWORKS_TENSOR_QUANT16_ASYMM:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+bool isScalar(int32_t type) {
+    return type == ANEURALNETWORKS_FLOAT32 || type == ANEURALNETWORKS_INT32 ||
+           type == ANEURALNETWORKS_UINT32 || type == ANEURALNETWORKS_BOOL ||
+           type == ANEURALNETWORKS_FLOAT16;
+}
+
+// The position of the parameters in the inputs of CONV_2D and DEPTHWISE_CONV_2D, following the
+// input, filter and bias tensors:
+//   implicit padding: padding scheme, stride w, h, [depth multiplier], activation,
+//                     [layout, [dilation w, h]]
+//   explicit padding: padding left, right, top, bottom, stride w, h, [depth multiplier],
+//                     activation, [layout, [dilation w, h]]
+struct ConvolutionSignature {
+    bool implicitPadding;
+    // The number of inputs up to the activation
+    uint32_t requiredInputs;
+};
+
+bool getConvolutionSignature(const std::vector<Operand>& operands, const Operation& operation,
+                             ConvolutionSignature* signature) {
+    const bool depthwise = operation.type == ANEURALNETWORKS_DEPTHWISE_CONV_2D;
+    const uint32_t implicitInputs = depthwise ? 8 : 7;
+    const uint32_t explicitInputs = implicitInputs + 3;
+    const uint32_t count = operation.inputs.size();
+    // With 10 (or 11) inputs, the signatures differ in the type of the input after the activation
+    // of the implicit padding signature: the layout, or a stride
+    if (count == implicitInputs || count == implicitInputs + 1 ||
+        (count == implicitInputs + 3 &&
+         operands[operation.inputs[implicitInputs]].type == ANEURALNETWORKS_BOOL)) {
+        *signature = {.implicitPadding = true, .requiredInputs = implicitInputs};
+        return true;
+    }
+    if (count == explicitInputs || count == explicitInputs + 1 || count == explicitInputs + 3) {
+        *signature = {.implicitPadding = false, .requiredInputs = explicitInputs};
+        return true;
+    }
+    return false;
+}
+
+int32_t readInt32(const Operand& operand) {
+    int32_t value;
+    std::memcpy(&value, operand.value, sizeof(value));
+    return value;
+}
+
+bool isConstantScalar(const Operand& operand, int32_t type) {
+    return operand.type == type && operand.lifetime == Operand::Lifetime::CONSTANT &&
+           operand.length == elementSize(type);
+}
+
+// Aligns the dimensions to the right, a dimension of 1 is broadcast to the other one
+bool broadcastDimensions(const Dimensions& a, const Dimensions& b, Dimensions* result) {
+    const Dimensions& longer = a.size() >= b.size() ? a : b;
+    const Dimensions& shorter = a.size() >= b.size() ? b : a;
+    *result = longer;
+    const uint32_t offset = longer.size() - shorter.size();
+    for (uint32_t i = 0; i < shorter.size(); i++) {
+        const uint32_t x = longer[offset + i], y = shorter[i];
+        if (x != y && x != 1 && y != 1) return false;
+        (*result)[offset + i] = std::max(x, y);
+    }
+    return true;
+}
+
+// The output size and the padding before the input along one spatial dimension
+bool computeImplicitPadding(int32_t scheme, uint32_t inputSize, uint32_t stride,
+                            uint32_t effectiveFilterSize, uint32_t* paddingHead,
+                            uint32_t* paddingTail) {
+    if (scheme == ANEURALNETWORKS_PADDING_VALID) {
+        *paddingHead = *paddingTail = 0;
+        return true;
+    }
+    if (scheme != ANEURALNETWORKS_PADDING_SAME) return false;
+    const uint32_t outputSize = (inputSize + stride - 1) / stride;
+    const int64_t needed = static_cast<int64_t>(outputSize - 1) * stride + effectiveFilterSize;
+    const uint32_t total = std::max<int64_t>(needed - inputSize, 0);
+    *paddingHead = total / 2;
+    *paddingTail = total - total / 2;
+    return true;
+}
+
+bool isQuant8(const Operand& operand) {
+    return operand.type == ANEURALNETWORKS_TENSOR_QUANT8_ASYMM;
+}
+
+int prepareConvolution(const std::vector<Operand>& operands, Operation* operation) {
+    const bool depthwise = operation->type == ANEURALNETWORKS_DEPTHWISE_CONV_2D;
+    const char* name = depthwise ? "DEPTHWISE_CONV_2D" : "CONV_2D";
+    ConvolutionSignature signature;
+    NN_RETURN_IF(!getConvolutionSignature(operands, *operation, &signature),
+                 ANEURALNETWORKS_BAD_DATA, "%s: unexpected number of inputs", name);
+    const auto& inputs = operation->inputs;
+    for (uint32_t i = 3; i < inputs.size(); i++) {
+        NN_RETURN_IF(!isConstantScalar(operands[inputs[i]], operands[inputs[i]].type),
+                     ANEURALNETWORKS_BAD_DATA, "%s: input %u must be a constant", name, i);
+    }
+    if (isQuant8(operands[inputs[0]])) {
+        // NNAPI requires the bias scale to be the product of the input and filter scales
+        const float expectedBiasScale = operands[inputs[0]].scale * operands[inputs[1]].scale;
+        NN_RETURN_IF(std::abs(operands[inputs[2]].scale - expectedBiasScale) >
+                                     1e-6f * expectedBiasScale ||
+                             operands[inputs[2]].zeroPoint != 0,
+                     ANEURALNETWORKS_BAD_DATA, "%s: unexpected bias quantization", name);
+    }
+
+    const Dimensions& input = operands[inputs[0]].dimensions;
+    const Dimensions& filter = operands[inputs[1]].dimensions;
+    const Dimensions& bias = operands[inputs[2]].dimensions;
+    NN_RETURN_IF(input.size() != 4 || filter.size() != 4 || bias.size() != 1,
+                 ANEURALNETWORKS_BAD_DATA, "%s: unexpected tensor ranks", name);
+
+    ConvolutionParams& params = operation->params;
+    uint32_t p = 3;
+    int32_t paddingScheme = 0;
+    if (signature.implicitPadding) {
+        paddingScheme = readInt32(operands[inputs[p++]]);
+    } else {
+        params.paddingLeft = readInt32(operands[inputs[p++]]);
+        params.paddingRight = readInt32(operands[inputs[p++]]);
+        params.paddingTop = readInt32(operands[inputs[p++]]);
+        params.paddingBottom = readInt32(operands[inputs[p++]]);
+    }
+    params.strideWidth = readInt32(operands[inputs[p++]]);
+    params.strideHeight = readInt32(operands[inputs[p++]]);
+    if (depthwise) params.depthMultiplier = readInt32(operands[inputs[p++]]);
+    params.activation = readInt32(operands[inputs[p++]]);
+    if (p < inputs.size()) {
+        NN_RETURN_IF(*operands[inputs[p++]].value != 0, ANEURALNETWORKS_BAD_DATA,
+                     "%s: only the NHWC layout is supported", name);
+    }
+    if (p < inputs.size()) {
+        params.dilationWidth = readInt32(operands[inputs[p++]]);
+        params.dilationHeight = readInt32(operands[inputs[p++]]);
+    }
+    NN_RETURN_IF(static_cast<int32_t>(params.strideWidth) < 1 ||
+                         static_cast<int32_t>(params.strideHeight) < 1 ||
+                         static_cast<int32_t>(params.dilationWidth) < 1 ||
+                         static_cast<int32_t>(params.dilationHeight) < 1 ||
+                         static_cast<int32_t>(params.depthMultiplier) < 1 ||
+                         static_cast<int32_t>(params.paddingLeft) < 0 ||
+                         static_cast<int32_t>(params.paddingRight) < 0 ||
+                         static_cast<int32_t>(params.paddingTop) < 0 ||
+                         static_cast<int32_t>(params.paddingBottom) < 0,
+                 ANEURALNETWORKS_BAD_DATA, "%s: invalid parameters", name);
+    NN_RETURN_IF(params.activation < ANEURALNETWORKS_FUSED_NONE ||
+                         params.activation > ANEURALNETWORKS_FUSED_RELU6,
+                 ANEURALNETWORKS_BAD_DATA, "%s: invalid activation %d", name, params.activation);
+
+    const uint32_t effectiveFilterHeight = (filter[1] - 1) * params.dilationHeight + 1;
+    const uint32_t effectiveFilterWidth = (filter[2] - 1) * params.dilationWidth + 1;
+    if (signature.implicitPadding) {
+        NN_RETURN_IF(!computeImplicitPadding(paddingScheme, input[1], params.strideHeight,
+                                             effectiveFilterHeight, &params.paddingTop,
+                                             &params.paddingBottom) ||
+                             !computeImplicitPadding(paddingScheme, input[2], params.strideWidth,
+                                                     effectiveFilterWidth, &params.paddingLeft,
+                                                     &params.paddingRight),
+                     ANEURALNETWORKS_BAD_DATA, "%s: invalid padding scheme %d", name,
+                     paddingScheme);
+    }
+
+    const uint32_t paddedHeight = input[1] + params.paddingTop + params.paddingBottom;
+    const uint32_t paddedWidth = input[2] + params.paddingLeft + params.paddingRight;
+    NN_RETURN_IF(paddedHeight < effectiveFilterHeight || paddedWidth < effectiveFilterWidth,
+                 ANEURALNETWORKS_BAD_DATA, "%s: the filter is larger than the input", name);
+    const uint32_t outputDepth = depthwise ? filter[3] : filter[0];
+    if (depthwise) {
+        NN_RETURN_IF(filter[0] != 1 || filter[3] != input[3] * params.depthMultiplier,
+                     ANEURALNETWORKS_BAD_DATA, "%s: unexpected filter shape", name);
+    } else {
+        NN_RETURN_IF(filter[3] != input[3], ANEURALNETWORKS_BAD_DATA,
+                     "%s: unexpected filter shape", name);
+    }
+    NN_RETURN_IF(bias[0] != outputDepth, ANEURALNETWORKS_BAD_DATA, "%s: unexpected bias shape",
+                 name);
+
+    const Dimensions expected = {
+            input[0],
+            (paddedHeight - effectiveFilterHeight) / params.strideHeight + 1,
+            (paddedWidth - effectiveFilterWidth) / params.strideWidth + 1,
+            outputDepth,
+    };
+    NN_RETURN_IF(operands[operation->outputs[0]].dimensions != expected, ANEURALNETWORKS_BAD_DATA,
+                 "%s: unexpected output shape", name);
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int prepareBinary(const std::vector<Operand>& operands, Operation* operation) {
+    const auto& inputs = operation->inputs;
+    NN_RETURN_IF(!isConstantScalar(operands[inputs[2]], ANEURALNETWORKS_INT32),
+                 ANEURALNETWORKS_BAD_DATA, "The activation must be a constant");
+    operation->params.activation = readInt32(operands[inputs[2]]);
+    NN_RETURN_IF(operation->params.activation < ANEURALNETWORKS_FUSED_NONE ||
+                         operation->params.activation > ANEURALNETWORKS_FUSED_RELU6,
+                 ANEURALNETWORKS_BAD_DATA, "Invalid activation %d", operation->params.activation);
+
+    Dimensions expected;
+    NN_RETURN_IF(!broadcastDimensions(operands[inputs[0]].dimensions,
+                                      operands[inputs[1]].dimensions, &expected),
+                 ANEURALNETWORKS_BAD_DATA, "The input shapes cannot be broadcast");
+    NN_RETURN_IF(operands[operation->outputs[0]].dimensions != expected, ANEURALNETWORKS_BAD_DATA,
+                 "Unexpected output shape");
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int prepareCast(const std::vector<Operand>& operands, Operation* operation) {
+    NN_RETURN_IF(operands[operation->outputs[0]].dimensions !=
+                         operands[operation->inputs[0]].dimensions,
+                 ANEURALNETWORKS_BAD_DATA, "CAST: unexpected output shape");
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+std::vector<float> dequantize(const Operand& operand, const uint8_t* buffer) {
+    std::vector<float> values(byteSize(operand) / elementSize(operand.type));
+    for (size_t i = 0; i < values.size(); i++) {
+        if (operand.type == ANEURALNETWORKS_TENSOR_INT32) {
+            int32_t value;
+            std::memcpy(&value, buffer + i * sizeof(value), sizeof(value));
+            values[i] = operand.scale * value;
+        } else {
+            values[i] = operand.scale * (static_cast<int32_t>(buffer[i]) - operand.zeroPoint);
+        }
+    }
+    return values;
+}
+
+// The quantized convolutions dequantize their operands and requantize the result of the float
+// kernels. Unlike the integer arithmetic of the NNAPI reference, this does not round the
+// intermediate sums, so the outputs may differ by one quantization step.
+int runQuant8Convolution(const std::vector<Operand>& operands, const Operation& operation,
+                         uint8_t* const* buffers) {
+    const auto& inputs = operation.inputs;
+    const std::vector<float> input = dequantize(operands[inputs[0]], buffers[inputs[0]]);
+    const std::vector<float> filter = dequantize(operands[inputs[1]], buffers[inputs[1]]);
+    const std::vector<float> bias = dequantize(operands[inputs[2]], buffers[inputs[2]]);
+    const Operand& outputOperand = operands[operation.outputs[0]];
+    std::vector<float> output(byteSize(outputOperand));  // One byte per element
+    if (operation.type == ANEURALNETWORKS_CONV_2D) {
+        conv2dFloat32(input.data(), operands[inputs[0]].dimensions, filter.data(),
+                      operands[inputs[1]].dimensions, bias.data(), operation.params, output.data(),
+                      outputOperand.dimensions);
+    } else {
+        depthwiseConv2dFloat32(input.data(), operands[inputs[0]].dimensions, filter.data(),
+                               operands[inputs[1]].dimensions, bias.data(), operation.params,
+                               output.data(), outputOperand.dimensions);
+    }
+    uint8_t* quantized = buffers[operation.outputs[0]];
+    for (size_t i = 0; i < output.size(); i++) {
+        const float value = std::round(output[i] / outputOperand.scale) + outputOperand.zeroPoint;
+        quantized[i] = static_cast<uint8_t>(std::clamp(value, 0.0f, 255.0f));
+    }
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+}  // namespace
+
+size_t byteSize(const Operand& operand) {
+    if (isScalar(operand.type)) return elementSize(operand.type);
+    if (operand.dimensions.empty()) return 0;
+    size_t size = elementSize(operand.type);
+    for (uint32_t dimension : operand.dimensions) size *= dimension;
+    return size;
+}
+
+int validateOperationSignature(const std::vector<Operand>& operands, const Operation& operation) {
+    const auto& inputs = operation.inputs;
+    NN_RETURN_IF(operation.outputs.size() != 1, ANEURALNETWORKS_BAD_DATA,
+                 "Operation %d: expected 1 output", operation.type);
+    std::vector<int32_t> expectedTypes;
+    int32_t expectedOutputType = ANEURALNETWORKS_TENSOR_FLOAT32;
+    switch (operation.type) {
+        case ANEURALNETWORKS_ADD:
+        case ANEURALNETWORKS_MUL:
+            expectedTypes = {ANEURALNETWORKS_TENSOR_FLOAT32, ANEURALNETWORKS_TENSOR_FLOAT32,
+                             ANEURALNETWORKS_INT32};
+            break;
+        case ANEURALNETWORKS_CAST:
+            NN_RETURN_IF(inputs.size() != 1, ANEURALNETWORKS_BAD_DATA,
+                         "CAST: unexpected number of inputs");
+            if (operands[inputs[0]].type == ANEURALNETWORKS_TENSOR_FLOAT16) {
+                expectedTypes = {ANEURALNETWORKS_TENSOR_FLOAT16};
+            } else {
+                expectedTypes = {ANEURALNETWORKS_TENSOR_FLOAT32};
+                expectedOutputType = ANEURALNETWORKS_TENSOR_FLOAT16;
+            }
+            break;
+        case ANEURALNETWORKS_CONV_2D:
+        case ANEURALNETWORKS_DEPTHWISE_CONV_2D: {
+            ConvolutionSignature signature;
+            NN_RETURN_IF(!getConvolutionSignature(operands, operation, &signature),
+                         ANEURALNETWORKS_BAD_DATA, "Operation %d: unexpected number of inputs",
+                         operation.type);
+            expectedTypes.assign(inputs.size(), ANEURALNETWORKS_INT32);
+            if (isQuant8(operands[inputs[0]])) {
+                expectedTypes[0] = expectedTypes[1] = ANEURALNETWORKS_TENSOR_QUANT8_ASYMM;
+                expectedTypes[2] = ANEURALNETWORKS_TENSOR_INT32;
+                expectedOutputType = ANEURALNETWORKS_TENSOR_QUANT8_ASYMM;
+            } else {
+                std::fill_n(expectedTypes.begin(), 3, ANEURALNETWORKS_TENSOR_FLOAT32);
+            }
+            if (inputs.size() > signature.requiredInputs) {
+                expectedTypes[signature.requiredInputs] = ANEURALNETWORKS_BOOL;
+            }
+            break;
+        }
+        default:
+            NN_LOGE("Operation %d is not supported by the host NNAPI", operation.type);
+            return ANEURALNETWORKS_BAD_DATA;
+    }
+    NN_RETURN_IF(inputs.size() != expectedTypes.size(), ANEURALNETWORKS_BAD_DATA,
+                 "Operation %d: unexpected number of inputs", operation.type);
+    for (uint32_t i = 0; i < inputs.size(); i++) {
+        NN_RETURN_IF(operands[inputs[i]].type != expectedTypes[i], ANEURALNETWORKS_BAD_DATA,
+                     "Operation %d: unexpected type of input %u", operation.type, i);
+    }
+    NN_RETURN_IF(operands[operation.outputs[0]].type != expectedOutputType,
+                 ANEURALNETWORKS_BAD_DATA, "Operation %d: unexpected output type", operation.type);
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+int prepareOperation(const std::vector<Operand>& operands, Operation* operation) {
+    for (uint32_t index : operation->inputs) {
+        NN_RETURN_IF(operands[index].lifetime == Operand::Lifetime::NO_VALUE,
+                     ANEURALNETWORKS_BAD_DATA, "Operation %d: omitted inputs are not supported",
+                     operation->type);
+        NN_RETURN_IF(byteSize(operands[index]) == 0, ANEURALNETWORKS_BAD_DATA,
+                     "Operation %d: the inputs must be fully specified", operation->type);
+    }
+    NN_RETURN_IF(byteSize(operands[operation->outputs[0]]) == 0, ANEURALNETWORKS_BAD_DATA,
+                 "Operation %d: the output must be fully specified", operation->type);
+
+    switch (operation->type) {
+        case ANEURALNETWORKS_ADD:
+        case ANEURALNETWORKS_MUL:
+            return prepareBinary(operands, operation);
+        case ANEURALNETWORKS_CAST:
+            return prepareCast(operands, operation);
+        default:
+            return prepareConvolution(operands, operation);
+    }
+}
+
+int runOperation(const std::vector<Operand>& operands, const Operation& operation,
+                 uint8_t* const* buffers) {
+    const auto& inputs = operation.inputs;
+    if (isQuant8(operands[inputs[0]])) {
+        return runQuant8Convolution(operands, operation, buffers);
+    }
+    if (operation.type == ANEURALNETWORKS_CAST) {
+        const uint32_t size = byteSize(operands[inputs[0]]) / elementSize(operands[inputs[0]].type);
+        if (operands[inputs[0]].type == ANEURALNETWORKS_TENSOR_FLOAT16) {
+            castFloat16ToFloat32(reinterpret_cast<const uint16_t*>(buffers[inputs[0]]), size,
+                                 reinterpret_cast<float*>(buffers[operation.outputs[0]]));
+        } else {
+            castFloat32ToFloat16(reinterpret_cast<const float*>(buffers[inputs[0]]), size,
+                                 reinterpret_cast<uint16_t*>(buffers[operation.outputs[0]]));
+        }
+        return ANEURALNETWORKS_NO_ERROR;
+    }
+    auto tensor = [buffers](uint32_t index) { return reinterpret_cast<float*>(buffers[index]); };
+    const Dimensions& outputDimensions = operands[operation.outputs[0]].dimensions;
+    float* output = tensor(operation.outputs[0]);
+    switch (operation.type) {
+        case ANEURALNETWORKS_ADD:
+            addFloat32(tensor(inputs[0]), operands[inputs[0]].dimensions, tensor(inputs[1]),
+                       operands[inputs[1]].dimensions, operation.params.activation, output,
+                       outputDimensions);
+            break;
+        case ANEURALNETWORKS_MUL:
+            mulFloat32(tensor(inputs[0]), operands[inputs[0]].dimensions, tensor(inputs[1]),
+                       operands[inputs[1]].dimensions, operation.params.activation, output,
+                       outputDimensions);
+            break;
+        case ANEURALNETWORKS_CONV_2D:
+            conv2dFloat32(tensor(inputs[0]), operands[inputs[0]].dimensions, tensor(inputs[1]),
+                          operands[inputs[1]].dimensions, tensor(inputs[2]), operation.params,
+                          output, outputDimensions);
+            break;
+        case ANEURALNETWORKS_DEPTHWISE_CONV_2D:
+            depthwiseConv2dFloat32(tensor(inputs[0]), operands[inputs[0]].dimensions,
+                                   tensor(inputs[1]), operands[inputs[1]].dimensions,
+                                   tensor(inputs[2]), operation.params, output, outputDimensions);
+            break;
+        default:
+            return ANEURALNETWORKS_OP_FAILED;
+    }
+    return ANEURALNETWORKS_NO_ERROR;
+}
+
+}  // namespace host_nnapi
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2021 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NNAPI_SAMPLES_HOST_NDK_NNAPI_RUNTIME_H
+#define NNAPI_SAMPLES_HOST_NDK_NNAPI_RUNTIME_H
+
+#include <android/NeuralNetworks.h>
+#include <android/hardware_buffer.h>
+#include <android/log.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kernels.h"
+
+#define NN_LOG_TAG "HostNnapi"
+#define NN_LOGE(...) __android_log_print(ANDROID_LOG_ERROR, NN_LOG_TAG, __VA_ARGS__)
+
+// Log and return the result code if the condition fails
+#define NN_RETURN_IF(condition, result, ...) \
+    do {                                     \
+        if (condition) {                     \
+            NN_LOGE(__VA_ARGS__);            \
+            return result;                   \
+        }                                    \
+    } while (0)
+
+namespace host_nnapi {
+
+// The feature level reported by ANeuralNetworks_getRuntimeFeatureLevel (Android 12)
+constexpr int64_t kFeatureLevel = 31;
+
+// The name and version of the single device, after the NNAPI reference CPU device
+constexpr const char* kDeviceName = "nnapi-reference";
+constexpr const char* kDeviceVersion = "host";
+
+// The alignment and padding reported for every execution input and output
+constexpr uint32_t kPreferredMemoryAlignment = 64;
+constexpr uint32_t kPreferredMemoryPadding = 64;
+
+struct Operand {
+    enum class Lifetime { TEMPORARY, MODEL_INPUT, MODEL_OUTPUT, CONSTANT, NO_VALUE };
+
+    int32_t type;
+    Dimensions dimensions;
+    float scale;
+    int32_t zeroPoint;
+    Lifetime lifetime = Lifetime::TEMPORARY;
+    // The value of a CONSTANT operand
+    const uint8_t* value = nullptr;
+    size_t length = 0;
+};
+
+struct Operation {
+    int32_t type;
+    std::vector<uint32_t> inputs;
+    std::vector<uint32_t> outputs;
+    // The scalar parameters, read from the constant operands by prepareOperation. ADD and MUL
+    // only use the activation.
+    ConvolutionParams params;
+};
+
+// The size in bytes of the operand, or 0 if its dimensions are not fully specified
+size_t byteSize(const Operand& operand);
+
+// Checks the types and the number of operands of an operation when it is added to a model
+int validateOperationSignature(const std::vector<Operand>& operands, const Operation& operation);
+
+// Checks the parameters and the shapes of an operation when its model is finished, and reads the
+// parameters into operation->params. The host NNAPI requires the parameters to be constants and
+// all the tensors to be fully specified.
+int prepareOperation(const std::vector<Operand>& operands, Operation* operation);
+
+// Runs the operation on the given operand buffers, indexed as the operands of the model. The
+// operation must have been prepared.
+int runOperation(const std::vector<Operand>& operands, const Operation& operation,
+                 uint8_t* const* buffers);
+
+}  // namespace host_nnapi
+
+struct ANeuralNetworksModel {
+    std::vector<host_nnapi::Operand> operands;
+    // Sorted into a valid run order by ANeuralNetworksModel_finish
+    std::vector<host_nnapi::Operation> operations;
+    std::vector<uint32_t> inputs;
+    std::vector<uint32_t> outputs;
+    // The values of at most ANEURALNETWORKS_MAX_SIZE_OF_IMMEDIATELY_COPIED_VALUES bytes are copied,
+    // a deque keeps them in place as more are added
+    std::deque<std::vector<uint8_t>> copiedValues;
+    bool relaxComputationFloat32toFloat16 = false;
+    bool inputsAndOutputsIdentified = false;
+    bool finished = false;
+};
+
+struct ANeuralNetworksDevice {
+    const char* name;
+    int32_t type;
+    const char* version;
+    int64_t featureLevel;
+};
+
+struct ANeuralNetworksCompilation {
+    const ANeuralNetworksModel* model;
+    // The device of a compilation created by ANeuralNetworksCompilation_createForDevices, which
+    // allows the executions to measure their timing
+    const ANeuralNetworksDevice* device = nullptr;
+    int32_t preference = ANEURALNETWORKS_PREFER_FAST_SINGLE_ANSWER;
+    std::string cacheDir;
+    bool finished = false;
+};
+
+struct ANeuralNetworksMemory {
+    // The CPU address of the memory
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    // Created from a file descriptor: the mapping that holds the data
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    // Created from an AHardwareBuffer: the locked buffer
+    AHardwareBuffer* hardwareBuffer = nullptr;
+    // Created from a memory descriptor: the storage of the device memory, which is only ever
+    // used as a whole, with offset and length 0
+    std::vector<uint8_t> deviceMemory;
+    bool isDeviceMemory = false;
+};
+
+struct ANeuralNetworksMemoryDesc {
+    struct Role {
+        const ANeuralNetworksCompilation* compilation;
+        bool isInput;
+        uint32_t index;
+    };
+    std::vector<Role> roles;
+    size_t size = 0;
+    bool finished = false;
+};
+
+struct ANeuralNetworksBurst {
+    const ANeuralNetworksCompilation* compilation;
+};
+
+struct ANeuralNetworksEvent {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool signaled = false;
+    int result = ANEURALNETWORKS_NO_ERROR;
+    // The thread running the computation, joined when the event is freed
+    std::thread worker;
+    // The sync fence of an event created with ANeuralNetworksEvent_createFromSyncFenceFd
+    int syncFenceFd = -1;
+};
+
+struct ANeuralNetworksExecution {
+    enum class State { PREPARATION, COMPUTATION, COMPLETED };
+
+    struct Argument {
+        enum class Kind { UNSPECIFIED, POINTER, MEMORY, OMITTED };
+        Kind kind = Kind::UNSPECIFIED;
+        uint8_t* data = nullptr;
+    };
+
+    const ANeuralNetworksCompilation* compilation;
+    std::vector<Argument> inputs;
+    std::vector<Argument> outputs;
+    bool reusable = false;
+    bool paddingEnabled = false;
+    bool anyArgumentSet = false;
+    bool measureTiming = false;
+
+    // Guards state, freeRequested and the durations, which are shared with the computation thread
+    mutable std::mutex mutex;
+    State state = State::PREPARATION;
+    // ANeuralNetworksExecution_free was called while computing, so the computation thread
+    // deletes the execution once done
+    bool freeRequested = false;
+
+    // The durations in nanoseconds of the last computation, UINT64_MAX if not measured. The host
+    // has no driver, so the time in the driver is the time on the CPU plus the bookkeeping around
+    // it. The fenced durations start when the dependencies have signaled, and are only measured
+    // for the computations started with dependencies.
+    uint64_t durationOnHardware = UINT64_MAX;
+    uint64_t durationInDriver = UINT64_MAX;
+    uint64_t fencedDurationOnHardware = UINT64_MAX;
+    uint64_t fencedDurationInDriver = UINT64_MAX;
+
+    // The temporary operands, allocated on the first computation and kept by reusable executions
+    std::vector<std::vector<uint8_t>> temporaries;
+    std::vector<uint8_t*> buffers;
+};
+
+#endif  // NNAPI_SAMPLES_HOST_NDK_NNAPI_RUNTIME_H